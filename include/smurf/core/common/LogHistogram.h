@@ -0,0 +1,213 @@
+#ifndef _SMURF_CORE_COMMON_LOGHISTOGRAM_H_
+#define _SMURF_CORE_COMMON_LOGHISTOGRAM_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Logarithmic Histogram
+ * ----------------------------------------------------------------------------
+ * File          : LogHistogram.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Logarithmic Histogram Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <cstdint>
+
+// This class implements a histogram of 64-bit unsigned values with logarithmic
+// buckets, similar to an HDR histogram. Each power of two is divided in
+// 2^subBucketBits linear sub-buckets, so the relative error of the values
+// reported by the histogram is at most 1/2^subBucketBits (6.25%), over the
+// whole 64-bit range, using a fixed amount of memory.
+//
+// Recording a value is O(1), it doesn't allocate memory and it doesn't take
+// any lock, so it can be used on the stream threads. The bucket counts are
+// atomics, so the histogram can be read from other threads at any time. The
+// statistics computed while values are being recorded can be slightly off, as
+// the buckets are not read all at the same time.
+class LogHistogram
+{
+public:
+    // Number of bits used for the linear sub-buckets
+    static const std::size_t subBucketBits = 4;
+
+    // Number of buckets
+    static const std::size_t numBuckets = ( 64 - subBucketBits + 1 ) << subBucketBits;
+
+    LogHistogram()
+    {
+        clear();
+    };
+
+    ~LogHistogram() {};
+
+    // Add a value to the histogram
+    void record(uint64_t value)
+    {
+        buckets[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(value, std::memory_order_relaxed);
+
+        uint64_t m { min.load(std::memory_order_relaxed) };
+        while ( ( value < m ) && ( ! min.compare_exchange_weak(m, value, std::memory_order_relaxed) ) )
+            ;
+
+        m = max.load(std::memory_order_relaxed);
+        while ( ( value > m ) && ( ! max.compare_exchange_weak(m, value, std::memory_order_relaxed) ) )
+            ;
+    };
+
+    // Clear the histogram
+    void clear()
+    {
+        for (auto &b : buckets)
+            b.store(0, std::memory_order_relaxed);
+
+        count.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+    };
+
+    // Get the number of recorded values
+    const uint64_t getCount() const
+    {
+        return count.load(std::memory_order_relaxed);
+    };
+
+    // Get the sum of the recorded values
+    const uint64_t getSum() const
+    {
+        return sum.load(std::memory_order_relaxed);
+    };
+
+    // Get the minimum recorded value. It returns zero if the histogram is empty.
+    const uint64_t getMin() const
+    {
+        uint64_t m { min.load(std::memory_order_relaxed) };
+        return ( m == std::numeric_limits<uint64_t>::max() ) ? 0 : m;
+    };
+
+    // Get the maximum recorded value
+    const uint64_t getMax() const
+    {
+        return max.load(std::memory_order_relaxed);
+    };
+
+    // Get the mean of the recorded values
+    const double getMean() const
+    {
+        uint64_t n { getCount() };
+
+        if ( 0 == n )
+            return 0;
+
+        return static_cast<double>(getSum()) / n;
+    };
+
+    // Get the value at a given percentile (in the range [0, 100]). It returns
+    // the upper bound of the bucket which contains that percentile, limited
+    // to the maximum recorded value.
+    const uint64_t getPercentile(double p) const
+    {
+        // Take a copy of the bucket counts, so that the
+        // total matches the sum of the buckets.
+        std::array<uint64_t, numBuckets> c;
+        uint64_t total { 0 };
+        for (std::size_t i{0}; i < numBuckets; ++i)
+        {
+            c[i] = buckets[i].load(std::memory_order_relaxed);
+            total += c[i];
+        }
+
+        if ( 0 == total )
+            return 0;
+
+        if ( p < 0 )
+            p = 0;
+        else if ( p > 100 )
+            p = 100;
+
+        // Number of values at, or below, the requested percentile
+        uint64_t target { static_cast<uint64_t>( p / 100.0 * total + 0.5 ) };
+        if ( 0 == target )
+            target = 1;
+
+        uint64_t acc { 0 };
+        for (std::size_t i{0}; i < numBuckets; ++i)
+        {
+            acc += c[i];
+            if ( acc >= target )
+            {
+                uint64_t v { getBucketUpperBound(i) };
+                uint64_t m { getMax() };
+                return ( v < m ) ? v : m;
+            }
+        }
+
+        return getMax();
+    };
+
+    // Get the number of values in a bucket
+    const uint64_t getBucketCount(std::size_t index) const
+    {
+        return buckets.at(index).load(std::memory_order_relaxed);
+    };
+
+    // Get the index of the bucket which holds a value
+    static std::size_t getBucketIndex(uint64_t value)
+    {
+        // Values smaller than the number of sub-buckets go into a linear bucket each
+        if ( value < ( 1ULL << subBucketBits ) )
+            return static_cast<std::size_t>(value);
+
+        // For the rest, the position of the most significant bit selects the group of
+        // buckets, and the next 'subBucketBits' bits select the sub-bucket in the group.
+        std::size_t msb   { static_cast<std::size_t>( 63 - __builtin_clzll(value) ) };
+        std::size_t shift { msb - subBucketBits };
+
+        return ( ( shift + 1 ) << subBucketBits ) + ( ( value >> shift ) & ( ( 1ULL << subBucketBits ) - 1 ) );
+    };
+
+    // Get the lowest value which goes into a bucket
+    static uint64_t getBucketLowerBound(std::size_t index)
+    {
+        if ( index < ( 1ULL << subBucketBits ) )
+            return index;
+
+        std::size_t shift    { ( index >> subBucketBits ) - 1 };
+        uint64_t    mantissa { ( index & ( ( 1ULL << subBucketBits ) - 1 ) ) | ( 1ULL << subBucketBits ) };
+
+        return mantissa << shift;
+    };
+
+    // Get the highest value which goes into a bucket
+    static uint64_t getBucketUpperBound(std::size_t index)
+    {
+        if ( index + 1 >= numBuckets )
+            return std::numeric_limits<uint64_t>::max();
+
+        return getBucketLowerBound(index + 1) - 1;
+    };
+
+private:
+    std::array<std::atomic<uint64_t>, numBuckets> buckets; // Bucket counts
+    std::atomic<uint64_t>                         count;   // Number of recorded values
+    std::atomic<uint64_t>                         sum;     // Sum of the recorded values
+    std::atomic<uint64_t>                         min;     // Minimum recorded value
+    std::atomic<uint64_t>                         max;     // Maximum recorded value
+};
+
+#endif
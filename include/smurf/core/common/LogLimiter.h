@@ -0,0 +1,153 @@
+#ifndef _SMURF_CORE_COMMON_LOGLIMITER_H_
+#define _SMURF_CORE_COMMON_LOGLIMITER_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Log Limiter
+ * ----------------------------------------------------------------------------
+ * File          : LogLimiter.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Log Limiter Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include <rogue/Logging.h>
+#include "smurf/core/common/Helpers.h"
+
+// This class limits the rate of a message logged from the data path, like the
+// messages logged on each bad frame, so that a burst of bad frames doesn't flood
+// the log. Each message site has its own LogLimiter object.
+//
+// The rate is limited with a token bucket: up to 'burst' messages are logged
+// in a row, and then one message every 1/'rate' seconds. The messages over the
+// limit are suppressed and counted. When the next message is logged, or after
+// 'summaryPeriod' seconds of suppressed messages, a warning with the number of
+// suppressed messages is logged.
+//
+// It can be used like this:
+//    LogLimiter logBadFrame(eLog_, "bad frame");
+//    ...
+//    logBadFrame.error("Received frame with errors and/or flags");
+//
+// The logging methods take a mutex, so they should only be used on error paths.
+// The counters can be read from any thread.
+class LogLimiter
+{
+public:
+    LogLimiter(std::shared_ptr<rogue::Logging> log, const std::string& site,
+        double rate = 1.0, double burst = 5.0, double summaryPeriod = 10.0)
+    :
+        log(log),
+        site(site),
+        rate(rate),
+        burst(burst),
+        summaryPeriod(static_cast<uint64_t>(summaryPeriod * 1e9)),
+        suppressedCnt(0),
+        tokens(burst),
+        lastRefill(0),
+        pendingCnt(0),
+        pendingStart(0)
+    {
+    };
+
+    ~LogLimiter() {};
+
+    // Log an error message, if the rate limit allows it
+    template <typename... Args>
+    void error(const char* fmt, Args... args)
+    {
+        if ( allow() )
+            log->error(fmt, args...);
+    };
+
+    // Log a warning message, if the rate limit allows it
+    template <typename... Args>
+    void warning(const char* fmt, Args... args)
+    {
+        if ( allow() )
+            log->warning(fmt, args...);
+    };
+
+    // Get the number of suppressed messages
+    const std::size_t getSuppressedCnt() const
+    {
+        return suppressedCnt.load(std::memory_order_relaxed);
+    };
+
+    // Clear the number of suppressed messages
+    void clearCnt()
+    {
+        suppressedCnt.store(0, std::memory_order_relaxed);
+    };
+
+private:
+    // Check if a message can be logged now. If not, the message is counted as
+    // suppressed. It logs the summary of the suppressed messages, when needed.
+    bool allow()
+    {
+        std::lock_guard<std::mutex> lock(mut);
+
+        uint64_t now { helpers::getTimeNS() };
+
+        // Refill the bucket
+        if ( 0 != lastRefill )
+            tokens = std::min( burst, tokens + ( now - lastRefill ) * 1e-9 * rate );
+        lastRefill = now;
+
+        bool allowed { tokens >= 1.0 };
+
+        if ( allowed )
+        {
+            tokens -= 1.0;
+        }
+        else
+        {
+            if ( 0 == pendingCnt )
+                pendingStart = now;
+
+            ++pendingCnt;
+            suppressedCnt.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if ( ( 0 != pendingCnt ) && ( allowed || ( now - pendingStart >= summaryPeriod ) ) )
+        {
+            log->warning("%zu '%s' messages were suppressed in the last %.1f seconds",
+                pendingCnt, site.c_str(), ( now - pendingStart ) * 1e-9);
+
+            pendingCnt = 0;
+        }
+
+        return allowed;
+    };
+
+    std::shared_ptr<rogue::Logging> log;           // Logger
+    const std::string               site;          // Message site name, used in the summary
+    const double                    rate;          // Sustained rate (messages per second)
+    const double                    burst;         // Maximum burst (messages)
+    const uint64_t                  summaryPeriod; // Summary period (ns)
+    std::atomic<std::size_t>        suppressedCnt; // Number of suppressed messages
+
+    // State, protected by the mutex
+    std::mutex                      mut;           // Mutex
+    double                          tokens;        // Tokens in the bucket
+    uint64_t                        lastRefill;    // Time of the last refill (ns)
+    std::size_t                     pendingCnt;    // Suppressed messages since the last summary
+    uint64_t                        pendingStart;  // Time of the first suppressed message since the last summary (ns)
+};
+
+#endif
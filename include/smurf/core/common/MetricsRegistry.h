@@ -0,0 +1,135 @@
+#ifndef _SMURF_CORE_COMMON_METRICSREGISTRY_H_
+#define _SMURF_CORE_COMMON_METRICSREGISTRY_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Metrics Registry
+ * ----------------------------------------------------------------------------
+ * File          : MetricsRegistry.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Metrics Registry Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <functional>
+#include <rogue/Logging.h>
+#include "smurf/core/common/LogHistogram.h"
+
+// This class holds the list of metrics (counters, gauges and histograms) exported
+// by the processing blocks, and renders them in the Prometheus text exposition
+// format. There is only one registry per process, accessed with getInstance().
+//
+// The blocks register a getter function for each metric, usually from their
+// registerMetrics() method, and they must remove them, using remove(this), in
+// their destructor. The getters are only called while rendering, so they must
+// only read atomic variables, and they must not take locks used by the stream
+// threads. The registry mutex is only taken while registering, removing and
+// rendering metrics, never from the data path.
+//
+// The metrics are grouped in families by name. Each metric in a family has a
+// different set of labels; all the blocks add a 'block' label with the block
+// name. The histograms are taken from LogHistogram objects holding values in
+// nanoseconds, and they are exported in seconds, with one bucket per power of
+// two between 2^histMinBits and 2^histMaxBits nanoseconds.
+class MetricsRegistry
+{
+public:
+    // Metric types
+    enum class Type { Counter, Gauge, Histogram };
+
+    // Getter function
+    typedef std::function<double()> getter_t;
+
+    // Labels, as name/value pairs
+    typedef std::map<std::string, std::string> labels_t;
+
+    // Range of the histogram buckets (1us to ~18 minutes)
+    static const std::size_t histMinBits = 10;
+    static const std::size_t histMaxBits = 40;
+
+    // Get the registry instance
+    static MetricsRegistry& getInstance();
+
+    // Add a counter (a monotonic value, only reset when the block's counters are cleared).
+    // The Prometheus convention is to end the counter names with '_total'.
+    void addCounter(const void* owner, const std::string& name, const std::string& help,
+                    const labels_t& labels, getter_t get);
+
+    // Add a gauge (a value which can go up and down)
+    void addGauge(const void* owner, const std::string& name, const std::string& help,
+                  const labels_t& labels, getter_t get);
+
+    // Add a histogram, with values in nanoseconds. The histogram object must
+    // be kept alive until the metrics of its owner are removed.
+    void addHistogram(const void* owner, const std::string& name, const std::string& help,
+                      const labels_t& labels, const LogHistogram* hist);
+
+    // Remove all the metrics registered by an owner
+    void remove(const void* owner);
+
+    // Get the number of registered metrics
+    const std::size_t getSize() const;
+
+    // Render all the metrics in the Prometheus text format
+    const std::string render() const;
+
+private:
+    MetricsRegistry();
+    ~MetricsRegistry() {};
+
+    // Prevent copying the registry
+    MetricsRegistry(const MetricsRegistry&);
+    MetricsRegistry& operator=(const MetricsRegistry&);
+
+    // A metric in a family
+    struct Metric
+    {
+        const void*         owner;  // Object which registered the metric
+        std::string         labels; // Formatted labels, without braces
+        getter_t            get;    // Getter function (counters and gauges)
+        const LogHistogram* hist;   // Histogram (histograms)
+    };
+
+    // A family of metrics with the same name
+    struct Family
+    {
+        Type                type;    // Metric type
+        std::string         help;    // Help text
+        std::vector<Metric> metrics; // Metrics, one per set of labels
+    };
+
+    void add(const void* owner, const std::string& name, const std::string& help, Type type,
+             const labels_t& labels, getter_t get, const LogHistogram* hist);
+
+    // Render one histogram
+    static void renderHistogram(std::string& out, const std::string& name, const Metric& m);
+
+    // Helpers to format names, labels and values
+    static bool        isValidName(const std::string& name);
+    static std::string formatLabels(const labels_t& labels);
+    static std::string escape(const std::string& s, bool isHelp);
+    static std::string formatValue(double v, int precision = 17);
+    static const char* typeName(Type type);
+
+    mutable std::mutex              mtx;      // Mutex protecting the families
+    std::map<std::string, Family>   families; // Families, by name
+
+    // Logger
+    std::shared_ptr<rogue::Logging> eLog_;
+};
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef _SMURF_CORE_COMMON_PERFCOUNTERS_H_
+#define _SMURF_CORE_COMMON_PERFCOUNTERS_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Performance Counters
+ * ----------------------------------------------------------------------------
+ * File          : PerfCounters.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Performance Counters Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <array>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <rogue/Logging.h>
+
+// This class measures the hardware events (cycles, instructions, cache misses
+// and branch misses) spent on each stage of a processing chain, using the Linux
+// perf_event_open interface. The counters only count the events of the thread
+// processing the data, in user space.
+//
+// The processing thread calls begin() before the first stage, and mark(stage)
+// at the end of each stage; the events between two calls are added to the
+// stage. The counters are opened in begin(), the first time it is called after
+// the measurement is enabled, so they are attached to the processing thread.
+//
+// If the counters are not available (for example, because the kernel doesn't
+// allow it, see /proc/sys/kernel/perf_event_paranoid, or because the CPU doesn't
+// support them), the status is set to Unavailable, a warning is logged, and
+// the processing continues without measurements. Events not supported by the
+// CPU are skipped, and the rest are still measured.
+//
+// When the measurement is disabled, begin() and mark() only check a flag.
+class PerfCounters
+{
+public:
+    // Measured events
+    enum Event { Cycles, Instructions, L1dMisses, LlcMisses, BranchMisses, NumEvents };
+
+    // Event names
+    static const char* eventNames[NumEvents];
+
+    // Measurement status
+    enum Status { Disabled, Running, Unavailable };
+
+    PerfCounters(std::size_t numStages);
+    ~PerfCounters();
+
+    // Enable/Disable the measurement. It can be called from any thread.
+    void       setEnable(bool e);
+    const bool getEnable() const;
+
+    // Get the measurement status
+    const int getStatus() const;
+
+    // Check if an event is being measured
+    const bool getEventAvailable(std::size_t event) const;
+
+    // Clear the accumulated values. It can be called from any thread;
+    // the values are cleared by the processing thread, in begin().
+    void clear();
+
+    // Start a measurement. It must be called from the processing thread.
+    void begin();
+
+    // Add the events since the previous call to begin() or mark() to
+    // a stage. It must be called from the processing thread.
+    void mark(std::size_t stage);
+
+    // Get the number of measurements of a stage
+    const uint64_t getCalls(std::size_t stage) const;
+
+    // Get the accumulated number of events of a stage
+    const uint64_t getCount(std::size_t stage, std::size_t event) const;
+
+    // Get the number of stages
+    const std::size_t getNumStages() const;
+
+private:
+    // Open/Close the counters. They must be called from the processing thread.
+    bool open();
+    void close();
+
+    // Read the current values of the counters. It returns 'false' if it fails.
+    bool read(std::array<uint64_t, NumEvents>& values);
+
+    // Accumulated values of a stage
+    struct Stage
+    {
+        std::atomic<uint64_t>                          calls;  // Number of measurements
+        std::array<std::atomic<uint64_t>, NumEvents>   counts; // Number of events
+    };
+
+    std::atomic<bool>                    enable;     // Enable flag
+    std::atomic<int>                     status;     // Measurement status
+    std::atomic<bool>                    clearReq;   // Clear request flag
+    std::atomic<uint32_t>                available;  // Bit mask of the events being measured
+    std::vector<Stage>                   stages;     // Accumulated values, by stage
+
+    // State, only used by the processing thread
+    bool                                 isOpen;     // Flag to indicate the counters are open
+    bool                                 failed;     // Flag to indicate opening the counters failed
+    std::array<int, NumEvents>           fds;        // File descriptors, by event (-1 if not opened)
+    std::array<std::size_t, NumEvents>   position;   // Position of each event in the group read
+    std::size_t                          numOpen;    // Number of opened counters
+    std::array<uint64_t, NumEvents>      last;       // Values at the previous call to begin() or mark()
+    bool                                 started;    // Flag to indicate 'last' holds valid values
+
+    // Logger
+    std::shared_ptr<rogue::Logging> eLog_;
+};
+
+#endif
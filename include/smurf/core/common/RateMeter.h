@@ -0,0 +1,186 @@
+#ifndef _SMURF_CORE_COMMON_RATEMETER_H_
+#define _SMURF_CORE_COMMON_RATEMETER_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Rate Meter
+ * ----------------------------------------------------------------------------
+ * File          : RateMeter.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Rate Meter Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include "smurf/core/common/Helpers.h"
+
+// This class measures the rate (per second) of events, like frames or bytes.
+// The events are accumulated during a tick period (100ms); at the end of each
+// tick, the instantaneous rate is computed, and it is used to update the peak
+// rate and the exponentially weighted moving averages over 1, 10 and 60 seconds.
+//
+// The update() method must be called from a single thread (the stream thread),
+// with the current time from helpers::getTimeNS(). The getters can be called
+// from any thread. If no events are received for longer than twice the last tick
+// duration, the getters report a zero instantaneous rate, and they decay the
+// averages as if the rate was zero during the idle time.
+class RateMeter
+{
+public:
+    // Number of moving averages, and their time constants (in seconds)
+    static const std::size_t numAverages = 3;
+
+    RateMeter()
+    {
+        clear();
+    };
+
+    ~RateMeter() {};
+
+    // Add 'n' events, at time 'now' (in ns)
+    void update(uint64_t now, uint64_t n)
+    {
+        acc += n;
+
+        if ( 0 == tickStart )
+        {
+            tickStart = now;
+            return;
+        }
+
+        uint64_t dt { now - tickStart };
+        if ( dt < tickPeriod )
+            return;
+
+        // End of the tick: compute the rate over it
+        double rate { acc * 1e9 / dt };
+
+        instant.store(rate, std::memory_order_relaxed);
+
+        if ( rate > peak.load(std::memory_order_relaxed) )
+            peak.store(rate, std::memory_order_relaxed);
+
+        for (std::size_t i{0}; i < numAverages; ++i)
+        {
+            // Initialize the averages with the first measured rate
+            double a { average[i].load(std::memory_order_relaxed) };
+            if ( firstTick )
+                a = rate;
+            else
+                a += ( rate - a ) * ( 1 - std::exp( -1e-9 * dt / getTimeConstant(i) ) );
+
+            average[i].store(a, std::memory_order_relaxed);
+        }
+
+        lastTick.store(now, std::memory_order_relaxed);
+        lastTickLen.store(dt, std::memory_order_relaxed);
+        firstTick = false;
+        tickStart = now;
+        acc       = 0;
+    };
+
+    // Get the rate measured over the last tick period
+    const double getInstant() const
+    {
+        if ( isIdle() )
+            return 0;
+
+        return instant.load(std::memory_order_relaxed);
+    };
+
+    // Get the moving average with index 'i' (0: 1s, 1: 10s, 2: 60s)
+    const double getAverage(std::size_t i) const
+    {
+        if ( i >= numAverages )
+            return 0;
+
+        double a { average[i].load(std::memory_order_relaxed) };
+
+        if ( isIdle() )
+            a *= std::exp( -1e-9 * getIdleTime() / getTimeConstant(i) );
+
+        return a;
+    };
+
+    // Get the maximum rate measured over a tick period
+    const double getPeak() const
+    {
+        return peak.load(std::memory_order_relaxed);
+    };
+
+    // Clear the peak rate
+    void clearPeak()
+    {
+        peak.store(0, std::memory_order_relaxed);
+    };
+
+    // Clear all the values. It must be called from the same thread calling update(),
+    // or before it is used for the first time.
+    void clear()
+    {
+        instant.store(0, std::memory_order_relaxed);
+        peak.store(0, std::memory_order_relaxed);
+        for (auto &a : average)
+            a.store(0, std::memory_order_relaxed);
+        lastTick.store(0, std::memory_order_relaxed);
+        lastTickLen.store(tickPeriod, std::memory_order_relaxed);
+        firstTick = true;
+        tickStart = 0;
+        acc       = 0;
+    };
+
+    // Get the time constant of the moving average with index 'i', in seconds
+    static double getTimeConstant(std::size_t i)
+    {
+        static const double tau[numAverages] = { 1.0, 10.0, 60.0 };
+        return tau[i];
+    };
+
+private:
+    // Tick period (ns)
+    static const uint64_t tickPeriod = 100000000;
+
+    // Time since the last tick (ns)
+    uint64_t getIdleTime() const
+    {
+        uint64_t t { lastTick.load(std::memory_order_relaxed) };
+
+        if ( 0 == t )
+            return 0;
+
+        return helpers::getTimeNS() - t;
+    };
+
+    // Check if no events were received for longer than twice the last tick duration
+    bool isIdle() const
+    {
+        return ( getIdleTime() > 2 * lastTickLen.load(std::memory_order_relaxed) );
+    };
+
+    // Values, read by any thread
+    std::atomic<double>                          instant;     // Rate over the last tick
+    std::atomic<double>                          peak;        // Peak rate
+    std::array<std::atomic<double>, numAverages> average;     // Moving averages
+    std::atomic<uint64_t>                        lastTick;    // Time of the last tick
+    std::atomic<uint64_t>                        lastTickLen; // Duration of the last tick
+
+    // State, only used by the update() thread
+    bool                                         firstTick;   // Flag to indicate the first tick is not done yet
+    uint64_t                                     tickStart;   // Start time of the current tick
+    uint64_t                                     acc;         // Number of events in the current tick
+};
+
+#endif
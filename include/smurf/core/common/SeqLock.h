@@ -0,0 +1,100 @@
+#ifndef _SMURF_CORE_COMMON_SEQLOCK_H_
+#define _SMURF_CORE_COMMON_SEQLOCK_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Sequence Lock
+ * ----------------------------------------------------------------------------
+ * File          : SeqLock.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Sequence Lock Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <atomic>
+#include <cstdint>
+
+// This class allows one writer thread to update a group of variables, and any
+// number of reader threads to read a consistent copy of all of them, without
+// locks. The writer never waits; readers retry if an update happened while they
+// were reading.
+//
+// The protected variables must be atomics, accessed with relaxed memory order.
+//
+// It can be used like this:
+//    Writer thread:
+//        seqLock.writeBegin();
+//        a.store(newA, std::memory_order_relaxed);
+//        b.store(newB, std::memory_order_relaxed);
+//        seqLock.writeEnd();
+//
+//    Reader threads:
+//        uint32_t seq;
+//        do
+//        {
+//            seq  = seqLock.readBegin();
+//            myA  = a.load(std::memory_order_relaxed);
+//            myB  = b.load(std::memory_order_relaxed);
+//        } while ( seqLock.readRetry(seq) );
+//
+// Only one thread can write. If more than one thread need to write, they
+// must be serialized externally.
+class SeqLock
+{
+public:
+    SeqLock()
+    :
+        seq(0)
+    {
+    };
+
+    ~SeqLock() {};
+
+    // Start an update. The sequence number is odd while the update is in progress.
+    void writeBegin()
+    {
+        seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    };
+
+    // Finish an update
+    void writeEnd()
+    {
+        seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    };
+
+    // Start reading. It waits if an update is in progress,
+    // and returns the sequence number to pass to readRetry().
+    uint32_t readBegin() const
+    {
+        uint32_t s;
+
+        while ( ( s = seq.load(std::memory_order_acquire) ) & 0x1 )
+            ;
+
+        return s;
+    };
+
+    // Finish reading. It returns 'true' if the variables were updated
+    // while they were being read, in which case the read must be repeated.
+    bool readRetry(uint32_t s) const
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return ( seq.load(std::memory_order_relaxed) != s );
+    };
+
+private:
+    std::atomic<uint32_t> seq; // Sequence number
+};
+
+#endif
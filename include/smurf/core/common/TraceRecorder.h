@@ -0,0 +1,184 @@
+#ifndef _SMURF_CORE_COMMON_TRACERECORDER_H_
+#define _SMURF_CORE_COMMON_TRACERECORDER_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Trace Recorder
+ * ----------------------------------------------------------------------------
+ * File          : TraceRecorder.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Trace Recorder Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <map>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <rogue/Logging.h>
+#include "smurf/core/common/Helpers.h"
+
+// This class records the time spent by the processing blocks on each frame, in
+// a ring buffer holding the last 'numEvents' events. Each event holds the block,
+// the frame counter, the thread, and the begin and end timestamps. The events
+// can be dumped in the Chrome trace event format (JSON), which can be opened
+// with chrome://tracing or https://ui.perfetto.dev. There is only one recorder
+// per process, accessed with getInstance().
+//
+// The recording is disabled by default. The blocks use a TraceScope object to
+// record the time spent in a method; when the recording is disabled, it only
+// checks an atomic flag. When it is enabled, recording an event takes two clock
+// reads and a few relaxed atomic operations, and it never takes a lock, except
+// the first time a thread records an event, when the thread name is saved.
+//
+// Old events are overwritten when the ring buffer is full. Events being written
+// while the buffer is dumped are not included in the dump.
+class TraceRecorder
+{
+public:
+    // Number of events in the ring buffer. It must be a power of two.
+    static const std::size_t numEvents = 1 << 16;
+
+    // Get the recorder instance
+    static TraceRecorder& getInstance();
+
+    // Register a block, and get the ID to use in the events. Each block gets its
+    // own ID. If the name is already used by another block, an instance number is
+    // appended to it ("FrameStatistics[1]", etc.), so that they can be told apart.
+    uint16_t registerBlock(const std::string& name);
+
+    // Change the name of a registered block. The python wrappers use their
+    // device path, so that each instance is identified by its place in the tree.
+    void setBlockName(uint16_t block, const std::string& name);
+
+    // Enable/Disable the recording
+    void setEnable(bool e)
+    {
+        enable.store(e, std::memory_order_relaxed);
+    };
+
+    const bool getEnable() const
+    {
+        return enable.load(std::memory_order_relaxed);
+    };
+
+    // Record an event, with timestamps from helpers::getTimeNS()
+    void record(uint16_t block, uint64_t frame, uint64_t begin, uint64_t end);
+
+    // Get the number of events recorded since the last clear. If it is
+    // larger than numEvents, the oldest events were overwritten.
+    const uint64_t getEventCnt() const;
+
+    // Discard all the recorded events
+    void clear();
+
+    // Get the recorded events in the Chrome trace event format
+    const std::string getJson() const;
+
+    // Write the recorded events to a file, in the Chrome trace event
+    // format. It returns 'false' if the file could not be written.
+    bool dump(const std::string& fileName) const;
+
+private:
+    TraceRecorder();
+    ~TraceRecorder() {};
+
+    // Prevent copying the recorder
+    TraceRecorder(const TraceRecorder&);
+    TraceRecorder& operator=(const TraceRecorder&);
+
+    // Event in the ring buffer. The 'seq' field works as a sequence lock for each
+    // slot: it is odd while the event is being written, and it is set to
+    // 2 * (index + 1) when the event with that index is complete.
+    struct Event
+    {
+        std::atomic<uint64_t> seq;    // Sequence number
+        std::atomic<uint64_t> frame;  // Frame counter
+        std::atomic<uint64_t> source; // Block ID (upper 16 bits) and thread ID (lower 32 bits)
+        std::atomic<uint64_t> begin;  // Begin timestamp (ns)
+        std::atomic<uint64_t> end;    // End timestamp (ns)
+    };
+
+    // Get the ID of the current thread. The first time it is called
+    // from a thread, it saves the thread name.
+    uint32_t getThreadId();
+
+    // Escape a string to be used in JSON
+    static std::string escape(const std::string& s);
+
+    std::atomic<bool>                  enable;      // Enable flag
+    std::array<Event, numEvents>       events;      // Ring buffer
+    std::atomic<uint64_t>              head;        // Index of the next event
+    std::atomic<uint64_t>              start;       // Index of the first event after the last clear
+
+    mutable std::mutex                 namesMutex;  // Mutex to access the block and thread names
+    std::vector<std::string>           blockNames;  // Block names, by ID
+    std::map<std::string, std::size_t> blockCnt;    // Number of blocks registered with each name
+    std::map<uint32_t, std::string>    threadNames; // Thread names, by thread ID
+
+    // Logger
+    std::shared_ptr<rogue::Logging> eLog_;
+};
+
+// This class records the time between its construction and destruction as an
+// event in the TraceRecorder, if the recording is enabled when it is created.
+//
+// It can be used like this:
+//    void MyBlock::acceptFrame(ris::FramePtr frame)
+//    {
+//        TraceScope trace(traceId);
+//        ...
+//        trace.setFrame(header->getFrameCounter());
+//        ...
+//    }
+class TraceScope
+{
+public:
+    TraceScope(uint16_t block)
+    :
+        block(block),
+        frame(0),
+        begin( TraceRecorder::getInstance().getEnable() ? helpers::getTimeNS() : 0 )
+    {
+    };
+
+    ~TraceScope()
+    {
+        end();
+    };
+
+    // Record the event now, instead of when the object is destroyed
+    void end()
+    {
+        if ( begin )
+            TraceRecorder::getInstance().record(block, frame, begin, helpers::getTimeNS());
+
+        begin = 0;
+    };
+
+    // Set the frame counter of the event
+    void setFrame(uint64_t f)
+    {
+        frame = f;
+    };
+
+private:
+    uint16_t block; // Block ID
+    uint64_t frame; // Frame counter
+    uint64_t begin; // Begin timestamp. Zero if the recording was disabled.
+};
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef _SMURF_CORE_COMMON_TRIPLEBUFFER_H_
+#define _SMURF_CORE_COMMON_TRIPLEBUFFER_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Triple Buffer
+ * ----------------------------------------------------------------------------
+ * File          : TripleBuffer.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Triple Buffer Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+
+// This class allows one writer thread to publish snapshots of an object of
+// type T to one reader thread, without locks and without memory allocations.
+// It holds three copies of the object: the writer always owns one of them (the
+// back buffer), the reader always owns another one (the front buffer), and the
+// third one (the middle buffer) is exchanged atomically between them.
+//
+// The writer fills the back buffer and then publishes it, swapping it with the
+// middle buffer. The reader calls update() before using the front buffer; if
+// a new snapshot was published, it is swapped with the middle buffer. The reader
+// always sees a complete snapshot: the latest one published.
+//
+// It can be used like this:
+//    Writer thread:
+//        buffer.getBack() = newValue;
+//        buffer.publish();
+//
+//    Reader thread:
+//        buffer.update();
+//        const T& value = buffer.getFront();
+//
+// Only one thread can write, and only one thread can read. If more than one
+// thread need to write, they must be serialized externally.
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer(const T& init = T())
+    :
+        back(0),
+        middle(1),
+        front(2)
+    {
+        buffers.fill(init);
+    };
+
+    ~TripleBuffer() {};
+
+    // Get a reference to the back buffer. It must only be used by the writer.
+    T& getBack()
+    {
+        return buffers[back];
+    };
+
+    // Publish the content of the back buffer. The writer gets
+    // a new back buffer, which content is not defined.
+    void publish()
+    {
+        back = middle.exchange(back | freshFlag, std::memory_order_acq_rel) & indexMask;
+    };
+
+    // Take the latest published snapshot, if any. It returns 'true' if the
+    // front buffer was updated. It must only be used by the reader.
+    bool update()
+    {
+        if ( ! ( middle.load(std::memory_order_relaxed) & freshFlag ) )
+            return false;
+
+        front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        return true;
+    };
+
+    // Get a reference to the front buffer. It must only be used by the reader.
+    const T& getFront() const
+    {
+        return buffers[front];
+    };
+
+private:
+    // The middle buffer index is stored together with a flag which
+    // indicates that it holds a snapshot not yet seen by the reader.
+    static const uint8_t indexMask = 0x3;
+    static const uint8_t freshFlag = 0x4;
+
+    std::array<T, 3>     buffers; // The three buffers
+    uint8_t              back;    // Index of the back buffer (owned by the writer)
+    std::atomic<uint8_t> middle;  // Index of the middle buffer, plus the fresh flag
+    uint8_t              front;   // Index of the front buffer (owned by the reader)
+};
+
+#endif
@@ -30,6 +30,8 @@
 #include <rogue/GilRelease.h>
 #include "smurf/core/common/SmurfHeader.h"
 #include "smurf/core/common/TesBiasArray.h"
+#include "smurf/core/common/TraceRecorder.h"
+#include "smurf/core/common/LogLimiter.h"
 #include "smurf/core/common/Helpers.h"
 
 namespace bp  = boost::python;
@@ -63,6 +65,13 @@ namespace smurf
                 // Receive the TesBias from pyrogue
                 void setTesBias(std::size_t index, int32_t value);
 
+                // Get the number of log messages suppressed by the rate limiters
+                const std::size_t getSuppressedLogCnt() const;
+                void              clearSuppressedLogCnt();
+
+                // Set the block name used in the trace recorder
+                void setTraceName(const std::string& name);
+
                 // Accept new frames
                 void acceptFrame(ris::FramePtr frame);
 
@@ -70,9 +79,14 @@ namespace smurf
                 bool                                            disable; // Disable flag
                 std::vector<uint8_t>                            tesBias; // Buffer to hold the TES values
                 TesBiasArrayPtr<std::vector<uint8_t>::iterator> tba;     // TesBias interface object
+                uint16_t                                        traceId; // Block ID in the trace recorder
 
                 // Logger
                 std::shared_ptr<rogue::Logging> eLog_;
+
+                // Rate limiters for the messages logged on bad frames
+                LogLimiter                      logBadFlags;
+                LogLimiter                      logBadSize;
             };
         }
     }
@@ -22,6 +22,10 @@
 **/
 
 #include <iostream>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include <rogue/interfaces/stream/Frame.h>
 #include <rogue/interfaces/stream/FrameLock.h>
 #include <rogue/interfaces/stream/FrameIterator.h>
@@ -29,6 +33,13 @@
 #include <rogue/interfaces/stream/Master.h>
 #include <rogue/GilRelease.h>
 #include "smurf/core/common/SmurfHeader.h"
+#include "smurf/core/common/SeqLock.h"
+#include "smurf/core/common/RateMeter.h"
+#include "smurf/core/common/LogHistogram.h"
+#include "smurf/core/common/MetricsRegistry.h"
+#include "smurf/core/common/TraceRecorder.h"
+#include "smurf/core/common/LogLimiter.h"
+#include "smurf/core/common/Helpers.h"
 
 namespace bp  = boost::python;
 namespace ris = rogue::interfaces::stream;
@@ -46,7 +57,7 @@ namespace smurf
             {
             public:
                 FrameStatistics();
-                ~FrameStatistics() {};
+                ~FrameStatistics();
 
                 static FrameStatisticsPtr create();
 
@@ -72,9 +83,136 @@ namespace smurf
                 // Get the number of bad frames
                 const std::size_t getBadFrameCnt() const;
 
+                // Get the number of times the frame number jumped back by more than 'resyncFrames' (or
+                // the reorder depth, if larger), like on a firmware counter reset or a 32-bit wrap. The
+                // frame checks start over from that frame, instead of dropping all the following frames.
+                static const std::size_t resyncFrames = 1000;
+                const std::size_t getResyncCnt() const;
+
+                // Get the frame rate (frames per second): measured over the last 100ms, averaged
+                // over 1s (w=0), 10s (w=1) or 60s (w=2), and the peak rate measured over 100ms.
+                const double getFrameRate() const;
+                const double getFrameRateAvg(std::size_t w) const;
+                const double getPeakFrameRate() const;
+
+                // Get the data rate (bytes per second), measured in the same way as the frame rate
+                const double getByteRate() const;
+                const double getByteRateAvg(std::size_t w) const;
+                const double getPeakByteRate() const;
+
+                // Get the minimum, maximum and mean time between consecutive frames (in ns)
+                const uint64_t getInterArrivalMin()  const;
+                const uint64_t getInterArrivalMax()  const;
+                const double   getInterArrivalMean() const;
+
+                // Get the time between consecutive frames (in ns) at a given percentile (in the range [0, 100])
+                const uint64_t getInterArrivalPercentile(double p) const;
+
+                // Set/Get the expected counter2 increment between consecutive frames (in counter2 units).
+                // If it is set to zero, the expected increment is learned from the incoming frames: it
+                // starts from the median of the first 5 increments, and then follows slow changes.
+                void           setExpectedPeriod(uint64_t p);
+                const uint64_t getExpectedPeriod() const;
+
+                // Get the counter2 increment currently used as reference (the expected one, or the learned one)
+                const double getPeriod() const;
+
+                // Set/Get the maximum deviation of the counter2 increment from the reference, before it
+                // is counted as an anomaly (in counter2 units). If it is set to zero, no anomalies are counted.
+                void           setJitterTolerance(uint64_t t);
+                const uint64_t getJitterTolerance() const;
+
+                // Set/Get the expected number of frames between 1Hz markers (counter0 resets). If it
+                // is set to zero, the expected number is learned from the first complete interval.
+                void              setFramesPerMarker(std::size_t n);
+                const std::size_t getFramesPerMarker() const;
+
+                // Get the number of timing anomalies: counter2 increments outside the tolerance,
+                // counter2 not increasing, counter0 resets at unexpected times, and missing counter0 resets.
+                const std::size_t getCounter2JitterCnt()      const;
+                const std::size_t getCounter2BackwardsCnt()   const;
+                const std::size_t getCounter0ResetCnt()       const;
+                const std::size_t getCounter0MissingResetCnt() const;
+
+                // Get the maximum and mean absolute deviation of the counter2 increment from the reference
+                const uint64_t getJitterMax()  const;
+                const double   getJitterMean() const;
+
+                // Get the absolute deviation of the counter2 increment at a given percentile (in the range [0, 100])
+                const uint64_t getJitterPercentile(double p) const;
+
+                // Set/Get the depth of the reorder window (in frames). Out-of-order frames arriving within
+                // the window are held, and released in frame counter order. If it is set to zero (the
+                // default), the reorder window is disabled, and out-of-order frames are dropped.
+                void              setReorderDepth(std::size_t d);
+                const std::size_t getReorderDepth() const;
+
+                // Set/Get the maximum time (in us) to wait for a missing frame, before releasing the
+                // frames held after it.
+                void              setReorderTimeout(std::size_t t);
+                const std::size_t getReorderTimeout() const;
+
+                // Get the reorder window counters: number of frames held because they arrived ahead of
+                // a missing frame, number of frames arrived after their position was already released,
+                // and number of times a missing frame was skipped because of the timeout, or because
+                // the window was full.
+                const std::size_t getReorderCnt()         const;
+                const std::size_t getReorderLateCnt()     const;
+                const std::size_t getReorderTimeoutCnt()  const;
+                const std::size_t getReorderOverflowCnt() const;
+
+                // Per-source statistics. When streams from several sources (ATCA crate and slot) are merged,
+                // the frame counters of each source are checked independently. Once a second source is seen,
+                // the global lost and out-of-order frame counts come from these per-source checks, the
+                // reorder window is bypassed, and the timing counters are only checked on the frames from
+                // the first source. The sources are added to a fixed table, in the order they are received;
+                // frames from sources which don't fit in the table are counted in 'SourceOverflowCnt', and
+                // are not checked. The source index 'i' is in the range [0, maxSources).
+                static const std::size_t maxSources = 8;
+
+                // Get the maximum number of sources
+                const std::size_t getMaxSources() const;
+
+                // Get the number of sources in the table
+                const std::size_t getSourceCnt() const;
+
+                // Get the number of frames from sources which didn't fit in the table
+                const std::size_t getSourceOverflowCnt() const;
+
+                // Get the crate ID and slot number of a source
+                const uint8_t getSourceCrateId(std::size_t i)    const;
+                const uint8_t getSourceSlotNumber(std::size_t i) const;
+
+                // Get the frame counter, number of lost frames, number of out-of-order frames and
+                // number of resyncs (see 'getResyncCnt') of a source
+                const std::size_t getSourceFrameCnt(std::size_t i)         const;
+                const std::size_t getSourceFrameLossCnt(std::size_t i)     const;
+                const std::size_t getSourceFrameOutOrderCnt(std::size_t i) const;
+                const std::size_t getSourceResyncCnt(std::size_t i)        const;
+
+                // Get the frame and data rates of a source, measured over the last 100ms
+                const double getSourceFrameRate(std::size_t i) const;
+                const double getSourceByteRate(std::size_t i)  const;
+
+                // Get a consistent snapshot of all the counters, as a python dictionary.
+                // The keys are the names of the counters (FrameCnt, FrameSize, etc.). The per-source
+                // counters are in 'Sources', a list with a dictionary per source in the table.
+                const bp::dict getSnapshot() const;
+
+                // Get the number of log messages suppressed by the rate limiters
+                const std::size_t getSuppressedLogCnt() const;
+
                 // Clear all counter.
                 void clearCnt();
 
+                // Register the counters, rates and inter-arrival histogram in the metrics
+                // registry, labeled with the block name 'name'. Calling it again replaces
+                // the previous registration.
+                void registerMetrics(const std::string& name);
+
+                // Set the block name used in the trace recorder
+                void setTraceName(const std::string& name);
+
                 // Accept new frames
                 void acceptFrame(ris::FramePtr frame);
 
@@ -82,18 +220,150 @@ namespace smurf
                 // Data type in incoming frame from firmware
                 typedef int16_t fw_t;
 
-                bool        disable;           // Disable flag
-                std::size_t frameCnt;          // Frame counter
-                std::size_t frameSize;         // Last frame size (bytes)
-                bool        firstFrame;        // Flag to indicate we are processing the first frame
-                std::size_t frameLossCnt;      // Number of frame lost
-                std::size_t frameOutOrderCnt;  // Counts the number of times we received an out-of-order frame
-                std::size_t badFrameCnt;       // Number of frames with errors
-                std::size_t frameNumber;       // Current frame number
-                std::size_t prevFrameNumber;   // Last frame number
+                // Counters. They are only written by the stream thread, inside the sequence lock.
+                enum Counter { FrameCnt, FrameLossCnt, FrameOutOrderCnt, BadFrameCnt, ResyncCnt,
+                               Counter2JitterCnt, Counter2BackwardsCnt, Counter0ResetCnt, Counter0MissingResetCnt,
+                               ReorderCnt, ReorderLateCnt, ReorderTimeoutCnt, ReorderOverflowCnt,
+                               SourceOverflowCnt,
+                               NumCounters };
+                typedef std::array<std::size_t, NumCounters> CounterValues;
+
+                // Counter names, used as keys in the snapshot
+                static const char* counterNames[NumCounters];
+
+                // Increment a counter. It must be called inside the counter sequence lock.
+                void incCounter(Counter c, std::size_t n = 1);
+
+                // Per-source counters
+                enum SourceCounter { SrcFrameCnt, SrcFrameLossCnt, SrcFrameOutOrderCnt, SrcResyncCnt, NumSourceCounters };
+                typedef std::array<std::atomic<std::size_t>, NumSourceCounters> SourceCounterArray;
+                typedef std::array<std::array<std::size_t, NumSourceCounters>, maxSources> SourceCounterValues;
+
+                // Per-source counter names, used as keys in the snapshot
+                static const char* sourceCounterNames[NumSourceCounters];
+
+                // Increment a per-source counter. It must be called inside the counter sequence lock.
+                void incSourceCounter(std::size_t i, SourceCounter c, std::size_t n = 1);
+
+                // Get a per-source counter (relative to the last clear)
+                const std::size_t readSourceCounter(std::size_t i, SourceCounter c) const;
+
+                // Result of the frame number check against the previous frame from the same source
+                enum SourceStatus { SrcNew, SrcInOrder, SrcOutOfOrder, SrcResync, SrcUnknown };
+                struct SourceCheck
+                {
+                    std::size_t  index;  // Source index (maxSources if the source is not in the table)
+                    SourceStatus status; // Check result
+                    std::size_t  steps;  // Frame number increment, for in-order frames
+                };
+
+                // Update the statistics of the source of a valid frame. It must be
+                // called inside the counter sequence lock.
+                SourceCheck updateSource(uint8_t crate, uint8_t slot, std::size_t number, std::size_t size, uint64_t now);
+
+                // Check a valid frame from merged streams, using the result of the per-source check.
+                // It returns 'false' if the frame must be dropped. It must be called inside the counter
+                // sequence lock.
+                bool checkSourceFrame(const SourceCheck& src, uint64_t counter2, uint32_t counter0);
+
+                // Frame held in the reorder window, together with the header values used by the checks
+                struct ReorderSlot
+                {
+                    ris::FramePtr frame;       // Frame
+                    std::size_t   frameNumber; // Frame number
+                    uint64_t      counter2;    // Counter2 value
+                    uint32_t      counter0;    // Counter0 value
+                };
+
+                // Check if a frame number jumped back from the last in-order frame number 'last' by
+                // more than the resync threshold, so that the frame checks must start over
+                bool isResync(std::size_t number, std::size_t last) const;
+
+                // Check the frame number and the timing counters of a valid frame, in the order the
+                // frames are released. It returns 'false' if the frame must be dropped.
+                // It must be called inside the counter sequence lock.
+                bool checkFrame(std::size_t number, uint64_t counter2, uint32_t counter0);
+
+                // Pass a valid frame through the reorder window. The frames ready to be released are
+                // added to 'txFrames'. It must be called inside the counter sequence lock.
+                void reorderFrame(ris::FramePtr frame, std::size_t number, uint64_t counter2, uint32_t counter0, uint64_t now);
+
+                // Release the held frames which are next in order
+                void releaseReady();
+
+                // Skip the missing frame(s), up to the next held frame, and release the frames which are next in order
+                void skipMissing();
+
+                // Release all the held frames, in order, and resize the reorder window. It must be called
+                // inside the counter sequence lock.
+                void flushReorder(std::size_t depth);
+
+                // Check the firmware timing counters of a valid frame. 'steps' is the frame number
+                // increment from the previous valid frame, or zero for the first frame.
+                // It must be called inside the counter sequence lock.
+                void checkTiming(uint64_t counter2, uint32_t counter0, std::size_t steps);
+
+                // Get a consistent copy of all the counters (relative to the last clear), and the last frame size.
+                // If 'sources' is not null, the per-source counters are copied too.
+                void readCounters(CounterValues& values, std::size_t& size, SourceCounterValues* sources = nullptr) const;
+
+                std::atomic<bool>                                  disable;          // Disable flag
+                std::atomic<std::size_t>                           frameSize;        // Last frame size (bytes)
+                std::array<std::atomic<std::size_t>, NumCounters>  counters;         // Counters, since the block was created
+                std::array<std::atomic<std::size_t>, NumCounters>  baseline;         // Counter values at the last clear
+                SeqLock                                            countersLock;     // Sequence lock for the counters
+                SeqLock                                            baselineLock;     // Sequence lock for the counter baselines
+                std::mutex                                         clearMutex;       // Mutex to serialize the clear requests
+                RateMeter                                          frameRate;        // Frame rate meter
+                RateMeter                                          byteRate;         // Data rate meter
+                LogHistogram                                       interArrival;     // Histogram of the time between frames
+                uint64_t                                           lastArrival;      // Arrival time of the last frame
+                bool                                               firstFrame;       // Flag to indicate we are processing the first frame
+
+                // Per-source statistics
+                std::atomic<std::size_t>                           sourceCnt;        // Number of sources in the table
+                std::array<std::atomic<uint16_t>, maxSources>      sourceKey;        // Crate ID and slot number of each source
+                std::array<SourceCounterArray, maxSources>         sourceCounters;   // Counters of each source
+                std::array<SourceCounterArray, maxSources>         sourceBaseline;   // Counter values of each source at the last clear
+                std::array<RateMeter, maxSources>                  sourceFrameRate;  // Frame rate meter of each source
+                std::array<RateMeter, maxSources>                  sourceByteRate;   // Data rate meter of each source
+                std::array<std::size_t, maxSources>                sourceNumber;     // Last frame number of each source
+
+                // Reorder window
+                std::atomic<std::size_t>                           reorderDepth;     // Requested window depth
+                std::atomic<std::size_t>                           reorderTimeout;   // Timeout (us)
+                std::vector<ReorderSlot>                           reorderRing;      // Held frames, indexed by frame number modulo the depth
+                std::size_t                                        heldCnt;          // Number of held frames
+                std::size_t                                        nextNumber;       // Next frame number to release
+                uint64_t                                           waitStart;        // Time we started waiting for the next frame
+                std::vector<ris::FramePtr>                         txFrames;         // Frames to be sent to the next slave
+
+                // Timing checks
+                std::atomic<uint64_t>                              expectedPeriod;   // Expected counter2 increment (0 = learned)
+                std::atomic<double>                                period;           // Counter2 increment used as reference
+                std::atomic<uint64_t>                              jitterTolerance;  // Maximum counter2 increment deviation
+                std::atomic<std::size_t>                           framesPerMarker;  // Expected frames between 1Hz markers (0 = learned)
+                LogHistogram                                       jitter;           // Histogram of the counter2 increment deviation
+                static const std::size_t                           learnFrames = 5;  // Number of increments used to seed the learned increment
+                double                                             learnedPeriod;    // Learned counter2 increment (0 = not learned yet)
+                std::array<double, learnFrames>                    learnDeltas;      // First increments, used to seed the learned increment
+                std::size_t                                        learnCnt;         // Number of increments in 'learnDeltas'
+                std::size_t                                        learnedFrames;    // Learned frames between 1Hz markers
+                uint64_t                                           prevCounter2;     // Last counter2 value
+                uint32_t                                           prevCounter0;     // Last counter0 value
+                std::size_t                                        framesSinceMarker; // Frames since the last 1Hz marker
+                bool                                               markerSeen;       // Flag to indicate a 1Hz marker was received
+                bool                                               missingReported;  // Flag to indicate a missing marker was already counted
+                std::size_t                                        frameNumber;      // Current frame number
+                std::size_t                                        prevFrameNumber;  // Last frame number
+                uint16_t                                           traceId;          // Block ID in the trace recorder
 
                 // Logger
                 std::shared_ptr<rogue::Logging> eLog_;
+
+                // Rate limiters for the messages logged on bad frames
+                LogLimiter                      logBadFlags;
+                LogLimiter                      logBadSize;
             };
         }
     }
@@ -0,0 +1,125 @@
+#ifndef _SMURF_CORE_COUNTERS_LATENCYPROBE_H_
+#define _SMURF_CORE_COUNTERS_LATENCYPROBE_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Latency Probe
+ * ----------------------------------------------------------------------------
+ * File          : LatencyProbe.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Latency Probe Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <atomic>
+#include <rogue/interfaces/stream/Frame.h>
+#include <rogue/interfaces/stream/FrameLock.h>
+#include <rogue/interfaces/stream/FrameIterator.h>
+#include <rogue/interfaces/stream/Slave.h>
+#include <rogue/interfaces/stream/Master.h>
+#include <rogue/GilRelease.h>
+#include <rogue/Logging.h>
+#include "smurf/core/common/SmurfHeader.h"
+#include "smurf/core/common/LogHistogram.h"
+#include "smurf/core/common/MetricsRegistry.h"
+#include "smurf/core/common/Helpers.h"
+
+namespace bp  = boost::python;
+namespace ris = rogue::interfaces::stream;
+
+namespace smurf
+{
+    namespace core
+    {
+        namespace counters
+        {
+            class LatencyProbe;
+            typedef std::shared_ptr<LatencyProbe> LatencyProbePtr;
+
+            // This class measures the latency of the frames passing through it, as the difference
+            // between the local clock and a timestamp in the frame header. The latencies are
+            // accumulated in a logarithmic histogram, from which percentiles can be read.
+            class LatencyProbe : public ris::Slave, public ris::Master
+            {
+            public:
+                LatencyProbe();
+                ~LatencyProbe();
+
+                static LatencyProbePtr create();
+
+                static void setup_python();
+
+                // Disable the processing block. The data
+                // will just pass through to the next slave
+                void       setDisable(bool d);
+                const bool getDisable() const;
+
+                // Set/Get the timestamp source. Changing it clears the histogram.
+                //  - 0: UnixTime header field, compared against the steady clock. This is the
+                //       time written by the Header2Smurf block, using the same clock.
+                //  - 1: UnixTime header field, compared against the system (realtime) clock.
+                //  - 2: Counter2 header field, compared against the system (realtime) clock. The
+                //       upper 32 bits are interpreted as seconds, and the lower 32 bits as nanoseconds.
+                void      setSource(int s);
+                const int getSource() const;
+
+                // Get the number of measured frames
+                const std::size_t getFrameCnt() const;
+
+                // Get the number of bad frames
+                const std::size_t getBadFrameCnt() const;
+
+                // Get the number of frames with timestamps in the future
+                const std::size_t getNegativeCnt() const;
+
+                // Get the last, minimum, maximum and mean latency (in ns)
+                const uint64_t getLast() const;
+                const uint64_t getMin()  const;
+                const uint64_t getMax()  const;
+                const double   getMean() const;
+
+                // Get the latency (in ns) at a given percentile (in the range [0, 100])
+                const uint64_t getPercentile(double p) const;
+
+                // Clear all counter.
+                void clearCnt();
+
+                // Register the counters and the latency histogram in the
+                // metrics registry, labeled with the block name 'name'.
+                void registerMetrics(const std::string& name);
+
+                // Accept new frames
+                void acceptFrame(ris::FramePtr frame);
+
+            private:
+                // Timestamp sources
+                enum class TimeSource { UnixTimeSteady, UnixTimeRealtime, Counter2Realtime, Size };
+
+                // Get the current time from the system (realtime) clock, in nanoseconds
+                static uint64_t getRealtimeNS();
+
+                std::atomic<bool>        disable;     // Disable flag
+                std::atomic<int>         source;      // Timestamp source
+                std::atomic<std::size_t> badFrameCnt; // Number of bad frames
+                std::atomic<std::size_t> negativeCnt; // Number of frames with timestamps in the future
+                std::atomic<uint64_t>    last;        // Last latency
+                LogHistogram             histogram;   // Latency histogram
+
+                // Logger
+                std::shared_ptr<rogue::Logging> eLog_;
+            };
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef _SMURF_CORE_EMULATORS_FAULTINJECTOR_H_
+#define _SMURF_CORE_EMULATORS_FAULTINJECTOR_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Fault Injector
+ * ----------------------------------------------------------------------------
+ * File          : FaultInjector.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Fault Injector Class
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <array>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <rogue/interfaces/stream/Frame.h>
+#include <rogue/interfaces/stream/FrameLock.h>
+#include <rogue/interfaces/stream/FrameIterator.h>
+#include <rogue/interfaces/stream/Slave.h>
+#include <rogue/interfaces/stream/Master.h>
+#include <rogue/GilRelease.h>
+#include <rogue/Logging.h>
+#include "smurf/core/common/MetricsRegistry.h"
+#include "smurf/core/common/Helpers.h"
+
+namespace bp  = boost::python;
+namespace ris = rogue::interfaces::stream;
+
+namespace smurf
+{
+    namespace core
+    {
+        namespace emulators
+        {
+            class FaultInjector;
+            typedef std::shared_ptr<FaultInjector> FaultInjectorPtr;
+
+            // This class injects faults in the stream of frames passing through it. Each type
+            // of fault has its own rate, which is interpreted either as a probability per frame,
+            // or as a fixed schedule (one fault every 1/rate frames).
+            class FaultInjector : public ris::Slave, public ris::Master
+            {
+            public:
+                FaultInjector();
+                ~FaultInjector();
+
+                static FaultInjectorPtr create();
+
+                static void setup_python();
+
+                // Accept new frames
+                void acceptFrame(ris::FramePtr frame);
+
+                // Disable the processing block. The data
+                // will just pass through to the next slave
+                void       setDisable(bool d);
+                const bool getDisable() const;
+
+                // Set/Get the schedule mode. If enabled, the faults are injected periodically
+                // at their defined rate. Otherwise, they are injected randomly.
+                void       setPeriodic(bool p);
+                const bool getPeriodic() const;
+
+                // Set/Get the rate of a fault type, in the range [0, 1]
+                void         setRate(std::size_t fault, double value);
+                const double getRate(std::size_t fault) const;
+
+                // Set/Get the delay applied to delayed frames (in us)
+                void              setDelay(std::size_t value);
+                const std::size_t getDelay() const;
+
+                // Set/Get the number of frames held and sent back-to-back in a burst
+                void              setBurstSize(std::size_t value);
+                const std::size_t getBurstSize() const;
+
+                // Get the number of injected faults of a fault type
+                const std::size_t getFaultCnt(std::size_t fault) const;
+
+                // Get the number of received frames
+                const std::size_t getFrameCnt() const;
+
+                // Get the time of the last injected fault (in ns, from the steady clock)
+                const uint64_t getLastFaultTime() const;
+
+                // Clear all counters
+                void clearCnt();
+
+                // Register the counters in the metrics registry,
+                // labeled with the block name 'name'.
+                void registerMetrics(const std::string& name);
+
+            private:
+                // Types of faults
+                enum class FaultType { Reorder, Duplicate, Truncate, BitFlip, Error, Delay, Burst, Size };
+
+                static const std::size_t numFaults = static_cast<std::size_t>(FaultType::Size);
+
+                // Decide if a fault should be injected in the current frame
+                bool inject(FaultType f);
+
+                // Create a copy of a frame
+                ris::FramePtr copyFrame(ris::FramePtr frame);
+
+                // Logger
+                std::shared_ptr<rogue::Logging> eLog_;
+
+                // Mutex
+                std::mutex  mtx_;
+
+                // Variables
+                bool                                        disable_;       // Disable flag
+                bool                                        periodic_;      // Periodic schedule flag
+                std::array<double, numFaults>               rate_;          // Fault rates
+                std::array<double, numFaults>               acc_;           // Periodic schedule accumulators
+                std::atomic<std::size_t>                    delay_;         // Delay (us)
+                std::atomic<std::size_t>                    burstSize_;     // Burst size (frames)
+                std::array<std::atomic<std::size_t>, numFaults> faultCnt_;  // Fault counters
+                std::atomic<std::size_t>                    frameCnt_;      // Frame counter
+                std::atomic<uint64_t>                       lastFaultTime_; // Time of the last injected fault
+                ris::FramePtr                               reorderFrame_;  // Frame held to be sent out of order
+                std::deque<ris::FramePtr>                   burstFrames_;   // Frames held to be sent in a burst
+                std::size_t                                 burstCnt_;      // Number of frames to be added to the current burst
+
+                // Variables use to generate random numbers
+                std::random_device                     rd;  // Will be used to obtain a seed for the random number engine
+                std::mt19937                           gen; // Standard mersenne_twister_engine seeded with rd()
+                std::uniform_real_distribution<double> dis; // Uniform distribution in [0, 1)
+            };
+        }
+    }
+}
+
+#endif
@@ -23,6 +23,9 @@
 
 #include <type_traits>
 #include <limits>
+#include <mutex>
+#include <atomic>
+#include <vector>
 #include <rogue/interfaces/stream/Frame.h>
 #include <rogue/interfaces/stream/FrameLock.h>
 #include <rogue/interfaces/stream/FrameIterator.h>
@@ -34,6 +37,9 @@
 #include <rogue/Logging.h>
 #include "smurf/core/common/SmurfHeader.h"
 #include "smurf/core/common/Helpers.h"
+#include "smurf/core/common/TripleBuffer.h"
+#include "smurf/core/common/TraceRecorder.h"
+#include "smurf/core/common/LogLimiter.h"
 #include <random>
 
 namespace bp  = boost::python;
@@ -75,6 +81,13 @@ namespace smurf
                 void       setDisable(bool d);
                 const bool getDisable() const;
 
+                // Get the number of log messages suppressed by the rate limiters
+                const std::size_t getSuppressedLogCnt() const;
+                void              clearSuppressedLogCnt();
+
+                // Set the block name used in the trace recorder
+                void setTraceName(const std::string& name);
+
                 // Set/Get operation mode
                 void      setType(int value);
                 const int getType() const;
@@ -91,38 +104,147 @@ namespace smurf
                 void              setPeriod(std::size_t value);
                 const std::size_t getPeriod() const;
 
+                // Detector signal parameters. They are expressed in ADC counts (per frame for the drift rate),
+                // and as probabilities per channel and per frame for the flux jumps and glitches.
+                void         setWhiteNoise(double value);
+                const double getWhiteNoise() const;
+
+                void         setPinkNoise(double value);
+                const double getPinkNoise() const;
+
+                void         setDriftRate(double value);
+                const double getDriftRate() const;
+
+                void         setFluxJumpProbability(double value);
+                const double getFluxJumpProbability() const;
+
+                void         setFluxJumpAmplitude(double value);
+                const double getFluxJumpAmplitude() const;
+
+                void         setGlitchProbability(double value);
+                const double getGlitchProbability() const;
+
+                void         setGlitchAmplitude(double value);
+                const double getGlitchAmplitude() const;
+
+                void         setCommonMode(double value);
+                const double getCommonMode() const;
+
+                // Per-channel sine signal parameters. The frequencies are expressed in cycles per frame,
+                // the amplitudes in ADC counts, and the phases in degrees. Channels without an element
+                // in these lists are set to the signal offset.
+                void           setSineFrequencies(bp::list l);
+                const bp::list getSineFrequencies() const;
+
+                void           setSineAmplitudes(bp::list l);
+                const bp::list getSineAmplitudes() const;
+
+                void           setSinePhases(bp::list l);
+                const bp::list getSinePhases() const;
+
             private:
                 // Types of signal
-                enum class SignalType { Zeros, ChannelNumber, Random, Square, Sawtooth, Triangle, Sine, DropFrame, Size };
+                enum class SignalType { Zeros, ChannelNumber, Random, Square, Sawtooth, Triangle, Sine, DropFrame, Detector, ChannelSine, Size };
 
-                // Maximum amplitude value
-                const uT_t maxAmplitude = std::numeric_limits<uT_t>::max();
+                // Maximum number of channels in a SMuRF frame
+                static const std::size_t maxNumCh = 4096;
+
+                // Emulator configuration. The setters modify a master copy of it, and publish
+                // snapshots to the stream thread through a triple buffer, so that the stream
+                // thread never needs to take a lock. The epoch counters are incremented when
+                // the stream thread state must be re-initialized.
+                struct Config
+                {
+                    SignalType          type          { SignalType::Zeros };                  // Signal type
+                    uT_t                amplitude     { std::numeric_limits<uT_t>::max() };   // Signal amplitude
+                    T                   offset        { 0 };                                  // Signal offset
+                    std::size_t         period        { 2 };                                  // Signal period
+                    std::size_t         halfPeriod    { 1 };                                  // Signal half period
+
+                    double              whiteNoise    { 10 };  // White noise RMS
+                    double              pinkNoise     { 10 };  // 1/f noise RMS
+                    double              driftRate     { 10 };  // Maximum drift rate
+                    double              jumpProb      { 0 };   // Flux jump probability
+                    double              jumpAmp       { 0 };   // Flux jump amplitude
+                    double              glitchProb    { 0 };   // Glitch probability
+                    double              glitchAmp     { 0 };   // Glitch amplitude
+                    double              commonMode    { 0 };   // Common mode RMS
+
+                    std::vector<double> sineFreq;              // Channel sine frequencies
+                    std::vector<double> sineAmp;               // Channel sine amplitudes
+                    std::vector<double> sinePhase;             // Channel sine phases
+
+                    std::size_t         counterEpoch  { 0 };   // The frame period counter must be reset
+                    std::size_t         detectorEpoch { 0 };   // The detector per-channel state must be re-initialized
+                    std::size_t         oscEpoch      { 0 };   // The channel sine oscillators must be re-initialized
+                };
+
+                // Publish the master copy of the configuration. It must be called holding the configuration mutex.
+                void publishConfig();
+
+                // Take the latest configuration snapshot. It must only be called from the stream thread.
+                const Config& updateConfig();
 
                 // Signal generator methods
                 void genZeroWave(ris::FrameAccessor<T> &dPtr)          const;
                 void genChannelNumberWave(ris::FrameAccessor<T> &dPtr) const;
                 void genRandomWave(ris::FrameAccessor<T> &dPtr);
-                void genSquareWave(ris::FrameAccessor<T> &dPtr);
-                void getSawtoothWave(ris::FrameAccessor<T> &dPtr);
-                void genTriangleWave(ris::FrameAccessor<T> &dPtr);
-                void genSinWave(ris::FrameAccessor<T> &dPtr);
-                void genFrameDrop();
+                void genSquareWave(ris::FrameAccessor<T> &dPtr, const Config& c);
+                void getSawtoothWave(ris::FrameAccessor<T> &dPtr, const Config& c);
+                void genTriangleWave(ris::FrameAccessor<T> &dPtr, const Config& c);
+                void genSinWave(ris::FrameAccessor<T> &dPtr, const Config& c);
+                void genFrameDrop(const Config& c);
+                void genDetectorWave(ris::FrameAccessor<T> &dPtr, const Config& c);
+
+                void genChannelSineWave(ris::FrameAccessor<T> &dPtr, const Config& c);
+
+                // Resize and re-initialize the per-channel state used by the detector signal
+                void resetDetector(std::size_t numCh, const Config& c);
+
+                // Resize and re-initialize the per-channel oscillators used by the channel sine signal
+                void resetOscillators(std::size_t numCh, const Config& c);
+
+                // Helper functions to convert between python lists and vectors
+                static std::vector<double> listToVector(const bp::list& l);
+                static bp::list            vectorToList(const std::vector<double>& v);
 
                 // Logger
                 std::shared_ptr<rogue::Logging> eLog_;
 
-                // Mutex
-                std::mutex  mtx_;
+                // Rate limiters for the messages logged on bad frames
+                LogLimiter               logCopy_;
+                LogLimiter               logBadFlags_;
+                LogLimiter               logBadSize_;
 
-                // Variables
-                bool        disable_;       // Disable flag
-                SignalType  type_;          // signal type
-                uT_t        amplitude_;     // Signal amplitude
-                T           offset_;        // Signal offset
-                std::size_t period_;        // Signal period
-                std::size_t halfPeriod_;    // Signal half period
+                // Configuration
+                mutable std::mutex       cfgMtx_;  // Mutex to serialize the setters and getters
+                Config                   cfg_;     // Master copy of the configuration
+                TripleBuffer<Config>     config_;  // Configuration snapshots published to the stream thread
+                std::atomic<bool>        disable_; // Disable flag
+                uint16_t                 traceId_; // Block ID in the trace recorder
+
+                // Stream thread state. These variables are only accessed by the stream thread.
+                std::size_t counterEpoch_;  // Last seen configuration epochs
+                std::size_t detectorEpoch_;
+                std::size_t oscEpoch_;
                 std::size_t periodCounter_; // Frame period counter
                 bool        dropFrame_;     // Flag to indicate if the frame should be dropped
+                bool        resetDetector_; // Flag to indicate that the per-channel state must be re-initialized
+                bool        resetOscillators_; // Flag to indicate that the oscillators must be re-initialized
+
+                // Detector signal per-channel state, as structure of arrays.
+                std::vector<double>   phase_;  // Accumulated phase (drift plus flux jumps)
+                std::vector<double>   drift_;  // Drift rate
+                std::vector<double>   pink0_;  // 1/f noise filter states
+                std::vector<double>   pink1_;
+                std::vector<double>   pink2_;
+                std::vector<uint32_t> seed_;   // Xorshift random number generator states
+                double                commonPink_; // Common mode 1/f noise filter state
+
+                // Channel sine signal per-channel oscillators, as structure of arrays.
+                std::vector<uint32_t> oscPhase_;       // Phase accumulators
+                std::vector<uint32_t> oscStep_;        // Phase accumulator steps
+                std::vector<double>   oscAmp_;         // Amplitudes
 
                 // Variables use to generate random numbers
                 std::random_device                     rd;  // Will be used to obtain a seed for the random number engine
@@ -0,0 +1,178 @@
+#ifndef _SMURF_CORE_EMULATORS_SYSGENCRYOEMULATOR_H_
+#define _SMURF_CORE_EMULATORS_SYSGENCRYOEMULATOR_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF SysgenCryo Emulator
+ * ----------------------------------------------------------------------------
+ * File          : SysgenCryoEmulator.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF SysgenCryo Emulator Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <random>
+#include <vector>
+#include <condition_variable>
+#include <rogue/interfaces/memory/Slave.h>
+#include <rogue/interfaces/memory/Transaction.h>
+#include <rogue/interfaces/memory/Constants.h>
+#include <rogue/GilRelease.h>
+#include <rogue/Logging.h>
+
+namespace bp  = boost::python;
+namespace rim = rogue::interfaces::memory;
+
+namespace smurf
+{
+    namespace core
+    {
+        namespace emulators
+        {
+            class SysgenCryoEmulator;
+            typedef std::shared_ptr<SysgenCryoEmulator> SysgenCryoEmulatorPtr;
+
+            // This class emulates the SysgenCryo register space, so that the SysgenCryo
+            // engine can be tested and benchmarked without hardware. Each band has 8 KB,
+            // with the config0, config1, status0 and status1 banks, and the bands are
+            // contiguous (band N starts at address N * 0x2000).
+            //
+            // The config banks are plain memory. The status banks are computed when they
+            // are read, from the config words and a resonator per channel: with feedback
+            // disabled, the frequency error is the real part of eta * S21 at the channel
+            // frequency; with feedback enabled, the loop is locked on the resonator, and
+            // the loop filter output holds the resonator offset.
+            //
+            // Each transaction takes 'latency' us, plus its size divided by the
+            // 'bandwidth'. The transactions share the link: they are transferred one
+            // at a time, but their latencies overlap, like in a pipelined bus.
+            class SysgenCryoEmulator : public rim::Slave
+            {
+            public:
+                SysgenCryoEmulator(std::size_t numBands);
+                ~SysgenCryoEmulator();
+
+                static SysgenCryoEmulatorPtr create(std::size_t numBands);
+
+                static void setup_python();
+
+                // Process a memory transaction
+                void doTransaction(rim::TransactionPtr tran);
+
+                // Set/Get the latency of each transaction (in us)
+                void         setLatency(double value);
+                const double getLatency() const;
+
+                // Set/Get the link bandwidth (in bytes per second). Zero means no limit.
+                void         setBandwidth(double value);
+                const double getBandwidth() const;
+
+                // Set/Get the RMS noise added to the frequency error (in raw counts)
+                void         setNoise(double value);
+                const double getNoise() const;
+
+                // Set the resonator of a channel: its frequency offset from the channel
+                // center (in MHz), its bandwidth (in MHz) and its depth (in [0, 1])
+                void setResonator(std::size_t band, std::size_t channel, double frequency, double bandwidth, double depth);
+
+                // Get the resonator frequency offset of a channel (in MHz)
+                const double getResonatorFrequency(std::size_t band, std::size_t channel) const;
+
+                // Set random resonator frequency offsets in [-'maxOffset', 'maxOffset'] MHz
+                // on all the channels, using 'seed' as the random seed
+                void randomizeResonators(double maxOffset, uint32_t seed);
+
+                // Get the number of bands
+                const std::size_t getNumBands() const;
+
+                // Get the number of transactions
+                const std::size_t getTransactionCnt() const;
+
+                // Get the number of read and written bytes
+                const std::size_t getReadBytes() const;
+                const std::size_t getWriteBytes() const;
+
+                // Clear all counters
+                void clearCnt();
+
+            private:
+                // Register space layout
+                static const uint32_t    bandSize      = 0x2000;      // Size of a band (bytes)
+                static const uint32_t    bankSize      = 0x800;       // Size of a bank (bytes)
+                static const std::size_t numChannels   = 512;         // Number of channels per band
+                static constexpr double  frequencySpan = 9.6;         // Channel frequency span (MHz)
+                static constexpr double  errorScale    = 1048576.0;   // Frequency error full scale (raw counts)
+
+                // Resonator of a channel
+                struct Resonator
+                {
+                    double frequency; // Frequency offset from the channel center (MHz)
+                    double bandwidth; // Bandwidth (MHz)
+                    double depth;     // Depth, in [0, 1]
+                };
+
+                // Transaction waiting to be completed
+                struct Pending
+                {
+                    rim::TransactionPtr tran; // Transaction
+                    uint64_t            due;  // Time to complete it (ns, from the steady clock)
+                };
+
+                // Check a transaction, and read or write the register words. It must
+                // be called holding the mutex.
+                void process(rim::TransactionPtr tran);
+
+                // Compute the status0 and status1 words of a channel. They must be
+                // called holding the mutex.
+                uint32_t status0(std::size_t band, std::size_t channel);
+                uint32_t status1(std::size_t band, std::size_t channel);
+
+                // Thread which completes the delayed transactions
+                void runThread();
+
+                std::size_t                     numBands;   // Number of bands
+                std::vector<uint32_t>           config;     // Config words, by band (config0 then config1)
+                std::vector<Resonator>          resonators; // Resonators, by band and channel
+                double                          latency;    // Latency (us)
+                double                          bandwidth;  // Bandwidth (bytes/s)
+                double                          noise;      // Frequency error noise (raw counts)
+                uint64_t                        linkFree;   // Time the link is free (ns, from the steady clock)
+
+                // Counters
+                std::atomic<std::size_t>        tranCnt;    // Number of transactions
+                std::atomic<std::size_t>        readBytes;  // Number of read bytes
+                std::atomic<std::size_t>        writeBytes; // Number of written bytes
+
+                // Delayed transactions, in completion order
+                std::deque<Pending>             queue;      // Transactions
+                mutable std::mutex              mtx;        // Mutex to access all the variables
+                std::condition_variable         queueCV;    // Variable to notify the thread there are new transactions
+                bool                            runTx;      // Flag used to stop the thread
+                std::thread                     txThread;   // Thread which completes the transactions
+
+                // Variables use to generate the noise
+                std::mt19937                     gen;       // Standard mersenne_twister_engine
+                std::normal_distribution<double> dis;       // Normal distribution
+
+                // Logger
+                std::shared_ptr<rogue::Logging> eLog_;
+            };
+        }
+    }
+}
+
+#endif
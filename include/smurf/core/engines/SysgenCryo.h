@@ -1,9 +1,14 @@
 #include <stdint.h>
+#include <deque>
+#include <bitset>
+#include <vector>
+#include <functional>
 #include <rogue/interfaces/memory/Constants.h>
 #include <rogue/interfaces/memory/Master.h>
 #include <boost/python.hpp>
 #include <boost/python/module.hpp>
 #include <boost/python/stl_iterator.hpp>
+#include <boost/python/numpy.hpp>
 
 #ifndef _SYSGEN_CRYO_H_
 #define _SYSGEN_CRYO_H_
@@ -72,6 +77,33 @@ namespace smurf {
            }
         
         
+           // Get a contiguous 1-D NumPy array of type T from a Python object. NumPy
+           // arrays of type T are used as they are, without copying the data; other
+           // arrays (like the int64 arrays from np.arange) and sequences (like lists)
+           // are converted.
+           template<typename T>
+           inline
+           boost::python::numpy::ndarray py_to_ndarray( const boost::python::object& obj )
+           {
+               boost::python::numpy::dtype   dt { boost::python::numpy::dtype::get_builtin<T>() };
+               boost::python::numpy::ndarray a  { boost::python::numpy::from_object( obj, 1, 1,
+                                                    boost::python::numpy::ndarray::C_CONTIGUOUS ) };
+
+               if ( ! boost::python::numpy::equivalent( a.get_dtype(), dt ) )
+                   a = a.astype( dt );
+
+               return a;
+           }
+
+           // Create a new 1-D NumPy array of type T
+           template<typename T>
+           inline
+           boost::python::numpy::ndarray new_ndarray( size_t size )
+           {
+               return boost::python::numpy::empty( boost::python::make_tuple( size ),
+                                                   boost::python::numpy::dtype::get_builtin<T>() );
+           }
+
            template <class T>
            inline
            boost::python::list std_vector_to_py_list(std::vector<T> vector) {
@@ -93,13 +125,27 @@ namespace smurf {
                    static constexpr int      MIN_AMPLITUDE_C     = 0;
                    static constexpr double   MAX_ETA_PHASE_C     = 180.0;
                    static constexpr double   MIN_ETA_PHASE_C     = -180.0;
-                   static constexpr double   MAX_ETA_MAG_C       = 100.0;
+                   static constexpr double   MAX_ETA_MAG_C       = 32767.0 / 1024.0; // Signed 16-bit field, 2^10 scale
                    static constexpr double   MIN_ETA_MAG_C       = 0.0;
         
+                   // Conversion factors between values and register fields
+                   static constexpr double   FREQUENCY_TO_REG_C  = 16777216.0 / FREQUENCY_SPAN_C * 1e6; // 2^24 / span, in MHz
+                   static constexpr double   REG_TO_FREQUENCY_C  = FREQUENCY_SPAN_C * 1e-6 / 16777216.0;
+                   static constexpr double   REG_TO_FREQ_ERROR_C = FREQUENCY_SPAN_C * 1e-6 / 8388608.0;  // span / 2^23, in MHz
+                   static constexpr double   ETA_PHASE_TO_REG_C  = 32768.0 / 180.0;
+                   static constexpr double   REG_TO_ETA_PHASE_C  = 180.0 / 32768.0;
+                   static constexpr double   ETA_MAG_TO_REG_C    = 1024.0;
+                   static constexpr double   REG_TO_ETA_MAG_C    = 1.0 / 1024.0;
+
                    static constexpr uint32_t CONFIG0_BASE_ADDR_C = 0x0000;
                    static constexpr uint32_t CONFIG1_BASE_ADDR_C = 0x0800;
                    static constexpr uint32_t STATUS0_BASE_ADDR_C = 0x1000;
                    static constexpr uint32_t STATUS1_BASE_ADDR_C = 0x1800;
+                   static constexpr uint32_t BANKS_SIZE_C        = 0x2000;
+
+                   // Clean words between two dirty ranges are written too, instead of
+                   // starting a new transaction, if there are at most this many of them
+                   static constexpr int      FLUSH_MAX_GAP_C     = 16;
         
                    uint32_t offset_;
         
@@ -112,80 +158,206 @@ namespace smurf {
         
                    std::vector<double> results_real_;
                    std::vector<double> results_imag_;
+
+                   // Channels and frequency offsets (MHz) of the last eta scan
+                   std::vector<int>    scan_channels_;
+                   std::vector<double> scan_frequencies_;
+
+                   // Eta parameters estimated from the last eta scan, by scanned channel
+                   std::vector<double> eta_phase_estimate_;
+                   std::vector<double> eta_mag_estimate_;
+                   std::vector<double> eta_center_estimate_;
         
                    config0 config0_shadow[NUM_CHANNELS_C]; 
                    config1 config1_shadow[NUM_CHANNELS_C]; 
                    status0 status0_shadow[NUM_CHANNELS_C]; 
                    status1 status1_shadow[NUM_CHANNELS_C]; 
+
+                   // Words of the config shadows modified since they were last written
+                   // or read. A shadow is valid once it was fully written or read; until
+                   // then, every word set is marked as dirty, even if it didn't change.
+                   std::bitset<NUM_CHANNELS_C> config0_dirty_;
+                   std::bitset<NUM_CHANNELS_C> config1_dirty_;
+                   bool                        config0_valid_;
+                   bool                        config1_valid_;
+
+                   // Outstanding asynchronous transactions, oldest first. The write
+                   // data is copied to 'data', so the caller's buffer can be reused
+                   // right away. The read data goes directly to the caller's buffer.
+                   typedef struct {
+                       uint32_t                  id;
+                       std::vector<uint32_t>     data;
+                       std::function<void(bool)> callback;
+                   } pending_transaction;
+
+                   // Raw copy of the four banks, and time of the last snapshot
+                   uint32_t snapshot_buffer_[BANKS_SIZE_C/4];
+                   double   snapshot_time_;
+
+                   std::deque<pending_transaction> pending_;
+                   size_t                          max_in_flight_;
+
+                   // Time (us) to wait after each frequency step of the eta scans, before
+                   // reading the frequency error, so that the tracking DSP settles
+                   uint32_t                        scan_dwell_;
+
+                   uint32_t reqAsync(uint32_t address, size_t size, uint32_t *reg, uint32_t type, std::function<void(bool)> callback);
+                   bool     completeOldest();
+
+                   // Copy packed words to a config shadow, marking the changed words as dirty
+                   void     storeConfig0(const uint32_t *words);
+                   void     storeConfig1(const uint32_t *words);
+
+                   void     commitConfig0(int channel, uint32_t old, bool write);
+                   void     commitConfig1(int channel, uint32_t old, bool write);
+                   // Write the dirty words of a config shadow for the channels in 'mask'
+                   int      flushBank(uint32_t address, uint32_t *shadow, std::bitset<NUM_CHANNELS_C> &dirty, bool valid,
+                                      const std::bitset<NUM_CHANNELS_C> &mask);
+
+                   void     sweepChannel(int channel, double centerFrequency, const std::vector<double> &frequencies, double *results);
+                   void     sweepChannels(const std::vector<int> &channels, const std::vector<double> &centerFrequencies,
+                                          const std::vector<double> &frequencies, int first, int last, std::vector<double> &results);
         
                public:
         
-                   SysgenCryo() : rogue::interfaces::memory::Master() {}
+                   SysgenCryo() : rogue::interfaces::memory::Master(), config0_valid_(false), config1_valid_(false), snapshot_time_(0), max_in_flight_(64), scan_dwell_(10) {}
         
+                   // Each call creates a new engine, so each band can have its own one
+                   // (see SysgenCryoBands)
                    static std::shared_ptr<smurf::core::engines::SysgenCryo> create() {
-                       static std::shared_ptr<smurf::core::engines::SysgenCryo> ret = std::make_shared<smurf::core::engines::SysgenCryo>();
-                       return ret;
+                       return std::make_shared<smurf::core::engines::SysgenCryo>();
                    }
         
                    void   setOffset(uint32_t offset);
         
                    void   setBand(uint32_t offset);
+
+                   // Bulk conversion kernels, between values and packed register words. The
+                   // pack kernels clamp and round the values, and only modify their field bits.
+                   // They are also used by the status poller (see SysgenCryoPoller).
+                   static void packEtaMag(const double *values, uint32_t *words, int n);
+                   static void unpackEtaMag(const uint32_t *words, double *values, int n);
+                   static void packEtaPhase(const double *values, uint32_t *words, int n);
+                   static void unpackEtaPhase(const uint32_t *words, double *values, int n);
+                   static void packCenterFrequency(const double *values, uint32_t *words, int n);
+                   static void unpackCenterFrequency(const uint32_t *words, double *values, int n);
+                   static void packAmplitudeScale(const int *values, uint32_t *words, int n);
+                   static void unpackAmplitudeScale(const uint32_t *words, int *values, int n);
+                   static void packFeedbackEnable(const int *values, uint32_t *words, int n);
+                   static void unpackFeedbackEnable(const uint32_t *words, int *values, int n);
+                   static void unpackLoopFilterOutput(const uint32_t *words, double *values, int n);
+                   static void unpackFrequencyError(const uint32_t *words, double *values, int n);
         
                    void   updateConfig0Shadow(bool read);
                    void   updateConfig1Shadow(bool read);
                    void   updateStatus0Shadow(bool read);
                    void   updateStatus1Shadow(bool read);
                    void   readAll();
+
+                   // Read the four banks (8 KB) in one transaction, or in as few pipelined
+                   // transactions as the maximum access size allows, and decode them into
+                   // the shadows. It returns the time of the snapshot (seconds since epoch,
+                   // in the middle of the read), or 0 if the read failed.
+                   double snapshot();
+                   double getSnapshotTime();
+
+                   // Write the dirty words of the config shadows, coalesced into contiguous
+                   // ranges. It returns the number of write transactions.
+                   int    flush();
+                   int    getDirtyCount();
+
+                   // Same as flush(), but only for the words of the given channels. The
+                   // eta scans use it to write the pending changes of the scanned channels,
+                   // leaving the changes of the other channels pending.
+                   int    flushChannels(const std::bitset<NUM_CHANNELS_C> &channels);
         
                    bool   readReg(uint32_t address, size_t size, uint32_t *reg);
                    bool   writeReg(uint32_t address, size_t size, uint32_t *reg);
-        
+
+                   // Asynchronous transactions. They return right away, with up to
+                   // 'max_in_flight_' transactions outstanding; when the limit is reached,
+                   // the oldest transaction is completed first. The read buffer must stay
+                   // valid until the transaction completes. The optional callback is called,
+                   // with the transaction status, when the transaction completes.
+                   uint32_t reqRead(uint32_t address, size_t size, uint32_t *reg, std::function<void(bool)> callback = nullptr);
+                   uint32_t reqWrite(uint32_t address, size_t size, const uint32_t *reg, std::function<void(bool)> callback = nullptr);
+
+                   // Complete all the outstanding transactions (or up to transaction 'id').
+                   // They return false if any of the completed transactions failed.
+                   bool   waitAll();
+                   bool   waitFor(uint32_t id);
+
+                   void   setMaxInFlight(size_t max_in_flight);
+                   size_t getMaxInFlight();
+
+                   // Dwell time (us) of each point of the eta scans (serial and parallel).
+                   // Each frequency step is written, and completed, and the frequency error
+                   // is read after the dwell time. With a zero dwell time, the step writes and the reads are fully
+                   // pipelined, so a read can see the previous point if the DSP didn't settle.
+                   void     setScanDwell(uint32_t dwell);
+                   uint32_t getScanDwell();
+                   size_t getInFlight();
+        
+                   // The array methods exported to Python (the ones ending with 'Py') take
+                   // and return NumPy arrays. The values are converted directly between the
+                   // arrays' data and the shadow registers.
+
                    // config 0
                    void   setFeedbackEnable(int channel, int enable, bool write);
                    int    getFeedbackEnable(int channel, bool read);
         
                    void   setFeedbackEnableArray(std::vector<int> array, bool write);
+                   void   setFeedbackEnableArray(const int *array, bool write);
                    void   setFeedbackEnableArrayPy(const boost::python::object &iterable, bool write);
         
                    std::vector<int> getFeedbackEnableArray( bool read );
-                   boost::python::list getFeedbackEnableArrayPy( bool read );
+                   void   getFeedbackEnableArray(int *array, bool read);
+                   boost::python::numpy::ndarray getFeedbackEnableArrayPy( bool read );
         
                    void   setCenterFrequencyMHz(int channel, double frequencyMHz, bool write);
                    double getCenterFrequencyMHz(int channel, bool read);
         
                    void   setCenterFrequencyArray(std::vector<double> array, bool write);
+                   void   setCenterFrequencyArray(const double *array, bool write);
                    void   setCenterFrequencyArrayPy(const boost::python::object &iterable, bool write);
         
                    std::vector<double> getCenterFrequencyArray( bool read );
-                   boost::python::list getCenterFrequencyArrayPy( bool read );
+                   void   getCenterFrequencyArray(double *array, bool read);
+                   boost::python::numpy::ndarray getCenterFrequencyArrayPy( bool read );
         
                    void   setAmplitudeScale(int channel, int amplitude, bool write);
                    int    getAmplitudeScale(int channel, bool read);
         
                    void   setAmplitudeScaleArray(std::vector<int> amplitudeScale, bool write);
+                   void   setAmplitudeScaleArray(const int *amplitudeScale, bool write);
                    void   setAmplitudeScaleArrayPy(const boost::python::object &iterable, bool write);
         
                    std::vector<int> getAmplitudeScaleArray( bool read );
-                   boost::python::list getAmplitudeScaleArrayPy( bool read );
+                   void   getAmplitudeScaleArray(int *amplitudeScale, bool read);
+                   boost::python::numpy::ndarray getAmplitudeScaleArrayPy( bool read );
         
                    // config 1
                    void   setEtaPhaseDegree(int chanenl, double etaPhase, bool write);
                    double getEtaPhaseDegree(int channel, bool read);
         
                    void   setEtaPhaseArray(std::vector<double> etaPhase, bool write);
+                   void   setEtaPhaseArray(const double *etaPhase, bool write);
                    void   setEtaPhaseArrayPy(const boost::python::object &iterable, bool write);
         
                    std::vector<double> getEtaPhaseArray( bool read );
-                   boost::python::list getEtaPhaseArrayPy( bool read );
+                   void   getEtaPhaseArray(double *etaPhase, bool read);
+                   boost::python::numpy::ndarray getEtaPhaseArrayPy( bool read );
         
                    void   setEtaMagScaled(int channel, double etaMag, bool write);
                    double getEtaMagScaled(int channel, bool read);
         
                    void   setEtaMagArray(std::vector<double> etaMag, bool write);
+                   void   setEtaMagArray(const double *etaMag, bool write);
                    void   setEtaMagArrayPy(const boost::python::object &iterable, bool write);
         
                    std::vector<double> getEtaMagArray( bool read );
-                   boost::python::list getEtaMagArrayPy( bool read );
+                   void   getEtaMagArray(double *etaMag, bool read);
+                   boost::python::numpy::ndarray getEtaMagArrayPy( bool read );
         
                    // status
                    int    getAmplitudeReadback(int channel, bool read);
@@ -193,21 +365,45 @@ namespace smurf {
                    double getLoopFilterOutput(int channel, bool read);
         
                    std::vector<double> getLoopFilterOutputArray( bool read );
-                   boost::python::list getLoopFilterOutputArrayPy( bool read );
+                   void   getLoopFilterOutputArray(double *array, bool read);
+                   boost::python::numpy::ndarray getLoopFilterOutputArrayPy( bool read );
         
                    double getFrequencyErrorMHz(int channel, bool read);
                    std::vector<double> getFrequencyErrorArray( bool read );
-                   boost::python::list getFrequencyErrorArrayPy( bool read );
+                   void   getFrequencyErrorArray(double *array, bool read);
+                   boost::python::numpy::ndarray getFrequencyErrorArrayPy( bool read );
         
                    void regReadTest(int nloops);
         
                    std::vector<double> getResultsReal();
-                   boost::python::list getResultsRealPy();
+                   boost::python::numpy::ndarray getResultsRealPy();
                    std::vector<double> getResultsImag();
-                   boost::python::list getResultsImagPy();
+                   boost::python::numpy::ndarray getResultsImagPy();
         
                    void runEtaScan(std::vector<int> channels, int amplitude, std::vector<double> frequencies);
                    void runEtaScanPy(const boost::python::object &channelspy, int amplitude, const boost::python::object &iterable);
+
+                   // Same as runEtaScan, but all the channels are scanned at the same time, with one
+                   // bulk config1 write and one bulk status1 read per frequency step. The results have
+                   // the same layout as with runEtaScan.
+                   void runEtaScanParallel(std::vector<int> channels, int amplitude, std::vector<double> frequencies);
+                   void runEtaScanParallelPy(const boost::python::object &channelspy, int amplitude, const boost::python::object &iterable);
+
+                   // Estimate the eta parameters of the channels of the last eta scan, from its
+                   // results. For each channel, the resonance center is the frequency offset
+                   // (MHz) of the minimum of the response, and eta is the inverse of the slope
+                   // of a least-squares line fitted to the response over +/- 'deltaFrequency'
+                   // (MHz) around it. If 'apply' is set, the eta phase and magnitude are set in
+                   // the config0 shadow, and with 'write' they are written in one bulk write.
+                   // Magnitudes above the register range (about 32) are clamped to it.
+                   void estimateEta(double deltaFrequency, bool apply, bool write);
+
+                   std::vector<double> getEtaPhaseEstimate();
+                   boost::python::numpy::ndarray getEtaPhaseEstimatePy();
+                   std::vector<double> getEtaMagEstimate();
+                   boost::python::numpy::ndarray getEtaMagEstimatePy();
+                   std::vector<double> getEtaCenterEstimate();
+                   boost::python::numpy::ndarray getEtaCenterEstimatePy();
         
                    static void setup_python() {
                        boost::python::class_<SysgenCryo,    std::shared_ptr<SysgenCryo>,
@@ -244,6 +440,20 @@ namespace smurf {
                            .def("getResultsReal",           &SysgenCryo::getResultsRealPy)
                            .def("getResultsImag",           &SysgenCryo::getResultsImagPy)
                            .def("runEtaScan",               &SysgenCryo::runEtaScanPy)
+                           .def("runEtaScanParallel",       &SysgenCryo::runEtaScanParallelPy)
+                           .def("estimateEta",              &SysgenCryo::estimateEta)
+                           .def("getEtaPhaseEstimate",      &SysgenCryo::getEtaPhaseEstimatePy)
+                           .def("getEtaMagEstimate",        &SysgenCryo::getEtaMagEstimatePy)
+                           .def("getEtaCenterEstimate",     &SysgenCryo::getEtaCenterEstimatePy)
+                           .def("readAll",                  &SysgenCryo::readAll)
+                           .def("snapshot",                 &SysgenCryo::snapshot)
+                           .def("getSnapshotTime",          &SysgenCryo::getSnapshotTime)
+                           .def("flush",                    &SysgenCryo::flush)
+                           .def("getDirtyCount",            &SysgenCryo::getDirtyCount)
+                           .def("setMaxInFlight",           &SysgenCryo::setMaxInFlight)
+                           .def("getMaxInFlight",           &SysgenCryo::getMaxInFlight)
+                           .def("setScanDwell",             &SysgenCryo::setScanDwell)
+                           .def("getScanDwell",             &SysgenCryo::getScanDwell)
                            .def("regReadTest",  &SysgenCryo::regReadTest)
                            ;
                        boost::python::implicitly_convertible<std::shared_ptr<SysgenCryo>, rogue::interfaces::memory::MasterPtr>();
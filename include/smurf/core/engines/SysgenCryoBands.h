@@ -0,0 +1,133 @@
+#ifndef _SMURF_CORE_ENGINES_SYSGENCRYOBANDS_H_
+#define _SMURF_CORE_ENGINES_SYSGENCRYOBANDS_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF SysgenCryo Bands
+ * ----------------------------------------------------------------------------
+ * File          : SysgenCryoBands.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF SysgenCryo Bands Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+#include <rogue/interfaces/memory/Slave.h>
+#include <rogue/GilRelease.h>
+#include <rogue/Logging.h>
+#include "smurf/core/engines/SysgenCryo.h"
+
+namespace bp  = boost::python;
+namespace rim = rogue::interfaces::memory;
+
+namespace smurf
+{
+    namespace core
+    {
+        namespace engines
+        {
+            class SysgenCryoBands;
+            typedef std::shared_ptr<SysgenCryoBands> SysgenCryoBandsPtr;
+
+            // This class manages one SysgenCryo engine per band. Each engine has its own
+            // shadow registers and address offset ('baseOffset' + band * 'bandStride'),
+            // and its own worker thread, so operations on different bands run concurrently
+            // on the memory bus. Operations on the same band run in order.
+            //
+            // The band engines are not thread safe, so they are only accessed while holding
+            // the mutex of their band: the workers hold it while running an operation, and
+            // run() holds it while running a function on the band engine in the calling
+            // thread (to set its arrays with write = false, or to read its results).
+            //
+            // On destruction, the running operations complete and the ones still queued
+            // are cancelled.
+            class SysgenCryoBands
+            {
+            public:
+                SysgenCryoBands(std::size_t numBands, uint32_t baseOffset, uint32_t bandStride);
+                ~SysgenCryoBands();
+
+                static SysgenCryoBandsPtr create(std::size_t numBands, uint32_t baseOffset, uint32_t bandStride);
+
+                static void setup_python();
+
+                // Get the number of bands
+                const std::size_t getNumBands() const;
+
+                // Run a function on the engine of a band, in the calling thread. It blocks until
+                // the operation running on the band, if any, is done. The engine must not be
+                // used after the function returns. The python version returns the value
+                // returned by the function.
+                void       run(std::size_t band, std::function<void(SysgenCryo&)> fn);
+                bp::object runPy(std::size_t band, bp::object fn);
+
+                // Connect all the band engines to a memory slave
+                void setSlave(rim::SlavePtr slave);
+
+                // Queue an operation on a band. It returns right away.
+                void submit(std::size_t band, std::function<void(SysgenCryo&)> job);
+
+                // Wait until all the queued operations are done
+                void wait();
+
+                // Get the number of queued operations, including the ones running
+                const std::size_t getPending() const;
+
+                // Take a snapshot of all the bands, concurrently. It blocks until all
+                // the snapshots are done.
+                void readAll();
+
+                // Write the modified words of all the bands, concurrently. It blocks
+                // until all the writes are done.
+                void flush();
+
+                // Queue an eta scan on a band. They return right away; call wait()
+                // and then read the results from the band engine.
+                void startEtaScan(std::size_t band, std::vector<int> channels, int amplitude, std::vector<double> frequencies);
+                void startEtaScanPy(std::size_t band, const bp::object& channels, int amplitude, const bp::object& frequencies);
+                void startEtaScanParallel(std::size_t band, std::vector<int> channels, int amplitude, std::vector<double> frequencies);
+                void startEtaScanParallelPy(std::size_t band, const bp::object& channels, int amplitude, const bp::object& frequencies);
+
+            private:
+                // Worker thread of a band
+                void runWorker(std::size_t band);
+
+                // Operations queued on a band
+                struct Worker
+                {
+                    std::deque< std::function<void(SysgenCryo&)> > jobs;   // Queued operations
+                    std::thread                                     thread; // Worker thread
+                    std::mutex                                      mutex;  // Mutex to access the band engine
+                };
+
+                std::vector<SysgenCryoPtr>           bands;      // Band engines
+                std::vector<Worker>                  workers;    // Band workers
+                std::size_t                          pending;    // Number of queued operations
+                bool                                 runWorkers; // Flag used to stop the workers
+                mutable std::mutex                   jobMutex;   // Mutex to access the queues
+                std::condition_variable              jobCV;      // Variable to notify the workers there are new operations
+                std::condition_variable              doneCV;     // Variable to notify an operation is done
+
+                // Logger
+                std::shared_ptr<rogue::Logging> eLog_;
+            };
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef _SMURF_CORE_ENGINES_SYSGENCRYOPOLLER_H_
+#define _SMURF_CORE_ENGINES_SYSGENCRYOPOLLER_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF SysgenCryo Poller
+ * ----------------------------------------------------------------------------
+ * File          : SysgenCryoPoller.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF SysgenCryo Poller Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#include <rogue/interfaces/memory/Master.h>
+#include <rogue/GilRelease.h>
+#include <rogue/Logging.h>
+#include "smurf/core/engines/SysgenCryo.h"
+
+namespace bp  = boost::python;
+namespace rim = rogue::interfaces::memory;
+
+namespace smurf
+{
+    namespace core
+    {
+        namespace engines
+        {
+            class SysgenCryoPoller;
+            typedef std::shared_ptr<SysgenCryoPoller> SysgenCryoPollerPtr;
+
+            // This class reads the status0 and status1 banks of a band periodically, from
+            // its own thread, and keeps the decoded loop filter outputs and frequency errors
+            // in a ring buffer holding the last 'depth' polls, with their timestamps.
+            //
+            // It is a memory master on its own, so it is connected to the same memory slave
+            // as the SysgenCryo engine of the band, and it polls without interfering with the
+            // engine's transactions. The buffered values are read without any bus access.
+            //
+            // The timestamps are the midpoint of each read, in seconds since the epoch,
+            // like the SysgenCryo snapshot times.
+            class SysgenCryoPoller : public rim::Master
+            {
+            public:
+                SysgenCryoPoller();
+                ~SysgenCryoPoller();
+
+                static SysgenCryoPollerPtr create();
+
+                static void setup_python();
+
+                // Set/Get the address offset of the band
+                void           setOffset(uint32_t offset);
+                const uint32_t getOffset() const;
+
+                // Enable/Disable the polling
+                void       setEnable(bool e);
+                const bool getEnable() const;
+
+                // Set/Get the polling rate (polls per second)
+                void         setRate(double r);
+                const double getRate() const;
+
+                // Set/Get the ring buffer depth (polls). Changing it clears the buffer.
+                void              setDepth(std::size_t d);
+                const std::size_t getDepth() const;
+
+                // Get the number of polls in the ring buffer
+                const std::size_t getCount() const;
+
+                // Get the number of polls, and of failed polls
+                const std::size_t getPollCnt() const;
+                const std::size_t getErrorCnt() const;
+
+                // Get the timestamp of the latest poll. Zero if the buffer is empty.
+                const double getLatestTime() const;
+
+                // Get the latest poll, as a tuple (time, loopFilterOutput[512], frequencyError[512])
+                bp::tuple getLatestPy() const;
+
+                // Get the polls with timestamps in [t0, t1], oldest first, as a tuple
+                // (time[T], loopFilterOutput[T][512], frequencyError[T][512])
+                bp::tuple getRangePy(double t0, double t1) const;
+
+                // Clear the ring buffer and the counters
+                void clear();
+
+            private:
+                // Register space layout
+                static const std::size_t numChannels  = 512;    // Number of channels
+                static const uint32_t    statusOffset = 0x1000; // Offset of the status0 bank (status1 follows it)
+                static const uint32_t    statusSize   = 0x1000; // Size of the status0 and status1 banks (bytes)
+
+                // Read the status banks once, and add them to the ring buffer
+                void poll();
+
+                // Thread which polls the status banks
+                void runThread();
+
+                uint32_t                  offset;    // Address offset of the band
+                bool                      enable;    // Enable flag
+                double                    rate;      // Polling rate
+                std::vector<uint32_t>     raw;       // Raw status words. Only used by the thread.
+
+                // Ring buffer
+                std::size_t               depth;     // Number of polls
+                std::size_t               head;      // Index of the next poll
+                std::size_t               count;     // Number of polls in the buffer
+                std::vector<double>       times;     // Timestamps, by poll
+                std::vector<double>       lfo;       // Loop filter outputs, by poll and channel
+                std::vector<double>       ferr;      // Frequency errors (MHz), by poll and channel
+                mutable std::mutex        mtx;       // Mutex to access all the variables
+                std::condition_variable   cv;        // Variable to wake up the thread when the parameters change
+
+                // Counters
+                std::atomic<std::size_t>  pollCnt;   // Number of polls
+                std::atomic<std::size_t>  errorCnt;  // Number of failed polls
+
+                // Poller thread
+                bool                      runTx;     // Flag used to stop the thread
+                std::thread               txThread;  // Thread which polls the status banks
+
+                // Logger
+                std::shared_ptr<rogue::Logging> eLog_;
+            };
+        }
+    }
+}
+
+#endif
@@ -34,6 +34,10 @@
 #include <rogue/interfaces/stream/Master.h>
 #include <rogue/GilRelease.h>
 #include "smurf/core/common/SmurfHeader.h"
+#include "smurf/core/common/MetricsRegistry.h"
+#include "smurf/core/common/TraceRecorder.h"
+#include "smurf/core/common/PerfCounters.h"
+#include "smurf/core/common/LogLimiter.h"
 #include "smurf/core/common/Helpers.h"
 
 namespace bp  = boost::python;
@@ -52,7 +56,7 @@ namespace smurf
             {
             public:
                 SmurfProcessor();
-                ~SmurfProcessor() {};
+                ~SmurfProcessor();
 
                 static SmurfProcessorPtr create();
 
@@ -92,6 +96,32 @@ namespace smurf
                 const std::size_t   getFactor() const;              // Get the downsampling factor
                 void                resetDownsampler();             // Reset the downsampler.
 
+                //** COUNTER METHODS **//
+                const std::size_t   getFrameCnt() const;            // Get the number of received frames
+                const std::size_t   getBadFrameCnt() const;         // Get the number of dropped bad frames
+                const std::size_t   getTxFrameCnt() const;          // Get the number of sent frames
+                const std::size_t   getSuppressedLogCnt() const;    // Get the number of rate limited log messages
+                void                clearCnt();                     // Clear all counters
+
+                //** PERFORMANCE COUNTER METHODS **//
+                void                setPerfEnable(bool e);          // Enable the hardware performance counters
+                const bool          getPerfEnable() const;
+                const int           getPerfStatus() const;          // Get the status (see PerfCounters::Status)
+                const bp::list      getPerfStageNames() const;      // Get the names of the measured stages
+                const bp::list      getPerfEventNames() const;      // Get the names of the measured events
+                const bp::list      getPerfEventAvailable() const;  // Get which events are being measured
+                const uint64_t      getPerfCalls(std::size_t s) const;              // Get the number of measurements of a stage
+                const uint64_t      getPerfCount(std::size_t s, std::size_t e) const; // Get the number of events of a stage
+                const bp::dict      getPerfStats() const;           // Get all the measurements, by stage
+                void                clearPerf();                    // Clear the measurements
+
+                // Register the counters in the metrics registry,
+                // labeled with the block name 'name'.
+                void                registerMetrics(const std::string& name);
+
+                // Set the block names used in the trace recorder: 'name' for the
+                // frame processing, and 'name'.Tx for the frame transmission.
+                void                setTraceName(const std::string& name);
 
                 // Accept new frames
                 void acceptFrame(ris::FramePtr frame);
@@ -140,6 +170,18 @@ namespace smurf
                 bool                     disableDownsampler;    // Disable flag for the downsampler
                 std::size_t              factor;                // Downsample factor
                 std::size_t              sampleCnt;             // Sample counter
+                // Counters
+                std::atomic<std::size_t> frameCnt;              // Number of received frames
+                std::atomic<std::size_t> badFrameCnt;           // Number of dropped bad frames
+                std::atomic<std::size_t> txFrameCnt;            // Number of sent frames
+                // Trace recorder block IDs
+                uint16_t                 traceId;               // Frame processing
+                uint16_t                 txTraceId;             // Frame transmission
+                // Hardware performance counters. The Tx stage runs on a
+                // different thread, so it uses its own counters.
+                enum PerfStage { PerfUnwrap, PerfFilter, PerfDownsample, NumPerfStages };
+                PerfCounters             perf;                  // Unwrap, filter and downsample stages
+                PerfCounters             txPerf;                // Tx stage
                 // Transmit thread
                 std::vector<uint8_t>     headerCopy;            // A copy of header to be send
                 bool                     txDataReady;           // Flag to indicate new data is ready t be sent
@@ -155,6 +197,11 @@ namespace smurf
                 // Logger
                 std::shared_ptr<rogue::Logging> eLog_;
 
+                // Rate limiters for the messages logged on bad frames
+                LogLimiter               logBadFlags;
+                LogLimiter               logBadSize;
+                LogLimiter               logBadNumCh;
+
 
             };
         }
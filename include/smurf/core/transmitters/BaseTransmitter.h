@@ -29,6 +29,7 @@
 #include <rogue/GilRelease.h>
 #include "smurf/core/common/SmurfHeader.h"
 #include "smurf/core/common/SmurfPacket.h"
+#include "smurf/core/common/MetricsRegistry.h"
 #include "smurf/core/transmitters/DualDataBuffer.h"
 #include "smurf/core/transmitters/BaseTransmitterChannel.h"
 
@@ -48,7 +49,7 @@ namespace smurf
             {
             public:
                 BaseTransmitter();
-                virtual ~BaseTransmitter() {};
+                virtual ~BaseTransmitter();
 
                 static BaseTransmitterPtr create();
 
@@ -74,6 +75,10 @@ namespace smurf
                 // Get the metadata dropped counter
                 const std::size_t getMetaDropCnt() const;
 
+                // Register the counters in the metrics registry,
+                // labeled with the block name 'name'.
+                void registerMetrics(const std::string& name);
+
                 // Accept new data frames
                 void acceptDataFrame(ris::FramePtr frame);
 
@@ -76,7 +76,7 @@ namespace smurf
                 DualDataBuffer(const DualDataBuffer&);
                 DualDataBuffer& operator=(const DualDataBuffer&);
 
-                std::size_t             dropCnt;      // Dropped element counter
+                std::atomic<std::size_t> dropCnt;     // Dropped element counter
                 std::vector<T>          buffer;       // Dual buffers. Can hold two elements
                 std::size_t             readIndex;    // Buffer position to be read
                 std::size_t             writeIndex;   // Buffer position to be written
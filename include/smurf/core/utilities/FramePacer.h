@@ -0,0 +1,151 @@
+#ifndef _SMURF_CORE_UTILITIES_FRAMEPACER_H_
+#define _SMURF_CORE_UTILITIES_FRAMEPACER_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Frame Pacer
+ * ----------------------------------------------------------------------------
+ * File          : FramePacer.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Frame Pacer Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <rogue/interfaces/stream/Frame.h>
+#include <rogue/interfaces/stream/Slave.h>
+#include <rogue/interfaces/stream/Master.h>
+#include <rogue/GilRelease.h>
+#include <rogue/Logging.h>
+#include "smurf/core/common/MetricsRegistry.h"
+#include "smurf/core/common/Helpers.h"
+
+namespace bp  = boost::python;
+namespace ris = rogue::interfaces::stream;
+
+namespace smurf
+{
+    namespace core
+    {
+        namespace utilities
+        {
+            class FramePacer;
+            typedef std::shared_ptr<FramePacer> FramePacerPtr;
+
+            // This class holds the incoming frames in a bounded queue, and releases them to the
+            // next slave from its own thread, following a token bucket schedule: tokens are added
+            // at a rate of 'rate' per second, up to 'burst' tokens, and each released frame takes
+            // one token. Frames arriving when the queue is full are dropped.
+            class FramePacer : public ris::Slave, public ris::Master
+            {
+            public:
+                FramePacer();
+                ~FramePacer();
+
+                static FramePacerPtr create();
+
+                static void setup_python();
+
+                // Disable the processing block. The data
+                // will just pass through to the next slave
+                void       setDisable(bool d);
+                const bool getDisable() const;
+
+                // Set/Get the release rate (frames per second). Zero means no rate limit.
+                void         setRate(double r);
+                const double getRate() const;
+
+                // Set/Get the token bucket size (frames)
+                void              setBurst(std::size_t b);
+                const std::size_t getBurst() const;
+
+                // Set/Get the queue depth (frames)
+                void              setDepth(std::size_t d);
+                const std::size_t getDepth() const;
+
+                // Get the current number of frames in the queue
+                const std::size_t getQueueCnt() const;
+
+                // Get the maximum number of frames in the queue
+                const std::size_t getMaxQueueCnt() const;
+
+                // Get the number of released frames
+                const std::size_t getTxCnt() const;
+
+                // Get the number of dropped frames
+                const std::size_t getDropCnt() const;
+
+                // Get the number of frames which were not released as soon as they arrived
+                const std::size_t getDelayCnt() const;
+
+                // Get the average and maximum time (in ns) the frames were held in the queue
+                const double   getAvgDelay() const;
+                const uint64_t getMaxDelay() const;
+
+                // Clear all counter.
+                void clearCnt();
+
+                // Register the counters in the metrics registry,
+                // labeled with the block name 'name'.
+                void registerMetrics(const std::string& name);
+
+                // Accept new frames
+                void acceptFrame(ris::FramePtr frame);
+
+            private:
+                // Resize the queue. It must be called holding the queue mutex.
+                void resizeQueue(std::size_t d);
+
+                // Thread which releases the frames
+                void runThread();
+
+                bool                       disable;     // Disable flag
+                double                     rate;        // Release rate
+                std::size_t                burst;       // Token bucket size
+                double                     tokens;      // Current number of tokens
+                uint64_t                   lastRefill;  // Time the tokens were last refilled
+
+                // Queue, implemented as a fixed-size ring buffer
+                std::vector<ris::FramePtr> queue;       // Frames
+                std::vector<uint64_t>      arrival;     // Arrival time of each frame
+                std::vector<bool>          delayed;     // Flag to indicate the frame was delayed
+                std::size_t                head;        // Index of the oldest frame in the queue
+                std::size_t                count;       // Number of frames in the queue
+                std::atomic<std::size_t>   depth;       // Size of the queue, readable without the mutex
+                std::mutex                 queueMutex;  // Mutex to access the queue
+                std::condition_variable    queueCV;     // Variable to notify the thread there are new frames
+
+                // Counters
+                std::atomic<std::size_t>   queueCnt;    // Number of frames in the queue
+                std::atomic<std::size_t>   maxQueueCnt; // Maximum number of frames in the queue
+                std::atomic<std::size_t>   txCnt;       // Number of released frames
+                std::atomic<std::size_t>   dropCnt;     // Number of dropped frames
+                std::atomic<std::size_t>   delayCnt;    // Number of delayed frames
+                std::atomic<uint64_t>      totalDelay;  // Accumulated delay (ns)
+                std::atomic<uint64_t>      maxDelay;    // Maximum delay (ns)
+
+                // Release thread
+                std::atomic<bool>          runTx;       // Flag used to stop the thread
+                std::thread                txThread;    // Thread to send the frames to the next slave
+
+                // Logger
+                std::shared_ptr<rogue::Logging> eLog_;
+            };
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef _SMURF_CORE_UTILITIES_METRICSSERVER_H_
+#define _SMURF_CORE_UTILITIES_METRICSSERVER_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Metrics Server
+ * ----------------------------------------------------------------------------
+ * File          : MetricsServer.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Metrics Server Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <boost/python.hpp>
+#include <rogue/GilRelease.h>
+#include <rogue/Logging.h>
+#include "smurf/core/common/MetricsRegistry.h"
+
+namespace bp  = boost::python;
+
+namespace smurf
+{
+    namespace core
+    {
+        namespace utilities
+        {
+            class MetricsServer;
+            typedef std::shared_ptr<MetricsServer> MetricsServerPtr;
+
+            // This class serves the metrics in the MetricsRegistry over HTTP, in the Prometheus
+            // text format, on the local interface (127.0.0.1). Only 'GET /metrics' requests are
+            // served. The requests are served one at a time, from the server's own thread.
+            class MetricsServer
+            {
+            public:
+                MetricsServer();
+                ~MetricsServer();
+
+                static MetricsServerPtr create();
+
+                static void setup_python();
+
+                // Enable/Disable the server
+                void       setEnable(bool e);
+                const bool getEnable() const;
+
+                // Set/Get the TCP port. If the server is running, it is restarted on the new port.
+                void      setPort(int p);
+                const int getPort() const;
+
+                // Get the number of served scrapes
+                const std::size_t getScrapeCnt() const;
+
+                // Get the number of failed or rejected requests
+                const std::size_t getErrorCnt() const;
+
+                // Get the number of registered metrics
+                const std::size_t getMetricCnt() const;
+
+                // Get the metrics, in the same format they are served
+                const std::string getMetrics() const;
+
+                // Clear all counter.
+                void clearCnt();
+
+            private:
+                // Start/Stop the server. They must be called holding the control mutex.
+                bool start();
+                void stop();
+
+                // Thread which accepts the connections
+                void runThread();
+
+                // Serve a connection
+                void serve(int fd);
+
+                // Send a response
+                bool sendResponse(int fd, const std::string& status, const std::string& body);
+
+                // Timeouts (ms)
+                static const int acceptTimeout  = 100;  // Polling period to check if the thread must stop
+                static const int requestTimeout = 1000; // Maximum time to receive a request
+                static const int sendTimeout    = 1000; // Maximum time blocked sending the response
+
+                // Maximum request size
+                static const std::size_t maxRequestSize = 8192;
+
+                std::atomic<bool>        enable;     // Enable flag
+                std::atomic<int>         port;       // TCP port
+                int                      sockFd;     // Listening socket
+                std::mutex               ctrlMutex;  // Mutex to start/stop the server
+
+                // Counters
+                std::atomic<std::size_t> scrapeCnt;  // Number of served scrapes
+                std::atomic<std::size_t> errorCnt;   // Number of failed requests
+
+                // Server thread
+                std::atomic<bool>        runServer;  // Flag used to stop the thread
+                std::thread              thread;     // Thread which accepts the connections
+
+                // Logger
+                std::shared_ptr<rogue::Logging> eLog_;
+            };
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef _SMURF_CORE_UTILITIES_TRACER_H_
+#define _SMURF_CORE_UTILITIES_TRACER_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Tracer
+ * ----------------------------------------------------------------------------
+ * File          : Tracer.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Tracer Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <boost/python.hpp>
+#include <rogue/GilRelease.h>
+#include "smurf/core/common/TraceRecorder.h"
+
+namespace bp  = boost::python;
+
+namespace smurf
+{
+    namespace core
+    {
+        namespace utilities
+        {
+            class Tracer;
+            typedef std::shared_ptr<Tracer> TracerPtr;
+
+            // This class gives access to the process-wide TraceRecorder from python:
+            // it enables the recording of the time spent by the processing blocks on
+            // each frame, and dumps the recorded events in the Chrome trace format.
+            class Tracer
+            {
+            public:
+                Tracer() {};
+                ~Tracer() {};
+
+                static TracerPtr create();
+
+                static void setup_python();
+
+                // Enable/Disable the recording
+                void       setEnable(bool e);
+                const bool getEnable() const;
+
+                // Get the number of events recorded since the last clear
+                const uint64_t getEventCnt() const;
+
+                // Get the number of events the ring buffer can hold
+                const std::size_t getCapacity() const;
+
+                // Discard all the recorded events
+                void clear();
+
+                // Write the recorded events to a file. It returns 'false' if it fails.
+                bool dump(const std::string& fileName) const;
+
+                // Get the recorded events, as a JSON string
+                const std::string getJson() const;
+            };
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef _SMURF_CORE_UTILITIES_MODULE_H_
+#define _SMURF_CORE_UTILITIES_MODULE_H_
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : Python Module
+ * ----------------------------------------------------------------------------
+ * File       : module.h
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Python module setup
+ * ----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+namespace smurf
+{
+    namespace core
+    {
+        namespace utilities
+        {
+            void setup_module();
+        }
+    }
+}
+
+#endif
@@ -38,10 +38,28 @@ class Header2Smurf(pyrogue.Device):
             localSet=lambda value: self._header2smurf.setDisable(value),
             localGet=self._header2smurf.getDisable))
 
+    def _start(self):
+        """
+        Names the block in the trace recorder, using the device path.
+        """
+        pyrogue.Device._start(self)
+        self.setTraceName(self.path)
+
+    # Method to name the block in the trace recorder
+    def setTraceName(self, name):
+        self._header2smurf.setTraceName(name)
+
     # Method to set TES Bias values
     def setTesBias(self, index, value):
         self._header2smurf.setTesBias(index, value)
 
+    # Methods to get and clear the number of suppressed log messages
+    def getSuppressedLogCnt(self):
+        return self._header2smurf.getSuppressedLogCnt()
+
+    def clearSuppressedLogCnt(self):
+        self._header2smurf.clearSuppressedLogCnt()
+
     # Method called by streamConnect, streamTap and streamConnectBiDir to access slave
     def _getStreamSlave(self):
         return self._header2smurf
@@ -21,6 +21,86 @@ import pyrogue
 
 import smurf
 
+class FrameSourceStatistics(pyrogue.Device):
+    """
+    SMuRF Frame Statistics of one source (ATCA crate and slot), when
+    streams from several sources are merged.
+    """
+    def __init__(self, name, stats, index, **kwargs):
+        pyrogue.Device.__init__(self, name=name, description=f'SMuRF Frame Statistics, source {index}', **kwargs)
+
+        self.add(pyrogue.LocalVariable(
+            name='Active',
+            description='The source has been received',
+            mode='RO',
+            value=False,
+            pollInterval=1,
+            localGet=lambda: index < stats.getSourceCnt()))
+
+        self.add(pyrogue.LocalVariable(
+            name='CrateId',
+            description='ATCA crate ID',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=lambda: stats.getSourceCrateId(index)))
+
+        self.add(pyrogue.LocalVariable(
+            name='SlotNumber',
+            description='ATCA slot number',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=lambda: stats.getSourceSlotNumber(index)))
+
+        self.add(pyrogue.LocalVariable(
+            name='FrameCnt',
+            description='Frame counter',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=lambda: stats.getSourceFrameCnt(index)))
+
+        self.add(pyrogue.LocalVariable(
+            name='FrameLossCnt',
+            description='Number of lost frames',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=lambda: stats.getSourceFrameLossCnt(index)))
+
+        self.add(pyrogue.LocalVariable(
+            name='FrameOutOrderCnt',
+            description='Number of time we have received out-of-order frames',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=lambda: stats.getSourceFrameOutOrderCnt(index)))
+
+        self.add(pyrogue.LocalVariable(
+            name='ResyncCnt',
+            description='Number of times the frame counter jumped back (counter reset or wrap), and the frame checks started over',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=lambda: stats.getSourceResyncCnt(index)))
+
+        self.add(pyrogue.LocalVariable(
+            name='FrameRate',
+            description='Frame rate, measured over the last 100ms (frames/s)',
+            mode='RO',
+            value=0.0,
+            pollInterval=1,
+            localGet=lambda: stats.getSourceFrameRate(index)))
+
+        self.add(pyrogue.LocalVariable(
+            name='ByteRate',
+            description='Data rate, measured over the last 100ms (bytes/s)',
+            mode='RO',
+            value=0.0,
+            pollInterval=1,
+            localGet=lambda: stats.getSourceByteRate(index)))
+
 class FrameStatistics(pyrogue.Device):
     """
     SMuRF Frame Statistics Python Wrapper.
@@ -83,12 +163,233 @@ class FrameStatistics(pyrogue.Device):
             pollInterval=1,
             localGet=self._FrameStatistics.getBadFrameCnt))
 
+        # Add the resync counter variable
+        self.add(pyrogue.LocalVariable(
+            name='ResyncCnt',
+            description='Number of times the frame counter jumped back (counter reset or wrap), and the frame checks started over',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._FrameStatistics.getResyncCnt))
+
+        self.add(pyrogue.LocalVariable(
+            name='SuppressedLogCnt',
+            description='Number of bad frame log messages suppressed by the rate limiters',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._FrameStatistics.getSuppressedLogCnt))
+
+        # Add the frame and data rate variables
+        for unit, get, getAvg, getPeak in [
+                ('Frame', self._FrameStatistics.getFrameRate, self._FrameStatistics.getFrameRateAvg, self._FrameStatistics.getPeakFrameRate),
+                ('Byte',  self._FrameStatistics.getByteRate,  self._FrameStatistics.getByteRateAvg,  self._FrameStatistics.getPeakByteRate)]:
+
+            self.add(pyrogue.LocalVariable(
+                name=f'{unit}Rate',
+                description=f'{unit} rate, measured over the last 100ms ({unit.lower()}s/s)',
+                mode='RO',
+                value=0.0,
+                pollInterval=1,
+                localGet=get))
+
+            for i, w in enumerate(['1s', '10s', '60s']):
+                self.add(pyrogue.LocalVariable(
+                    name=f'{unit}Rate{w}',
+                    description=f'{unit} rate, exponentially weighted moving average over {w} ({unit.lower()}s/s)',
+                    mode='RO',
+                    value=0.0,
+                    pollInterval=1,
+                    localGet=lambda i=i, getAvg=getAvg: getAvg(i)))
+
+            self.add(pyrogue.LocalVariable(
+                name=f'Peak{unit}Rate',
+                description=f'Peak {unit.lower()} rate, measured over 100ms ({unit.lower()}s/s)',
+                mode='RO',
+                value=0.0,
+                pollInterval=1,
+                localGet=getPeak))
+
+        # Add the inter-arrival time variables
+        self.add(pyrogue.LocalVariable(
+            name='InterArrivalMin',
+            description='Minimum time between consecutive frames (ns)',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._FrameStatistics.getInterArrivalMin))
+
+        self.add(pyrogue.LocalVariable(
+            name='InterArrivalMax',
+            description='Maximum time between consecutive frames (ns)',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._FrameStatistics.getInterArrivalMax))
+
+        self.add(pyrogue.LocalVariable(
+            name='InterArrivalMean',
+            description='Mean time between consecutive frames (ns)',
+            mode='RO',
+            value=0.0,
+            pollInterval=1,
+            localGet=self._FrameStatistics.getInterArrivalMean))
+
+        for p, n in [(1.0, 'P1'), (50.0, 'P50'), (99.0, 'P99'), (99.9, 'P999')]:
+            self.add(pyrogue.LocalVariable(
+                name=f'InterArrival{n}',
+                description=f'Time between consecutive frames at the {p} percentile (ns)',
+                mode='RO',
+                value=0,
+                pollInterval=1,
+                localGet=lambda p=p: self._FrameStatistics.getInterArrivalPercentile(p)))
+
+        # Add the reorder window variables
+        self.add(pyrogue.LocalVariable(
+            name='ReorderDepth',
+            description='Depth of the reorder window (frames). Out-of-order frames within the window are released in order. Set to zero to disable it, and drop out-of-order frames.',
+            mode='RW',
+            value=0,
+            localSet=lambda value: self._FrameStatistics.setReorderDepth(value),
+            localGet=self._FrameStatistics.getReorderDepth))
+
+        self.add(pyrogue.LocalVariable(
+            name='ReorderTimeout',
+            description='Maximum time to wait for a missing frame, before releasing the frames held after it (us).',
+            mode='RW',
+            value=10000,
+            localSet=lambda value: self._FrameStatistics.setReorderTimeout(value),
+            localGet=self._FrameStatistics.getReorderTimeout))
+
+        for n, d, get in [
+                ('ReorderCnt',         'Number of frames held because they arrived ahead of a missing frame', self._FrameStatistics.getReorderCnt),
+                ('ReorderLateCnt',     'Number of frames arrived after their position was released',          self._FrameStatistics.getReorderLateCnt),
+                ('ReorderTimeoutCnt',  'Number of missing frames skipped because of the timeout',             self._FrameStatistics.getReorderTimeoutCnt),
+                ('ReorderOverflowCnt', 'Number of missing frames skipped because the window was full',        self._FrameStatistics.getReorderOverflowCnt)]:
+            self.add(pyrogue.LocalVariable(
+                name=n,
+                description=d,
+                mode='RO',
+                value=0,
+                pollInterval=1,
+                localGet=get))
+
+        # Add the timing check variables
+        self.add(pyrogue.LocalVariable(
+            name='ExpectedPeriod',
+            description='Expected counter2 increment between consecutive frames. Set to zero to learn it from the incoming frames.',
+            mode='RW',
+            value=0,
+            localSet=lambda value: self._FrameStatistics.setExpectedPeriod(value),
+            localGet=self._FrameStatistics.getExpectedPeriod))
+
+        self.add(pyrogue.LocalVariable(
+            name='Period',
+            description='Counter2 increment used as reference (the expected one, or the learned one)',
+            mode='RO',
+            value=0.0,
+            pollInterval=1,
+            localGet=self._FrameStatistics.getPeriod))
+
+        self.add(pyrogue.LocalVariable(
+            name='JitterTolerance',
+            description='Maximum deviation of the counter2 increment, before it is counted as an anomaly. Set to zero to disable.',
+            mode='RW',
+            value=0,
+            localSet=lambda value: self._FrameStatistics.setJitterTolerance(value),
+            localGet=self._FrameStatistics.getJitterTolerance))
+
+        self.add(pyrogue.LocalVariable(
+            name='FramesPerMarker',
+            description='Expected number of frames between 1Hz markers (counter0 resets). Set to zero to learn it from the incoming frames.',
+            mode='RW',
+            value=0,
+            localSet=lambda value: self._FrameStatistics.setFramesPerMarker(value),
+            localGet=self._FrameStatistics.getFramesPerMarker))
+
+        for n, d, get in [
+                ('Counter2JitterCnt',       'Number of counter2 increments outside the jitter tolerance',  self._FrameStatistics.getCounter2JitterCnt),
+                ('Counter2BackwardsCnt',    'Number of times counter2 did not increase',                  self._FrameStatistics.getCounter2BackwardsCnt),
+                ('Counter0ResetCnt',        'Number of counter0 resets at unexpected times',              self._FrameStatistics.getCounter0ResetCnt),
+                ('Counter0MissingResetCnt', 'Number of missing counter0 resets',                          self._FrameStatistics.getCounter0MissingResetCnt)]:
+            self.add(pyrogue.LocalVariable(
+                name=n,
+                description=d,
+                mode='RO',
+                value=0,
+                pollInterval=1,
+                localGet=get))
+
+        self.add(pyrogue.LocalVariable(
+            name='JitterMax',
+            description='Maximum absolute deviation of the counter2 increment',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._FrameStatistics.getJitterMax))
+
+        self.add(pyrogue.LocalVariable(
+            name='JitterMean',
+            description='Mean absolute deviation of the counter2 increment',
+            mode='RO',
+            value=0.0,
+            pollInterval=1,
+            localGet=self._FrameStatistics.getJitterMean))
+
+        for p, n in [(99.0, 'P99'), (99.9, 'P999')]:
+            self.add(pyrogue.LocalVariable(
+                name=f'Jitter{n}',
+                description=f'Absolute deviation of the counter2 increment at the {p} percentile',
+                mode='RO',
+                value=0,
+                pollInterval=1,
+                localGet=lambda p=p: self._FrameStatistics.getJitterPercentile(p)))
+
+        # Add the per-source statistics
+        self.add(pyrogue.LocalVariable(
+            name='SourceCnt',
+            description='Number of sources (ATCA crate and slot) received',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._FrameStatistics.getSourceCnt))
+
+        self.add(pyrogue.LocalVariable(
+            name='SourceOverflowCnt',
+            description='Number of frames from sources which did not fit in the source table',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._FrameStatistics.getSourceOverflowCnt))
+
+        for i in range(self._FrameStatistics.getMaxSources()):
+            self.add(FrameSourceStatistics(name=f'Source[{i}]', stats=self._FrameStatistics, index=i))
+
         # Command to clear all the counters
         self.add(pyrogue.LocalCommand(
             name='clearCnt',
             description='Clear all counters',
             function=self._FrameStatistics.clearCnt))
 
+    def getSnapshot(self):
+        """
+        Returns a consistent snapshot of all the counters, as a
+        dictionary. The keys are the names of the counter variables.
+        The per-source counters are in 'Sources', a list with a
+        dictionary per source (CrateId, SlotNumber, FrameCnt,
+        FrameLossCnt, FrameOutOrderCnt and ResyncCnt).
+        """
+        return self._FrameStatistics.getSnapshot()
+
+    def _start(self):
+        """
+        Registers the block metrics, and names the block in the trace
+        recorder, using the device path as block name.
+        """
+        pyrogue.Device._start(self)
+        self._FrameStatistics.registerMetrics(self.path)
+        self._FrameStatistics.setTraceName(self.path)
+
     def getSmurfDevice(self):
         """
         Returns a reference to the underlying smurf device.
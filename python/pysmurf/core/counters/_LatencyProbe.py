@@ -0,0 +1,159 @@
+#!/usr/bin/env python
+#-----------------------------------------------------------------------------
+# Title      : PySMuRF Latency Probe
+#-----------------------------------------------------------------------------
+# File       : _LatencyProbe.py
+# Created    : 2026-10-18
+#-----------------------------------------------------------------------------
+# Description:
+#    SMuRF Latency Probe Python Package
+#-----------------------------------------------------------------------------
+# This file is part of the smurf software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the smurf software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+
+import pyrogue
+
+import smurf
+
+class LatencyProbe(pyrogue.Device):
+    """
+    SMuRF Latency Probe Python Wrapper.
+
+    Measures the latency of the frames passing through it, as the
+    difference between the local clock and a header timestamp.
+    """
+
+    # Percentiles exposed as variables, and their variable names
+    _percentiles = [(50.0, 'P50'), (90.0, 'P90'), (99.0, 'P99'), (99.9, 'P999')]
+
+    def __init__(self, name, **kwargs):
+        self._LatencyProbe = smurf.core.counters.LatencyProbe()
+        pyrogue.Device.__init__(self, name=name, description='SMuRF Latency Probe', **kwargs)
+
+        # Add "Disable" variable
+        self.add(pyrogue.LocalVariable(
+            name='Disable',
+            description='Disable the processing block. Data will just pass thorough to the next slave.',
+            mode='RW',
+            value=False,
+            localSet=lambda value: self._LatencyProbe.setDisable(value),
+            localGet=self._LatencyProbe.getDisable))
+
+        # Add "Source" variable
+        self.add(pyrogue.LocalVariable(
+            name='Source',
+            description='Timestamp source, and clock it is compared against. Changing it clears the counters.',
+            mode='RW',
+            disp={
+                0 : 'UnixTimeSteady',
+                1 : 'UnixTimeRealtime',
+                2 : 'Counter2Realtime',
+            },
+            localSet=lambda value: self._LatencyProbe.setSource(value),
+            localGet=self._LatencyProbe.getSource))
+
+        # Add the frame counter variables
+        self.add(pyrogue.LocalVariable(
+            name='FrameCnt',
+            description='Number of measured frames',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._LatencyProbe.getFrameCnt))
+
+        self.add(pyrogue.LocalVariable(
+            name='BadFrameCnt',
+            description='Number of bad frames',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._LatencyProbe.getBadFrameCnt))
+
+        self.add(pyrogue.LocalVariable(
+            name='NegativeCnt',
+            description='Number of frames with timestamps in the future (clocks not synchronized)',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._LatencyProbe.getNegativeCnt))
+
+        # Add the latency variables
+        self.add(pyrogue.LocalVariable(
+            name='Last',
+            description='Last latency (ns)',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._LatencyProbe.getLast))
+
+        self.add(pyrogue.LocalVariable(
+            name='Min',
+            description='Minimum latency (ns)',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._LatencyProbe.getMin))
+
+        self.add(pyrogue.LocalVariable(
+            name='Max',
+            description='Maximum latency (ns)',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._LatencyProbe.getMax))
+
+        self.add(pyrogue.LocalVariable(
+            name='Mean',
+            description='Mean latency (ns)',
+            mode='RO',
+            value=0.0,
+            pollInterval=1,
+            localGet=self._LatencyProbe.getMean))
+
+        for p, n in self._percentiles:
+            self.add(pyrogue.LocalVariable(
+                name=n,
+                description=f'Latency at the {p} percentile (ns)',
+                mode='RO',
+                value=0,
+                pollInterval=1,
+                localGet=lambda p=p: self._LatencyProbe.getPercentile(p)))
+
+        # Command to clear all the counters
+        self.add(pyrogue.LocalCommand(
+            name='clearCnt',
+            description='Clear all counters',
+            function=self._LatencyProbe.clearCnt))
+
+    def getPercentile(self, p):
+        """
+        Returns the latency (in ns) at the percentile p, in the range [0, 100].
+        """
+        return self._LatencyProbe.getPercentile(p)
+
+    def _start(self):
+        """
+        Registers the block metrics, using the device path as block name.
+        """
+        pyrogue.Device._start(self)
+        self._LatencyProbe.registerMetrics(self.path)
+
+    def getSmurfDevice(self):
+        """
+        Returns a reference to the underlying smurf device.
+        """
+        return self._LatencyProbe
+
+    # Method called by streamConnect, streamTap and streamConnectBiDir to access slave
+    def _getStreamSlave(self):
+        return self._LatencyProbe
+
+    # Method called by streamConnect, streamTap and streamConnectBiDir to access master
+    def _getStreamMaster(self):
+        return self._LatencyProbe
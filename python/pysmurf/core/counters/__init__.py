@@ -17,4 +17,5 @@
 # contained in the LICENSE.txt file.
 #-----------------------------------------------------------------------------
 
-from pysmurf.core.counters._FrameStatistics import *
\ No newline at end of file
+from pysmurf.core.counters._FrameStatistics import *
+from pysmurf.core.counters._LatencyProbe import *
@@ -187,6 +187,117 @@ class GeneralAnalogFilter(pyrogue.Device):
             function=self.device.resetFilter))
 
 
+class PerfStage(pyrogue.Device):
+    """
+    SMuRF Processor Stage Performance Counters Python Wrapper.
+
+    The event counts are averaged over the measurements of the stage
+    (i.e. they are given per processed frame).
+    """
+    def __init__(self, name, device, stage, **kwargs):
+        pyrogue.Device.__init__(self, name=name, description=f'SMuRF {name} stage performance counters', **kwargs)
+        self.device = device
+        self.stage = stage
+
+        # Add "Calls" variable
+        self.add(pyrogue.LocalVariable(
+            name='Calls',
+            description='Number of measurements',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=lambda: self.device.getPerfCalls(self.stage)))
+
+        # Add a variable for each event
+        for event, event_name in enumerate(self.device.getPerfEventNames()):
+            self.add(pyrogue.LocalVariable(
+                name=event_name,
+                description=f'Average number of {event_name} per frame',
+                mode='RO',
+                value=0.0,
+                pollInterval=1,
+                localGet=lambda event=event: self._getAverage(event)))
+
+        # Add "IPC" variable
+        self.add(pyrogue.LocalVariable(
+            name='IPC',
+            description='Instructions per cycle',
+            mode='RO',
+            value=0.0,
+            pollInterval=1,
+            localGet=self._getIpc))
+
+    def _getAverage(self, event):
+        calls = self.device.getPerfCalls(self.stage)
+        if calls == 0:
+            return 0.0
+        return self.device.getPerfCount(self.stage, event) / calls
+
+    def _getIpc(self):
+        cycles = self.device.getPerfCount(self.stage, 0)
+        if cycles == 0:
+            return 0.0
+        return self.device.getPerfCount(self.stage, 1) / cycles
+
+class PerfCounters(pyrogue.Device):
+    """
+    SMuRF Processor Performance Counters Python Wrapper.
+
+    Measures the hardware events (cycles, instructions, cache misses and
+    branch misses) spent on each processing stage, using the Linux
+    perf_event_open interface. If the counters are not permitted by the
+    kernel (see /proc/sys/kernel/perf_event_paranoid) or not supported by
+    the CPU, the status is set to 'Unavailable' and the processing continues
+    without measurements.
+    """
+    def __init__(self, name, device, **kwargs):
+        pyrogue.Device.__init__(self, name=name, description='SMuRF Processor Performance Counters', **kwargs)
+        self.device = device
+
+        # Add "Enable" variable
+        self.add(pyrogue.LocalVariable(
+            name='Enable',
+            description='Enable the hardware performance counters',
+            mode='RW',
+            value=False,
+            localSet=lambda value: self.device.setPerfEnable(value),
+            localGet=self.device.getPerfEnable))
+
+        # Add "Status" variable
+        self.add(pyrogue.LocalVariable(
+            name='Status',
+            description='Status of the hardware performance counters',
+            mode='RO',
+            value=0,
+            enum={0:'Disabled', 1:'Running', 2:'Unavailable'},
+            pollInterval=1,
+            localGet=self.device.getPerfStatus))
+
+        # Add "EventAvailable" variable
+        self.add(pyrogue.LocalVariable(
+            name='EventAvailable',
+            description='Events being measured, in the order: ' + ', '.join(self.device.getPerfEventNames()),
+            mode='RO',
+            value=[False]*len(self.device.getPerfEventNames()),
+            pollInterval=1,
+            localGet=self.device.getPerfEventAvailable))
+
+        # Add a device for each stage
+        for stage, stage_name in enumerate(self.device.getPerfStageNames()):
+            self.add(PerfStage(name=stage_name, device=self.device, stage=stage))
+
+        # Command to clear the measurements
+        self.add(pyrogue.LocalCommand(
+            name='clear',
+            description='Clear the measurements',
+            function=self.device.clearPerf))
+
+    def getStats(self):
+        """
+        Returns the accumulated event counts, as a dictionary by stage.
+        """
+        return self.device.getPerfStats()
+
 class SmurfProcessor(pyrogue.Device):
     """
     SMuRF Processor device.
@@ -236,9 +347,60 @@ class SmurfProcessor(pyrogue.Device):
         self.smurf_downsampler = Downsampler(name="Downsampler", device=self.smurf_processor)
         self.add(self.smurf_downsampler)
 
-        # This device doesn't have any user configurations, so we don't add it to the tree
+        self.smurf_perf = PerfCounters(name="PerfCounters", device=self.smurf_processor)
+        self.add(self.smurf_perf)
+
+        # Add the frame counter variables
+        self.add(pyrogue.LocalVariable(
+            name='FrameCnt',
+            description='Number of frames received by the processor',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self.smurf_processor.getFrameCnt))
+
+        self.add(pyrogue.LocalVariable(
+            name='BadFrameCnt',
+            description='Number of bad frames dropped by the processor',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self.smurf_processor.getBadFrameCnt))
+
+        self.add(pyrogue.LocalVariable(
+            name='TxFrameCnt',
+            description='Number of frames sent by the processor',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self.smurf_processor.getTxFrameCnt))
+
+        self.add(pyrogue.LocalVariable(
+            name='SuppressedLogCnt',
+            description='Number of bad frame log messages suppressed by the rate limiters',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self.smurf_processor.getSuppressedLogCnt))
+
+        # This device doesn't have any user configurations, so we don't add it to the tree.
+        # Only its suppressed log message counter is shown here.
         self.smurf_header2smurf = pysmurf.core.conventers.Header2Smurf(name="Header2Smurf")
 
+        self.add(pyrogue.LocalVariable(
+            name='Header2SmurfSuppressedLogCnt',
+            description='Number of bad frame log messages suppressed by the rate limiters of the Header2Smurf converter',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self.smurf_header2smurf.getSuppressedLogCnt))
+
+        # Command to clear all the counters
+        self.add(pyrogue.LocalCommand(
+            name='clearCnt',
+            description='Clear all counters',
+            function=self._clearCnt))
+
         # Add a data emulator module, at the end of the chain
         self.post_data_emulator = pysmurf.core.emulators.StreamDataEmulatorI32(name="PostDataEmulator")
         self.add(self.post_data_emulator)
@@ -277,6 +439,21 @@ class SmurfProcessor(pyrogue.Device):
             if root:
                 pyrogue.streamTap(root, self.transmitter.getMetaChannel())
 
+    def _start(self):
+        """
+        Registers the block metrics, and names the block in the trace
+        recorder, using the device path as block name. The Header2Smurf
+        converter is not in the tree, so it is named here too.
+        """
+        pyrogue.Device._start(self)
+        self.smurf_processor.registerMetrics(self.path)
+        self.smurf_processor.setTraceName(self.path)
+        self.smurf_header2smurf.setTraceName(self.path + '.Header2Smurf')
+
+    def _clearCnt(self):
+        self.smurf_processor.clearCnt()
+        self.smurf_header2smurf.clearSuppressedLogCnt()
+
     def setTesBias(self, index, val):
         self.smurf_header2smurf.setTesBias(index, val)
 
@@ -0,0 +1,142 @@
+#!/usr/bin/env python
+#-----------------------------------------------------------------------------
+# Title      : PySMuRF Fault Injector
+#-----------------------------------------------------------------------------
+# File       : _FaultInjector.py
+# Created    : 2026-10-18
+#-----------------------------------------------------------------------------
+# Description:
+#    SMuRF Fault Injector
+#-----------------------------------------------------------------------------
+# This file is part of the smurf software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the smurf software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+
+import pyrogue
+
+import smurf
+import smurf.core.emulators
+
+class FaultInjector(pyrogue.Device):
+    """
+    FaultInjector Block.
+
+    Injects faults in the stream of frames passing through it, in
+    order to test how the downstream blocks behave under stress.
+    """
+
+    # Fault types, in the same order as defined in the C++ class
+    _faults = ['Reorder', 'Duplicate', 'Truncate', 'BitFlip', 'Error', 'Delay', 'Burst']
+
+    def __init__(self, name="FaultInjector", description="SMuRF Fault Injector", **kwargs):
+        pyrogue.Device.__init__(self, name=name, description=description, **kwargs)
+
+        self._injector = smurf.core.emulators.FaultInjector()
+
+        # Add "Disable" variable
+        self.add(pyrogue.LocalVariable(
+            name='Disable',
+            description='Disable the processing block. Data will just pass thorough to the next slave.',
+            mode='RW',
+            value=True,
+            localSet=lambda value: self._injector.setDisable(value),
+            localGet=self._injector.getDisable))
+
+        # Add "Periodic" variable
+        self.add(pyrogue.LocalVariable(
+            name='Periodic',
+            description='Inject faults periodically at their defined rates, instead of randomly.',
+            mode='RW',
+            value=False,
+            localSet=lambda value: self._injector.setPeriodic(value),
+            localGet=self._injector.getPeriodic))
+
+        # Add the rate and counter variables for each fault type
+        for i, f in enumerate(self._faults):
+            self.add(pyrogue.LocalVariable(
+                name=f'{f}Rate',
+                description=f'{f} fault rate, per frame, in the range [0, 1].',
+                mode='RW',
+                value=0.0,
+                localSet=lambda value, fault=i: self._injector.setRate(fault, value),
+                localGet=lambda fault=i: self._injector.getRate(fault)))
+
+            self.add(pyrogue.LocalVariable(
+                name=f'{f}Cnt',
+                description=f'Number of injected {f} faults.',
+                mode='RO',
+                value=0,
+                pollInterval=1,
+                localGet=lambda fault=i: self._injector.getFaultCnt(fault)))
+
+        # Add "Delay" variable
+        self.add(pyrogue.LocalVariable(
+            name='Delay',
+            description='Delay applied to delayed frames, in us.',
+            mode='RW',
+            value=1000,
+            localSet=lambda value: self._injector.setDelay(value),
+            localGet=self._injector.getDelay))
+
+        # Add "BurstSize" variable
+        self.add(pyrogue.LocalVariable(
+            name='BurstSize',
+            description='Number of frames held and sent back-to-back in a burst.',
+            mode='RW',
+            value=10,
+            localSet=lambda value: self._injector.setBurstSize(value),
+            localGet=self._injector.getBurstSize))
+
+        # Add the frame counter variable
+        self.add(pyrogue.LocalVariable(
+            name='FrameCnt',
+            description='Number of received frames',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._injector.getFrameCnt))
+
+        # Add the last fault time variable
+        self.add(pyrogue.LocalVariable(
+            name='LastFaultTime',
+            description='Time of the last injected fault (ns, from the steady clock)',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._injector.getLastFaultTime))
+
+        # Command to clear all the counters
+        self.add(pyrogue.LocalCommand(
+            name='clearCnt',
+            description='Clear all counters',
+            function=self._injector.clearCnt))
+
+    def _start(self):
+        """
+        Registers the block metrics, using the device path as block name.
+        """
+        pyrogue.Device._start(self)
+        self._injector.registerMetrics(self.path)
+
+    def getSmurfDevice(self):
+        """
+        Returns a reference to the underlying smurf device.
+        """
+        return self._injector
+
+    def _getStreamSlave(self):
+        """
+        Method called by streamConnect, streamTap and streamConnectBiDir to access slave.
+        """
+        return self._injector
+
+    def _getStreamMaster(self):
+        """
+        Method called by streamConnect, streamTap and streamConnectBiDir to access master.
+        """
+        return self._injector
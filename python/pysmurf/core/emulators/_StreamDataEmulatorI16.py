@@ -54,6 +54,8 @@ class StreamDataEmulatorI16(pyrogue.Device):
                 5 : 'Triangle',
                 6 : 'Sine',
                 7 : 'DropFrame',
+                8 : 'Detector',
+                9 : 'ChannelSine',
             },
             localSet=lambda value: self._emulator.setType(value),
             localGet=self._emulator.getType))
@@ -87,6 +89,121 @@ class StreamDataEmulatorI16(pyrogue.Device):
             localSet=lambda value: self._emulator.setPeriod(value),
             localGet=self._emulator.getPeriod))
 
+        # Add the "Detector" signal variables
+        self.add(pyrogue.LocalVariable(
+            name='WhiteNoise',
+            description='Detector signal: white noise RMS, in ADC counts.',
+            mode='RW',
+            value=10.0,
+            localSet=lambda value: self._emulator.setWhiteNoise(value),
+            localGet=self._emulator.getWhiteNoise))
+
+        self.add(pyrogue.LocalVariable(
+            name='PinkNoise',
+            description='Detector signal: 1/f noise RMS, in ADC counts.',
+            mode='RW',
+            value=10.0,
+            localSet=lambda value: self._emulator.setPinkNoise(value),
+            localGet=self._emulator.getPinkNoise))
+
+        self.add(pyrogue.LocalVariable(
+            name='DriftRate',
+            description='Detector signal: maximum drift rate, in ADC counts per frame. Each channel gets a random rate.',
+            mode='RW',
+            value=10.0,
+            localSet=lambda value: self._emulator.setDriftRate(value),
+            localGet=self._emulator.getDriftRate))
+
+        self.add(pyrogue.LocalVariable(
+            name='FluxJumpProbability',
+            description='Detector signal: probability of a flux jump, per channel and per frame.',
+            mode='RW',
+            value=0.0,
+            localSet=lambda value: self._emulator.setFluxJumpProbability(value),
+            localGet=self._emulator.getFluxJumpProbability))
+
+        self.add(pyrogue.LocalVariable(
+            name='FluxJumpAmplitude',
+            description='Detector signal: flux jump amplitude, in ADC counts.',
+            mode='RW',
+            value=0.0,
+            localSet=lambda value: self._emulator.setFluxJumpAmplitude(value),
+            localGet=self._emulator.getFluxJumpAmplitude))
+
+        self.add(pyrogue.LocalVariable(
+            name='GlitchProbability',
+            description='Detector signal: probability of a glitch, per channel and per frame.',
+            mode='RW',
+            value=0.0,
+            localSet=lambda value: self._emulator.setGlitchProbability(value),
+            localGet=self._emulator.getGlitchProbability))
+
+        self.add(pyrogue.LocalVariable(
+            name='GlitchAmplitude',
+            description='Detector signal: glitch amplitude, in ADC counts.',
+            mode='RW',
+            value=0.0,
+            localSet=lambda value: self._emulator.setGlitchAmplitude(value),
+            localGet=self._emulator.getGlitchAmplitude))
+
+        self.add(pyrogue.LocalVariable(
+            name='CommonMode',
+            description='Detector signal: common mode noise RMS, in ADC counts.',
+            mode='RW',
+            value=0.0,
+            localSet=lambda value: self._emulator.setCommonMode(value),
+            localGet=self._emulator.getCommonMode))
+
+        # Add the "ChannelSine" signal variables
+        # Rogue doesn't allow to have an empty list here. Also, the EPICS PV is created
+        # with the initial size of this list, and can not be changed later, so we are doing
+        # it big enough at this point using the maximum number of channels
+        self.add(pyrogue.LocalVariable(
+            name='SineFrequencies',
+            description='ChannelSine signal: frequency of each channel, in cycles per frame.',
+            mode='RW',
+            value=[0.0]*4096,
+            localSet=lambda value: self._emulator.setSineFrequencies(value),
+            localGet=self._emulator.getSineFrequencies))
+
+        self.add(pyrogue.LocalVariable(
+            name='SineAmplitudes',
+            description='ChannelSine signal: peak amplitude of each channel, in ADC counts.',
+            mode='RW',
+            value=[0.0]*4096,
+            localSet=lambda value: self._emulator.setSineAmplitudes(value),
+            localGet=self._emulator.getSineAmplitudes))
+
+        self.add(pyrogue.LocalVariable(
+            name='SinePhases',
+            description='ChannelSine signal: initial phase of each channel, in degrees.',
+            mode='RW',
+            value=[0.0]*4096,
+            localSet=lambda value: self._emulator.setSinePhases(value),
+            localGet=self._emulator.getSinePhases))
+
+        # Add the suppressed log message counter
+        self.add(pyrogue.LocalVariable(
+            name='SuppressedLogCnt',
+            description='Number of bad frame log messages suppressed by the rate limiters',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._emulator.getSuppressedLogCnt))
+
+        # Command to clear the suppressed log message counter
+        self.add(pyrogue.LocalCommand(
+            name='clearSuppressedLogCnt',
+            description='Clear the suppressed log message counter',
+            function=self._emulator.clearSuppressedLogCnt))
+
+    def _start(self):
+        """
+        Names the block in the trace recorder, using the device path.
+        """
+        pyrogue.Device._start(self)
+        self._emulator.setTraceName(self.path)
+
     def getSmurfDevice(self):
         """
         Returns a reference to the underlying smurf device.
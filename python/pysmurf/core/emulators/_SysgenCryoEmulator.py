@@ -0,0 +1,115 @@
+#!/usr/bin/env python
+#-----------------------------------------------------------------------------
+# Title      : PySMuRF SysgenCryo Emulator
+#-----------------------------------------------------------------------------
+# File       : _SysgenCryoEmulator.py
+# Created    : 2026-10-18
+#-----------------------------------------------------------------------------
+# Description:
+#    SMuRF SysgenCryo Emulator
+#-----------------------------------------------------------------------------
+# This file is part of the smurf software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the smurf software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+
+import pyrogue
+
+import smurf
+import smurf.core.emulators
+
+class SysgenCryoEmulator(pyrogue.Device):
+    """
+    SysgenCryoEmulator Block.
+
+    Emulates the SysgenCryo register space, with a resonator per
+    channel, so that the SysgenCryo engine can be tested and
+    benchmarked without hardware.
+    """
+    def __init__(self, name="SysgenCryoEmulator", description="SMuRF SysgenCryo Emulator", numBands=1, **kwargs):
+        pyrogue.Device.__init__(self, name=name, description=description, **kwargs)
+
+        self._emulator = smurf.core.emulators.SysgenCryoEmulator(numBands)
+
+        # Add "Latency" variable
+        self.add(pyrogue.LocalVariable(
+            name='Latency',
+            description='Latency of each transaction, in us.',
+            mode='RW',
+            value=0.0,
+            localSet=lambda value: self._emulator.setLatency(value),
+            localGet=self._emulator.getLatency))
+
+        # Add "Bandwidth" variable
+        self.add(pyrogue.LocalVariable(
+            name='Bandwidth',
+            description='Link bandwidth, in bytes per second. Zero means no limit.',
+            mode='RW',
+            value=0.0,
+            localSet=lambda value: self._emulator.setBandwidth(value),
+            localGet=self._emulator.getBandwidth))
+
+        # Add "Noise" variable
+        self.add(pyrogue.LocalVariable(
+            name='Noise',
+            description='RMS noise added to the frequency error, in raw counts.',
+            mode='RW',
+            value=0.0,
+            localSet=lambda value: self._emulator.setNoise(value),
+            localGet=self._emulator.getNoise))
+
+        # Add the transaction counter variable
+        self.add(pyrogue.LocalVariable(
+            name='TransactionCnt',
+            description='Number of transactions',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._emulator.getTransactionCnt))
+
+        # Add the byte counter variables
+        self.add(pyrogue.LocalVariable(
+            name='ReadBytes',
+            description='Number of read bytes',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._emulator.getReadBytes))
+
+        self.add(pyrogue.LocalVariable(
+            name='WriteBytes',
+            description='Number of written bytes',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._emulator.getWriteBytes))
+
+        # Command to clear all the counters
+        self.add(pyrogue.LocalCommand(
+            name='clearCnt',
+            description='Clear all counters',
+            function=self._emulator.clearCnt))
+
+    def setResonator(self, band, channel, frequency, bandwidth=0.1, depth=0.9):
+        """
+        Sets the resonator of a channel: its frequency offset from the
+        channel center (MHz), its bandwidth (MHz) and its depth.
+        """
+        self._emulator.setResonator(band, channel, frequency, bandwidth, depth)
+
+    def randomizeResonators(self, maxOffset, seed=0):
+        """
+        Sets random resonator frequency offsets, in the range
+        [-maxOffset, maxOffset] MHz, on all the channels.
+        """
+        self._emulator.randomizeResonators(maxOffset, seed)
+
+    def getSmurfDevice(self):
+        """
+        Returns a reference to the underlying smurf device.
+        """
+        return self._emulator
@@ -21,3 +21,5 @@ from pysmurf.core.emulators._StreamDataEmulatorI16 import StreamDataEmulatorI16
 from pysmurf.core.emulators._StreamDataEmulatorI32 import StreamDataEmulatorI32
 from pysmurf.core.emulators._StreamDataSource      import StreamDataSource
 from pysmurf.core.emulators._DataFromFile          import DataFromFile
+from pysmurf.core.emulators._FaultInjector         import FaultInjector
+from pysmurf.core.emulators._SysgenCryoEmulator    import SysgenCryoEmulator
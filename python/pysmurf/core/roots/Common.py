@@ -74,6 +74,14 @@ class Common(pyrogue.Root):
             txDevice=txDevice)
         self.add(self._smurf_processor)
 
+        # Add the metrics server. It is disabled by default.
+        self._metrics_server = pysmurf.core.utilities.MetricsServer(name="MetricsServer")
+        self.add(self._metrics_server)
+
+        # Add the frame processing tracer. It is disabled by default.
+        self._tracer = pysmurf.core.utilities.Tracer(name="Tracer")
+        self.add(self._tracer)
+
         # Connect smurf processor
         pyrogue.streamConnect(self._streaming_stream, self._smurf_processor)
 
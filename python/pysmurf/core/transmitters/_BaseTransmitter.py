@@ -62,6 +62,13 @@ class BaseTransmitter(pyrogue.Device):
             description='Clear all counters',
             function=self._transmitter.clearCnt))
 
+    def _start(self):
+        """
+        Registers the block metrics, using the device path as block name.
+        """
+        pyrogue.Device._start(self)
+        self._transmitter.registerMetrics(self.path)
+
     def getDataChannel(self):
         return self._transmitter.getDataChannel()
 
@@ -0,0 +1,161 @@
+#!/usr/bin/env python
+#-----------------------------------------------------------------------------
+# Title      : PySMuRF Frame Pacer
+#-----------------------------------------------------------------------------
+# File       : _FramePacer.py
+# Created    : 2026-10-18
+#-----------------------------------------------------------------------------
+# Description:
+#    SMuRF Frame Pacer
+#-----------------------------------------------------------------------------
+# This file is part of the smurf software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the smurf software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+
+import pyrogue
+
+import smurf
+import smurf.core.utilities
+
+class FramePacer(pyrogue.Device):
+    """
+    FramePacer Block.
+
+    Holds the incoming frames in a bounded queue, and releases them
+    to the next slave following a token bucket schedule.
+    """
+    def __init__(self, name="FramePacer", description="SMuRF Frame Pacer", **kwargs):
+        pyrogue.Device.__init__(self, name=name, description=description, **kwargs)
+
+        self._pacer = smurf.core.utilities.FramePacer()
+
+        # Add "Disable" variable
+        self.add(pyrogue.LocalVariable(
+            name='Disable',
+            description='Disable the processing block. Data will just pass thorough to the next slave.',
+            mode='RW',
+            value=False,
+            localSet=lambda value: self._pacer.setDisable(value),
+            localGet=self._pacer.getDisable))
+
+        # Add "Rate" variable
+        self.add(pyrogue.LocalVariable(
+            name='Rate',
+            description='Release rate, in frames per second (Hz). Set to zero to disable the rate limit.',
+            mode='RW',
+            value=0.0,
+            localSet=lambda value: self._pacer.setRate(value),
+            localGet=self._pacer.getRate))
+
+        # Add "Burst" variable
+        self.add(pyrogue.LocalVariable(
+            name='Burst',
+            description='Token bucket size: maximum number of frames released back-to-back.',
+            mode='RW',
+            value=1,
+            localSet=lambda value: self._pacer.setBurst(value),
+            localGet=self._pacer.getBurst))
+
+        # Add "Depth" variable
+        self.add(pyrogue.LocalVariable(
+            name='Depth',
+            description='Queue depth, in frames. Frames arriving when the queue is full are dropped.',
+            mode='RW',
+            value=100,
+            localSet=lambda value: self._pacer.setDepth(value),
+            localGet=self._pacer.getDepth))
+
+        # Add the queue occupancy variables
+        self.add(pyrogue.LocalVariable(
+            name='QueueCnt',
+            description='Number of frames in the queue',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._pacer.getQueueCnt))
+
+        self.add(pyrogue.LocalVariable(
+            name='MaxQueueCnt',
+            description='Maximum number of frames in the queue',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._pacer.getMaxQueueCnt))
+
+        # Add the frame counter variables
+        self.add(pyrogue.LocalVariable(
+            name='TxCnt',
+            description='Number of released frames',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._pacer.getTxCnt))
+
+        self.add(pyrogue.LocalVariable(
+            name='DropCnt',
+            description='Number of dropped frames',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._pacer.getDropCnt))
+
+        self.add(pyrogue.LocalVariable(
+            name='DelayCnt',
+            description='Number of frames which were not released as soon as they arrived',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._pacer.getDelayCnt))
+
+        # Add the delay variables
+        self.add(pyrogue.LocalVariable(
+            name='AvgDelay',
+            description='Average time the frames were held in the queue (ns)',
+            mode='RO',
+            value=0.0,
+            pollInterval=1,
+            localGet=self._pacer.getAvgDelay))
+
+        self.add(pyrogue.LocalVariable(
+            name='MaxDelay',
+            description='Maximum time a frame was held in the queue (ns)',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._pacer.getMaxDelay))
+
+        # Command to clear all the counters
+        self.add(pyrogue.LocalCommand(
+            name='clearCnt',
+            description='Clear all counters',
+            function=self._pacer.clearCnt))
+
+    def _start(self):
+        """
+        Registers the block metrics, using the device path as block name.
+        """
+        pyrogue.Device._start(self)
+        self._pacer.registerMetrics(self.path)
+
+    def getSmurfDevice(self):
+        """
+        Returns a reference to the underlying smurf device.
+        """
+        return self._pacer
+
+    def _getStreamSlave(self):
+        """
+        Method called by streamConnect, streamTap and streamConnectBiDir to access slave.
+        """
+        return self._pacer
+
+    def _getStreamMaster(self):
+        """
+        Method called by streamConnect, streamTap and streamConnectBiDir to access master.
+        """
+        return self._pacer
@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+#-----------------------------------------------------------------------------
+# Title      : PySMuRF Metrics Server
+#-----------------------------------------------------------------------------
+# File       : _MetricsServer.py
+# Created    : 2026-10-18
+#-----------------------------------------------------------------------------
+# Description:
+#    SMuRF Metrics Server Python Package
+#-----------------------------------------------------------------------------
+# This file is part of the smurf software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the smurf software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+
+import pyrogue
+
+import smurf
+import smurf.core.utilities
+
+class MetricsServer(pyrogue.Device):
+    """
+    MetricsServer Block.
+
+    Serves the metrics registered by the SMuRF C++ blocks over HTTP,
+    in the Prometheus text format, at http://127.0.0.1:<Port>/metrics.
+    """
+    def __init__(self, name="MetricsServer", description="SMuRF Metrics Server", **kwargs):
+        pyrogue.Device.__init__(self, name=name, description=description, **kwargs)
+
+        self._server = smurf.core.utilities.MetricsServer()
+
+        # Add "Enable" variable
+        self.add(pyrogue.LocalVariable(
+            name='Enable',
+            description='Enable the HTTP server.',
+            mode='RW',
+            value=False,
+            localSet=lambda value: self._server.setEnable(value),
+            localGet=self._server.getEnable))
+
+        # Add "Port" variable
+        self.add(pyrogue.LocalVariable(
+            name='Port',
+            description='TCP port, on the local interface. The server is restarted if it is running.',
+            mode='RW',
+            value=9110,
+            localSet=lambda value: self._server.setPort(value),
+            localGet=self._server.getPort))
+
+        # Add the counter variables
+        self.add(pyrogue.LocalVariable(
+            name='ScrapeCnt',
+            description='Number of served scrapes',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._server.getScrapeCnt))
+
+        self.add(pyrogue.LocalVariable(
+            name='ErrorCnt',
+            description='Number of failed or rejected requests',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._server.getErrorCnt))
+
+        self.add(pyrogue.LocalVariable(
+            name='MetricCnt',
+            description='Number of registered metrics',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._server.getMetricCnt))
+
+        # Command to clear all the counters
+        self.add(pyrogue.LocalCommand(
+            name='clearCnt',
+            description='Clear all counters',
+            function=self._server.clearCnt))
+
+    def getMetrics(self):
+        """
+        Returns the metrics, in the same format they are served.
+        """
+        return self._server.getMetrics()
+
+    def getSmurfDevice(self):
+        """
+        Returns a reference to the underlying smurf device.
+        """
+        return self._server
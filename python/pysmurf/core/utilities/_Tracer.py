@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+#-----------------------------------------------------------------------------
+# Title      : PySMuRF Tracer
+#-----------------------------------------------------------------------------
+# File       : _Tracer.py
+# Created    : 2026-10-18
+#-----------------------------------------------------------------------------
+# Description:
+#    SMuRF Tracer Python Package
+#-----------------------------------------------------------------------------
+# This file is part of the smurf software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the smurf software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+
+import pyrogue
+
+import smurf
+import smurf.core.utilities
+
+class Tracer(pyrogue.Device):
+    """
+    Tracer Block.
+
+    Records the time spent by the SMuRF C++ blocks on each frame, and
+    dumps the recorded events in the Chrome trace event format, which
+    can be opened with chrome://tracing or https://ui.perfetto.dev.
+    """
+    def __init__(self, name="Tracer", description="SMuRF Tracer", **kwargs):
+        pyrogue.Device.__init__(self, name=name, description=description, **kwargs)
+
+        self._tracer = smurf.core.utilities.Tracer()
+
+        # Add "Enable" variable
+        self.add(pyrogue.LocalVariable(
+            name='Enable',
+            description='Enable the recording of events.',
+            mode='RW',
+            value=False,
+            localSet=lambda value: self._tracer.setEnable(value),
+            localGet=self._tracer.getEnable))
+
+        # Add "FileName" variable
+        self.add(pyrogue.LocalVariable(
+            name='FileName',
+            description='File where the events are written by the "dump" command.',
+            mode='RW',
+            value='/tmp/smurf_trace.json'))
+
+        # Add the counter variables
+        self.add(pyrogue.LocalVariable(
+            name='EventCnt',
+            description='Number of events recorded since the last clear. Only the last "Capacity" events are kept.',
+            mode='RO',
+            value=0,
+            pollInterval=1,
+            localGet=self._tracer.getEventCnt))
+
+        self.add(pyrogue.LocalVariable(
+            name='Capacity',
+            description='Number of events the ring buffer can hold',
+            mode='RO',
+            value=0,
+            localGet=self._tracer.getCapacity))
+
+        # Command to write the events to a file
+        self.add(pyrogue.LocalCommand(
+            name='dump',
+            description='Write the recorded events to "FileName"',
+            function=lambda: self.dump(self.FileName.get())))
+
+        # Command to discard all the events
+        self.add(pyrogue.LocalCommand(
+            name='clear',
+            description='Discard all the recorded events',
+            function=self._tracer.clear))
+
+    def dump(self, fileName):
+        """
+        Writes the recorded events to a file, in the Chrome trace event
+        format. Returns False if the file could not be written.
+        """
+        return self._tracer.dump(fileName)
+
+    def getJson(self):
+        """
+        Returns the recorded events, in the Chrome trace event format.
+        """
+        return self._tracer.getJson()
+
+    def getSmurfDevice(self):
+        """
+        Returns a reference to the underlying smurf device.
+        """
+        return self._tracer
@@ -19,3 +19,6 @@
 
 from pysmurf.core.utilities._SetupGroups import setupGroups
 from pysmurf.core.utilities._SmurfPublisher import SmurfPublisher
+from pysmurf.core.utilities._FramePacer import FramePacer
+from pysmurf.core.utilities._MetricsServer import MetricsServer
+from pysmurf.core.utilities._Tracer import Tracer
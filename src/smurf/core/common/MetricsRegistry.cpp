@@ -0,0 +1,285 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Metrics Registry
+ * ----------------------------------------------------------------------------
+ * File          : MetricsRegistry.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Metrics Registry Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include "smurf/core/common/MetricsRegistry.h"
+
+MetricsRegistry::MetricsRegistry()
+:
+    eLog_(rogue::Logging::create("pysmurf.MetricsRegistry"))
+{
+}
+
+MetricsRegistry& MetricsRegistry::getInstance()
+{
+    // The registry is never destroyed, so that the blocks can remove
+    // their metrics even if they are destroyed during the process exit.
+    static MetricsRegistry* instance = new MetricsRegistry();
+    return *instance;
+}
+
+void MetricsRegistry::addCounter(const void* owner, const std::string& name, const std::string& help,
+                                 const labels_t& labels, getter_t get)
+{
+    add(owner, name, help, Type::Counter, labels, get, nullptr);
+}
+
+void MetricsRegistry::addGauge(const void* owner, const std::string& name, const std::string& help,
+                               const labels_t& labels, getter_t get)
+{
+    add(owner, name, help, Type::Gauge, labels, get, nullptr);
+}
+
+void MetricsRegistry::addHistogram(const void* owner, const std::string& name, const std::string& help,
+                                   const labels_t& labels, const LogHistogram* hist)
+{
+    if ( ! hist )
+    {
+        eLog_->error("Trying to register the histogram '%s' without a histogram object", name.c_str());
+        return;
+    }
+
+    add(owner, name, help, Type::Histogram, labels, getter_t(), hist);
+}
+
+void MetricsRegistry::add(const void* owner, const std::string& name, const std::string& help, Type type,
+                          const labels_t& labels, getter_t get, const LogHistogram* hist)
+{
+    if ( ! isValidName(name) )
+    {
+        eLog_->error("Trying to register a metric with an invalid name '%s'", name.c_str());
+        return;
+    }
+
+    for (auto const &l : labels)
+    {
+        if ( ( ! isValidName(l.first) ) || ( std::string::npos != l.first.find(':') ) )
+        {
+            eLog_->error("Trying to register the metric '%s' with an invalid label name '%s'",
+                name.c_str(), l.first.c_str());
+            return;
+        }
+    }
+
+    Metric m { owner, formatLabels(labels), get, hist };
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto it = families.find(name);
+    if ( it == families.end() )
+    {
+        families[name] = Family { type, help, std::vector<Metric>(1, m) };
+        return;
+    }
+
+    Family& f { it->second };
+
+    if ( f.type != type )
+    {
+        eLog_->error("Trying to register the metric '%s' as a %s, but it was already registered as a %s",
+            name.c_str(), typeName(type), typeName(f.type));
+        return;
+    }
+
+    // All the metrics in a family must have a different set of labels
+    for (auto const &e : f.metrics)
+    {
+        if ( e.labels == m.labels )
+        {
+            eLog_->error("Trying to register the metric '%s{%s}' twice", name.c_str(), m.labels.c_str());
+            return;
+        }
+    }
+
+    f.metrics.push_back(m);
+}
+
+void MetricsRegistry::remove(const void* owner)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+
+    for (auto it = families.begin(); it != families.end(); )
+    {
+        std::vector<Metric>& v { it->second.metrics };
+        v.erase( std::remove_if(v.begin(), v.end(), [owner](const Metric& m) { return m.owner == owner; }), v.end() );
+
+        if ( v.empty() )
+            it = families.erase(it);
+        else
+            ++it;
+    }
+}
+
+const std::size_t MetricsRegistry::getSize() const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+
+    std::size_t n { 0 };
+    for (auto const &f : families)
+        n += f.second.metrics.size();
+
+    return n;
+}
+
+const std::string MetricsRegistry::render() const
+{
+    std::string out;
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    for (auto const &f : families)
+    {
+        out += "# HELP " + f.first + " " + escape(f.second.help, true) + "\n";
+        out += "# TYPE " + f.first + " " + typeName(f.second.type) + "\n";
+
+        for (auto const &m : f.second.metrics)
+        {
+            if ( Type::Histogram == f.second.type )
+            {
+                renderHistogram(out, f.first, m);
+                continue;
+            }
+
+            out += f.first;
+            if ( ! m.labels.empty() )
+                out += "{" + m.labels + "}";
+            out += " " + formatValue(m.get()) + "\n";
+        }
+    }
+
+    return out;
+}
+
+void MetricsRegistry::renderHistogram(std::string& out, const std::string& name, const Metric& m)
+{
+    std::string prefix { m.labels.empty() ? "" : m.labels + "," };
+
+    // The buckets are read only once, and the total count is computed from them,
+    // so that the cumulative counts are consistent even if values are being recorded.
+    std::size_t bucket { 0 };
+    uint64_t    acc    { 0 };
+
+    for (std::size_t b{histMinBits}; b <= histMaxBits; ++b)
+    {
+        // Add all the histogram buckets with values below 2^b ns. The power of
+        // two boundaries match the start of the LogHistogram bucket groups.
+        std::size_t last { LogHistogram::getBucketIndex(1ULL << b) };
+        for (; bucket < last; ++bucket)
+            acc += m.hist->getBucketCount(bucket);
+
+        // The bucket bounds are printed with a fixed precision, so that they are
+        // always the same strings, and they are easier to read.
+        out += name + "_bucket{" + prefix + "le=\"" + formatValue( std::ldexp(1e-9, b), 9 ) + "\"} "
+            + std::to_string(acc) + "\n";
+    }
+
+    for (; bucket < LogHistogram::numBuckets; ++bucket)
+        acc += m.hist->getBucketCount(bucket);
+
+    out += name + "_bucket{" + prefix + "le=\"+Inf\"} " + std::to_string(acc) + "\n";
+
+    std::string labels { m.labels.empty() ? "" : "{" + m.labels + "}" };
+    out += name + "_sum"   + labels + " " + formatValue( m.hist->getSum() * 1e-9 ) + "\n";
+    out += name + "_count" + labels + " " + std::to_string(acc) + "\n";
+}
+
+bool MetricsRegistry::isValidName(const std::string& name)
+{
+    if ( name.empty() )
+        return false;
+
+    for (std::size_t i{0}; i < name.size(); ++i)
+    {
+        char c { name[i] };
+        bool valid { ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || ( c == '_' ) || ( c == ':' )
+                  || ( ( i > 0 ) && ( c >= '0' && c <= '9' ) ) };
+
+        if ( ! valid )
+            return false;
+    }
+
+    return true;
+}
+
+std::string MetricsRegistry::formatLabels(const labels_t& labels)
+{
+    std::string s;
+
+    for (auto const &l : labels)
+    {
+        if ( ! s.empty() )
+            s += ",";
+
+        s += l.first + "=\"" + escape(l.second, false) + "\"";
+    }
+
+    return s;
+}
+
+std::string MetricsRegistry::escape(const std::string& s, bool isHelp)
+{
+    std::string r;
+
+    // Backslashes and new lines are escaped in the help texts and label
+    // values. Double quotes are escaped only in the label values.
+    for (auto const &c : s)
+    {
+        if ( '\\' == c )
+            r += "\\\\";
+        else if ( '\n' == c )
+            r += "\\n";
+        else if ( ( '"' == c ) && ( ! isHelp ) )
+            r += "\\\"";
+        else
+            r += c;
+    }
+
+    return r;
+}
+
+std::string MetricsRegistry::formatValue(double v, int precision)
+{
+    if ( std::isnan(v) )
+        return "NaN";
+
+    if ( std::isinf(v) )
+        return ( v > 0 ) ? "+Inf" : "-Inf";
+
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.*g", precision, v);
+    return std::string(buf);
+}
+
+const char* MetricsRegistry::typeName(Type type)
+{
+    switch (type)
+    {
+        case Type::Counter:
+            return "counter";
+        case Type::Gauge:
+            return "gauge";
+        case Type::Histogram:
+            return "histogram";
+    }
+
+    return "untyped";
+}
@@ -0,0 +1,317 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Performance Counters
+ * ----------------------------------------------------------------------------
+ * File          : PerfCounters.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Performance Counters Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "smurf/core/common/PerfCounters.h"
+
+const char* PerfCounters::eventNames[PerfCounters::NumEvents] =
+{
+    "Cycles",
+    "Instructions",
+    "L1dMisses",
+    "LlcMisses",
+    "BranchMisses"
+};
+
+namespace
+{
+    // Open a counter for the calling thread, on any CPU, in user space only
+    int openEvent(uint32_t type, uint64_t config, int groupFd)
+    {
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = type;
+        attr.config         = config;
+        attr.disabled       = ( -1 == groupFd ) ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_GROUP;
+
+        return static_cast<int>( ::syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0) );
+    }
+}
+
+PerfCounters::PerfCounters(std::size_t numStages)
+:
+    enable(false),
+    status(Disabled),
+    clearReq(false),
+    available(0),
+    stages(numStages),
+    isOpen(false),
+    failed(false),
+    numOpen(0),
+    started(false),
+    eLog_(rogue::Logging::create("pysmurf.PerfCounters"))
+{
+    fds.fill(-1);
+    position.fill(0);
+    last.fill(0);
+
+    for (auto &s : stages)
+    {
+        s.calls = 0;
+        for (auto &c : s.counts)
+            c = 0;
+    }
+}
+
+PerfCounters::~PerfCounters()
+{
+    close();
+}
+
+void PerfCounters::setEnable(bool e)
+{
+    enable.store(e, std::memory_order_relaxed);
+}
+
+const bool PerfCounters::getEnable() const
+{
+    return enable.load(std::memory_order_relaxed);
+}
+
+const int PerfCounters::getStatus() const
+{
+    return status.load(std::memory_order_relaxed);
+}
+
+const bool PerfCounters::getEventAvailable(std::size_t event) const
+{
+    if ( event >= NumEvents )
+        return false;
+
+    return available.load(std::memory_order_relaxed) & ( 1u << event );
+}
+
+void PerfCounters::clear()
+{
+    clearReq.store(true, std::memory_order_relaxed);
+}
+
+void PerfCounters::begin()
+{
+    started = false;
+
+    if ( ! enable.load(std::memory_order_relaxed) )
+    {
+        // Close the counters, if they were open, and allow
+        // to try to open them again on the next enable
+        if ( isOpen )
+            close();
+
+        failed = false;
+        status.store(Disabled, std::memory_order_relaxed);
+        return;
+    }
+
+    if ( clearReq.exchange(false, std::memory_order_relaxed) )
+    {
+        for (auto &s : stages)
+        {
+            s.calls.store(0, std::memory_order_relaxed);
+            for (auto &c : s.counts)
+                c.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    if ( ! isOpen )
+    {
+        // Don't try again if it already failed
+        if ( failed )
+            return;
+
+        if ( ! open() )
+        {
+            failed = true;
+            status.store(Unavailable, std::memory_order_relaxed);
+            return;
+        }
+
+        status.store(Running, std::memory_order_relaxed);
+    }
+
+    started = read(last);
+}
+
+void PerfCounters::mark(std::size_t stage)
+{
+    if ( ( ! started ) || ( stage >= stages.size() ) )
+        return;
+
+    std::array<uint64_t, NumEvents> values;
+    if ( ! read(values) )
+    {
+        started = false;
+        return;
+    }
+
+    // Only this thread writes the values, so a load and a store are enough
+    Stage& s { stages[stage] };
+    s.calls.store(s.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    for (std::size_t i{0}; i < NumEvents; ++i)
+        s.counts[i].store(s.counts[i].load(std::memory_order_relaxed) + ( values[i] - last[i] ),
+            std::memory_order_relaxed);
+
+    last = values;
+}
+
+const uint64_t PerfCounters::getCalls(std::size_t stage) const
+{
+    if ( stage >= stages.size() )
+        return 0;
+
+    return stages[stage].calls.load(std::memory_order_relaxed);
+}
+
+const uint64_t PerfCounters::getCount(std::size_t stage, std::size_t event) const
+{
+    if ( ( stage >= stages.size() ) || ( event >= NumEvents ) )
+        return 0;
+
+    return stages[stage].counts[event].load(std::memory_order_relaxed);
+}
+
+const std::size_t PerfCounters::getNumStages() const
+{
+    return stages.size();
+}
+
+bool PerfCounters::open()
+{
+    // Event definitions, in the same order as the 'Event' enum
+    const uint32_t types[NumEvents] =
+    {
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HW_CACHE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE
+    };
+
+    const uint64_t configs[NumEvents] =
+    {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_L1D | ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 ),
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    // All the counters are opened in one group, so that they are scheduled
+    // together and read with a single call. The first counter that can be
+    // opened is the group leader. Counters not supported by the CPU are skipped.
+    int      leader { -1 };
+    int      err    { 0 };
+    uint32_t mask   { 0 };
+    numOpen = 0;
+
+    for (std::size_t i{0}; i < NumEvents; ++i)
+    {
+        fds[i] = openEvent(types[i], configs[i], leader);
+
+        if ( -1 == fds[i] )
+        {
+            err = errno;
+            continue;
+        }
+
+        if ( -1 == leader )
+            leader = fds[i];
+
+        position[i] = numOpen++;
+        mask |= ( 1u << i );
+    }
+
+    if ( -1 == leader )
+    {
+        eLog_->warning("Hardware performance counters are not available: %s. Check /proc/sys/kernel/perf_event_paranoid",
+            std::strerror(err));
+        return false;
+    }
+
+    if ( numOpen < NumEvents )
+    {
+        std::string missing;
+        for (std::size_t i{0}; i < NumEvents; ++i)
+            if ( ! ( mask & ( 1u << i ) ) )
+                missing += std::string(missing.empty() ? "" : ", ") + eventNames[i];
+
+        eLog_->warning("Some hardware performance counters are not available (%s): %s",
+            missing.c_str(), std::strerror(err));
+    }
+
+    ::ioctl(leader, PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP);
+    ::ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+    available.store(mask, std::memory_order_relaxed);
+    isOpen = true;
+
+    return true;
+}
+
+void PerfCounters::close()
+{
+    for (auto &fd : fds)
+    {
+        if ( -1 != fd )
+            ::close(fd);
+
+        fd = -1;
+    }
+
+    available.store(0, std::memory_order_relaxed);
+    isOpen  = false;
+    numOpen = 0;
+}
+
+bool PerfCounters::read(std::array<uint64_t, NumEvents>& values)
+{
+    // The group read format is the number of counters, followed by their values
+    uint64_t buf[1 + NumEvents];
+    int      leader { -1 };
+
+    for (auto const &fd : fds)
+    {
+        if ( -1 != fd )
+        {
+            leader = fd;
+            break;
+        }
+    }
+
+    if ( -1 == leader )
+        return false;
+
+    ssize_t n { ::read(leader, buf, sizeof(buf)) };
+    if ( ( n < static_cast<ssize_t>( sizeof(uint64_t) * ( 1 + numOpen ) ) ) || ( buf[0] != numOpen ) )
+        return false;
+
+    for (std::size_t i{0}; i < NumEvents; ++i)
+        values[i] = ( -1 != fds[i] ) ? buf[1 + position[i]] : 0;
+
+    return true;
+}
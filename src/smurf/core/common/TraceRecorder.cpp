@@ -0,0 +1,237 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Trace Recorder
+ * ----------------------------------------------------------------------------
+ * File          : TraceRecorder.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Trace Recorder Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include "smurf/core/common/TraceRecorder.h"
+
+TraceRecorder::TraceRecorder()
+:
+    enable(false),
+    head(0),
+    start(0),
+    eLog_(rogue::Logging::create("pysmurf.TraceRecorder"))
+{
+    for (auto &e : events)
+    {
+        e.seq    = 0;
+        e.frame  = 0;
+        e.source = 0;
+        e.begin  = 0;
+        e.end    = 0;
+    }
+}
+
+TraceRecorder& TraceRecorder::getInstance()
+{
+    // The recorder is never destroyed, so that the blocks can
+    // keep using it even if they are destroyed during the process exit.
+    static TraceRecorder* instance = new TraceRecorder();
+    return *instance;
+}
+
+uint16_t TraceRecorder::registerBlock(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(namesMutex);
+
+    std::size_t n { blockCnt[name]++ };
+
+    if ( n )
+        blockNames.push_back(name + "[" + std::to_string(n) + "]");
+    else
+        blockNames.push_back(name);
+
+    return static_cast<uint16_t>(blockNames.size() - 1);
+}
+
+void TraceRecorder::setBlockName(uint16_t block, const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(namesMutex);
+
+    if ( block < blockNames.size() )
+        blockNames[block] = name;
+}
+
+void TraceRecorder::record(uint16_t block, uint64_t frame, uint64_t begin, uint64_t end)
+{
+    uint64_t source { ( static_cast<uint64_t>(block) << 48 ) | getThreadId() };
+
+    uint64_t i { head.fetch_add(1, std::memory_order_relaxed) };
+    Event&   e { events[i & ( numEvents - 1 )] };
+
+    e.seq.store(2 * i + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    e.frame.store(frame, std::memory_order_relaxed);
+    e.source.store(source, std::memory_order_relaxed);
+    e.begin.store(begin, std::memory_order_relaxed);
+    e.end.store(end, std::memory_order_relaxed);
+
+    e.seq.store(2 * ( i + 1 ), std::memory_order_release);
+}
+
+const uint64_t TraceRecorder::getEventCnt() const
+{
+    return head.load(std::memory_order_relaxed) - start.load(std::memory_order_relaxed);
+}
+
+void TraceRecorder::clear()
+{
+    start.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+const std::string TraceRecorder::getJson() const
+{
+    uint64_t last  { head.load(std::memory_order_acquire) };
+    uint64_t first { start.load(std::memory_order_relaxed) };
+
+    if ( last - first > numEvents )
+        first = last - numEvents;
+
+    // The timestamps are written in microseconds, from the steady clock,
+    // and the process ID is used as the trace 'pid'.
+    std::string out { "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n" };
+    std::string pid { std::to_string(::getpid()) };
+    bool        sep { false };
+    char        buf[256];
+
+    std::vector<std::string>        blocks;
+    std::map<uint32_t, std::string> threads;
+    {
+        std::lock_guard<std::mutex> lock(namesMutex);
+        blocks  = blockNames;
+        threads = threadNames;
+    }
+
+    for (uint64_t i{first}; i < last; ++i)
+    {
+        const Event& e { events[i & ( numEvents - 1 )] };
+
+        // Read the event, and discard it if it was being written, or if it was overwritten
+        uint64_t s1     { e.seq.load(std::memory_order_acquire) };
+        uint64_t frame  { e.frame.load(std::memory_order_relaxed) };
+        uint64_t source { e.source.load(std::memory_order_relaxed) };
+        uint64_t begin  { e.begin.load(std::memory_order_relaxed) };
+        uint64_t end    { e.end.load(std::memory_order_relaxed) };
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t s2     { e.seq.load(std::memory_order_relaxed) };
+
+        if ( ( s1 != s2 ) || ( s1 != 2 * ( i + 1 ) ) )
+            continue;
+
+        std::size_t block { static_cast<std::size_t>(source >> 48) };
+        uint32_t    tid   { static_cast<uint32_t>(source) };
+
+        std::snprintf(buf, sizeof(buf),
+            "{\"ph\":\"X\",\"pid\":%s,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%llu},\"name\":",
+            pid.c_str(), tid, begin * 1e-3, ( end - begin ) * 1e-3, static_cast<unsigned long long>(frame));
+
+        if ( sep )
+            out += ",\n";
+
+        out += buf;
+        out += "\"" + escape( ( block < blocks.size() ) ? blocks[block] : "Unknown" ) + "\"}";
+        sep = true;
+    }
+
+    // Add the thread names as metadata events
+    for (auto const &t : threads)
+    {
+        if ( sep )
+            out += ",\n";
+
+        out += "{\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + std::to_string(t.first)
+            + ",\"name\":\"thread_name\",\"args\":{\"name\":\"" + escape(t.second) + "\"}}";
+        sep = true;
+    }
+
+    out += "\n]}\n";
+
+    return out;
+}
+
+bool TraceRecorder::dump(const std::string& fileName) const
+{
+    std::ofstream file(fileName);
+
+    if ( ! file.is_open() )
+    {
+        eLog_->error("Failed to open the trace file '%s'", fileName.c_str());
+        return false;
+    }
+
+    file << getJson();
+
+    if ( ! file.good() )
+    {
+        eLog_->error("Failed to write the trace file '%s'", fileName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+uint32_t TraceRecorder::getThreadId()
+{
+    thread_local uint32_t tid { 0 };
+
+    if ( 0 == tid )
+    {
+        tid = static_cast<uint32_t>( ::syscall(SYS_gettid) );
+
+        char name[32] { 0 };
+        if ( pthread_getname_np( pthread_self(), name, sizeof(name) ) )
+            name[0] = '\0';
+
+        std::lock_guard<std::mutex> lock(namesMutex);
+        threadNames[tid] = name;
+    }
+
+    return tid;
+}
+
+std::string TraceRecorder::escape(const std::string& s)
+{
+    std::string r;
+
+    for (auto const &c : s)
+    {
+        if ( ( '"' == c ) || ( '\\' == c ) )
+        {
+            r += '\\';
+            r += c;
+        }
+        else if ( static_cast<unsigned char>(c) < 0x20 )
+        {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            r += buf;
+        }
+        else
+        {
+            r += c;
+        }
+    }
+
+    return r;
+}
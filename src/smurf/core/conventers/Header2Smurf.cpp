@@ -30,7 +30,10 @@ scc::Header2Smurf::Header2Smurf()
     disable(false),
     tesBias(TesBiasArray<std::vector<uint8_t>::iterator>::TesBiasBufferSize, 0),
     tba(TesBiasArray<std::vector<uint8_t>::iterator>::create(tesBias.begin())),
-    eLog_(rogue::Logging::create("pysmurf.Header2Smurf"))
+    traceId(TraceRecorder::getInstance().registerBlock("Header2Smurf")),
+    eLog_(rogue::Logging::create("pysmurf.Header2Smurf")),
+    logBadFlags(eLog_, "frame with errors and/or flags"),
+    logBadSize(eLog_, "frame with wrong size")
 {
 }
 
@@ -49,6 +52,9 @@ void scc::Header2Smurf::setup_python()
         .def("setDisable", &Header2Smurf::setDisable)
         .def("getDisable", &Header2Smurf::getDisable)
         .def("setTesBias", &Header2Smurf::setTesBias)
+        .def("getSuppressedLogCnt", &Header2Smurf::getSuppressedLogCnt)
+        .def("clearSuppressedLogCnt", &Header2Smurf::clearSuppressedLogCnt)
+        .def("setTraceName", &Header2Smurf::setTraceName)
     ;
     bp::implicitly_convertible< scc::Header2SmurfPtr, ris::SlavePtr  >();
     bp::implicitly_convertible< scc::Header2SmurfPtr, ris::MasterPtr >();
@@ -64,6 +70,11 @@ const bool scc::Header2Smurf::getDisable() const
     return disable;
 }
 
+void scc::Header2Smurf::setTraceName(const std::string& name)
+{
+    TraceRecorder::getInstance().setBlockName(traceId, name);
+}
+
 void scc::Header2Smurf::setTesBias(std::size_t index, int32_t value)
 {
     // Hold the mutex while the data tesBias array is being written to.
@@ -72,6 +83,17 @@ void scc::Header2Smurf::setTesBias(std::size_t index, int32_t value)
     tba->setWord(index, value);
 }
 
+const std::size_t scc::Header2Smurf::getSuppressedLogCnt() const
+{
+    return logBadFlags.getSuppressedCnt() + logBadSize.getSuppressedCnt();
+}
+
+void scc::Header2Smurf::clearSuppressedLogCnt()
+{
+    logBadFlags.clearCnt();
+    logBadSize.clearCnt();
+}
+
 void scc::Header2Smurf::acceptFrame(ris::FramePtr frame)
 {
     rogue::GilRelease noGil;
@@ -79,10 +101,13 @@ void scc::Header2Smurf::acceptFrame(ris::FramePtr frame)
     // If the processing block is disabled, do not process the frame
     if (!disable)
     {
+        // Record the time spent on the frame, excluding the time spent by the next slaves
+        TraceScope trace(traceId);
+
         // Check for frames with errors or flags
         if (  frame->getError() || ( frame->getFlags() & 0x100 ) )
         {
-            eLog_->error("Received frame with errors and/or flags");
+            logBadFlags.error("Received frame with errors and/or flags");
             return;
         }
 
@@ -92,7 +117,7 @@ void scc::Header2Smurf::acceptFrame(ris::FramePtr frame)
         // Check for frames with size less than at least the header size
         if ( frameSize < SmurfHeaderRO<ris::FrameIterator>::SmurfHeaderSize )
         {
-            eLog_->error("Received frame with size lower than the header size. Received frame size=%zu, expected header size=%zu",
+            logBadSize.error("Received frame with size lower than the header size. Received frame size=%zu, expected header size=%zu",
                 frameSize, SmurfHeaderRO<ris::FrameIterator>::SmurfHeaderSize);
             return;
         }
@@ -100,6 +125,8 @@ void scc::Header2Smurf::acceptFrame(ris::FramePtr frame)
         // Create a SmurfHeader object on the frame
         SmurfHeaderPtr<ris::FrameIterator> smurfHeaderOut(SmurfHeader<ris::FrameIterator>::create(frame));
 
+        trace.setFrame(smurfHeaderOut->getFrameCounter());
+
         // Stet he protocol version
         smurfHeaderOut->setVersion(1);
 
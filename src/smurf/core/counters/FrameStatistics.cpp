@@ -19,6 +19,8 @@
 **/
 
 #include <boost/python.hpp>
+#include <cmath>
+#include <algorithm>
 #include "smurf/core/counters/FrameStatistics.h"
 
 namespace scc = smurf::core::counters;
@@ -28,18 +30,84 @@ scc::FrameStatistics::FrameStatistics()
     ris::Slave(),
     ris::Master(),
     disable(false),
-    frameCnt(0),
     frameSize(0),
+    lastArrival(0),
     firstFrame(true),
-    frameLossCnt(0),
-    frameOutOrderCnt(0),
-    badFrameCnt(0),
+    sourceCnt(0),
+    reorderDepth(0),
+    reorderTimeout(10000),
+    heldCnt(0),
+    nextNumber(0),
+    waitStart(0),
+    expectedPeriod(0),
+    period(0),
+    jitterTolerance(0),
+    framesPerMarker(0),
+    learnedPeriod(0),
+    learnCnt(0),
+    learnedFrames(0),
+    prevCounter2(0),
+    prevCounter0(0),
+    framesSinceMarker(0),
+    markerSeen(false),
+    missingReported(false),
     frameNumber(0),
     prevFrameNumber(0),
-    eLog_(rogue::Logging::create("pysmurf.FrameStatistics"))
+    traceId(TraceRecorder::getInstance().registerBlock("FrameStatistics")),
+    eLog_(rogue::Logging::create("pysmurf.FrameStatistics")),
+    logBadFlags(eLog_, "frame with errors and/or flags"),
+    logBadSize(eLog_, "frame with wrong size")
 {
+    for (std::size_t i{0}; i < NumCounters; ++i)
+    {
+        counters[i] = 0;
+        baseline[i] = 0;
+    }
+
+    for (std::size_t i{0}; i < maxSources; ++i)
+    {
+        sourceKey[i]    = 0;
+        sourceNumber[i] = 0;
+
+        for (std::size_t j{0}; j < NumSourceCounters; ++j)
+        {
+            sourceCounters[i][j] = 0;
+            sourceBaseline[i][j] = 0;
+        }
+    }
+}
+
+scc::FrameStatistics::~FrameStatistics()
+{
+    MetricsRegistry::getInstance().remove(this);
 }
 
+const char* scc::FrameStatistics::counterNames[scc::FrameStatistics::NumCounters] =
+{
+    "FrameCnt",
+    "FrameLossCnt",
+    "FrameOutOrderCnt",
+    "BadFrameCnt",
+    "ResyncCnt",
+    "Counter2JitterCnt",
+    "Counter2BackwardsCnt",
+    "Counter0ResetCnt",
+    "Counter0MissingResetCnt",
+    "ReorderCnt",
+    "ReorderLateCnt",
+    "ReorderTimeoutCnt",
+    "ReorderOverflowCnt",
+    "SourceOverflowCnt"
+};
+
+const char* scc::FrameStatistics::sourceCounterNames[scc::FrameStatistics::NumSourceCounters] =
+{
+    "FrameCnt",
+    "FrameLossCnt",
+    "FrameOutOrderCnt",
+    "ResyncCnt"
+};
+
 scc::FrameStatisticsPtr scc::FrameStatistics::create()
 {
     return std::make_shared<FrameStatistics>();
@@ -58,9 +126,57 @@ void scc::FrameStatistics::setup_python()
         .def("getFrameCnt",         &FrameStatistics::getFrameCnt)
         .def("getFrameSize",        &FrameStatistics::getFrameSize)
         .def("clearCnt",            &FrameStatistics::clearCnt)
+        .def("getSuppressedLogCnt", &FrameStatistics::getSuppressedLogCnt)
         .def("getFrameLossCnt",     &FrameStatistics::getFrameLossCnt)
         .def("getFrameOutOrderCnt", &FrameStatistics::getFrameOutOrderCnt)
         .def("getBadFrameCnt",      &FrameStatistics::getBadFrameCnt)
+        .def("getResyncCnt",        &FrameStatistics::getResyncCnt)
+        .def("getFrameRate",        &FrameStatistics::getFrameRate)
+        .def("getFrameRateAvg",     &FrameStatistics::getFrameRateAvg)
+        .def("getPeakFrameRate",    &FrameStatistics::getPeakFrameRate)
+        .def("getByteRate",         &FrameStatistics::getByteRate)
+        .def("getByteRateAvg",      &FrameStatistics::getByteRateAvg)
+        .def("getPeakByteRate",     &FrameStatistics::getPeakByteRate)
+        .def("getInterArrivalMin",  &FrameStatistics::getInterArrivalMin)
+        .def("getInterArrivalMax",  &FrameStatistics::getInterArrivalMax)
+        .def("getInterArrivalMean", &FrameStatistics::getInterArrivalMean)
+        .def("getInterArrivalPercentile", &FrameStatistics::getInterArrivalPercentile)
+        .def("setExpectedPeriod",   &FrameStatistics::setExpectedPeriod)
+        .def("getExpectedPeriod",   &FrameStatistics::getExpectedPeriod)
+        .def("getPeriod",           &FrameStatistics::getPeriod)
+        .def("setJitterTolerance",  &FrameStatistics::setJitterTolerance)
+        .def("getJitterTolerance",  &FrameStatistics::getJitterTolerance)
+        .def("setFramesPerMarker",  &FrameStatistics::setFramesPerMarker)
+        .def("getFramesPerMarker",  &FrameStatistics::getFramesPerMarker)
+        .def("getCounter2JitterCnt",       &FrameStatistics::getCounter2JitterCnt)
+        .def("getCounter2BackwardsCnt",    &FrameStatistics::getCounter2BackwardsCnt)
+        .def("getCounter0ResetCnt",        &FrameStatistics::getCounter0ResetCnt)
+        .def("getCounter0MissingResetCnt", &FrameStatistics::getCounter0MissingResetCnt)
+        .def("getJitterMax",        &FrameStatistics::getJitterMax)
+        .def("getJitterMean",       &FrameStatistics::getJitterMean)
+        .def("getJitterPercentile", &FrameStatistics::getJitterPercentile)
+        .def("setReorderDepth",     &FrameStatistics::setReorderDepth)
+        .def("getReorderDepth",     &FrameStatistics::getReorderDepth)
+        .def("setReorderTimeout",   &FrameStatistics::setReorderTimeout)
+        .def("getReorderTimeout",   &FrameStatistics::getReorderTimeout)
+        .def("getReorderCnt",         &FrameStatistics::getReorderCnt)
+        .def("getReorderLateCnt",     &FrameStatistics::getReorderLateCnt)
+        .def("getReorderTimeoutCnt",  &FrameStatistics::getReorderTimeoutCnt)
+        .def("getReorderOverflowCnt", &FrameStatistics::getReorderOverflowCnt)
+        .def("getMaxSources",             &FrameStatistics::getMaxSources)
+        .def("getSourceCnt",              &FrameStatistics::getSourceCnt)
+        .def("getSourceOverflowCnt",      &FrameStatistics::getSourceOverflowCnt)
+        .def("getSourceCrateId",          &FrameStatistics::getSourceCrateId)
+        .def("getSourceSlotNumber",       &FrameStatistics::getSourceSlotNumber)
+        .def("getSourceFrameCnt",         &FrameStatistics::getSourceFrameCnt)
+        .def("getSourceFrameLossCnt",     &FrameStatistics::getSourceFrameLossCnt)
+        .def("getSourceFrameOutOrderCnt", &FrameStatistics::getSourceFrameOutOrderCnt)
+        .def("getSourceResyncCnt",        &FrameStatistics::getSourceResyncCnt)
+        .def("getSourceFrameRate",        &FrameStatistics::getSourceFrameRate)
+        .def("getSourceByteRate",         &FrameStatistics::getSourceByteRate)
+        .def("getSnapshot",         &FrameStatistics::getSnapshot)
+        .def("registerMetrics",     &FrameStatistics::registerMetrics)
+        .def("setTraceName",        &FrameStatistics::setTraceName)
     ;
     bp::implicitly_convertible< scc::FrameStatisticsPtr, ris::SlavePtr  >();
     bp::implicitly_convertible< scc::FrameStatisticsPtr, ris::MasterPtr >();
@@ -78,35 +194,874 @@ const bool scc::FrameStatistics::getDisable() const
 
 const std::size_t scc::FrameStatistics::getFrameCnt() const
 {
-    return frameCnt;
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[FrameCnt];
 }
 
 const std::size_t scc::FrameStatistics::getFrameSize() const
 {
-    return frameSize;
+    return frameSize.load(std::memory_order_relaxed);
 }
 
 const std::size_t scc::FrameStatistics::getFrameLossCnt() const
 {
-    return frameLossCnt;
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[FrameLossCnt];
 }
 
 const std::size_t scc::FrameStatistics::getFrameOutOrderCnt() const
 {
-    return frameOutOrderCnt;
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[FrameOutOrderCnt];
 }
 
 const std::size_t scc::FrameStatistics::getBadFrameCnt() const
 {
-    return badFrameCnt;
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[BadFrameCnt];
+}
+
+const std::size_t scc::FrameStatistics::getResyncCnt() const
+{
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[ResyncCnt];
+}
+
+const double scc::FrameStatistics::getFrameRate() const
+{
+    return frameRate.getInstant();
+}
+
+const double scc::FrameStatistics::getFrameRateAvg(std::size_t w) const
+{
+    return frameRate.getAverage(w);
+}
+
+const double scc::FrameStatistics::getPeakFrameRate() const
+{
+    return frameRate.getPeak();
+}
+
+const double scc::FrameStatistics::getByteRate() const
+{
+    return byteRate.getInstant();
+}
+
+const double scc::FrameStatistics::getByteRateAvg(std::size_t w) const
+{
+    return byteRate.getAverage(w);
+}
+
+const double scc::FrameStatistics::getPeakByteRate() const
+{
+    return byteRate.getPeak();
+}
+
+const uint64_t scc::FrameStatistics::getInterArrivalMin() const
+{
+    return interArrival.getMin();
+}
+
+const uint64_t scc::FrameStatistics::getInterArrivalMax() const
+{
+    return interArrival.getMax();
+}
+
+const double scc::FrameStatistics::getInterArrivalMean() const
+{
+    return interArrival.getMean();
+}
+
+const uint64_t scc::FrameStatistics::getInterArrivalPercentile(double p) const
+{
+    return interArrival.getPercentile(p);
+}
+
+void scc::FrameStatistics::setExpectedPeriod(uint64_t p)
+{
+    expectedPeriod = p;
+}
+
+const uint64_t scc::FrameStatistics::getExpectedPeriod() const
+{
+    return expectedPeriod;
+}
+
+const double scc::FrameStatistics::getPeriod() const
+{
+    return period;
+}
+
+void scc::FrameStatistics::setJitterTolerance(uint64_t t)
+{
+    jitterTolerance = t;
+}
+
+const uint64_t scc::FrameStatistics::getJitterTolerance() const
+{
+    return jitterTolerance;
+}
+
+void scc::FrameStatistics::setFramesPerMarker(std::size_t n)
+{
+    framesPerMarker = n;
+}
+
+const std::size_t scc::FrameStatistics::getFramesPerMarker() const
+{
+    return framesPerMarker;
+}
+
+const std::size_t scc::FrameStatistics::getCounter2JitterCnt() const
+{
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[Counter2JitterCnt];
+}
+
+const std::size_t scc::FrameStatistics::getCounter2BackwardsCnt() const
+{
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[Counter2BackwardsCnt];
+}
+
+const std::size_t scc::FrameStatistics::getCounter0ResetCnt() const
+{
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[Counter0ResetCnt];
+}
+
+const std::size_t scc::FrameStatistics::getCounter0MissingResetCnt() const
+{
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[Counter0MissingResetCnt];
+}
+
+const uint64_t scc::FrameStatistics::getJitterMax() const
+{
+    return jitter.getMax();
+}
+
+const double scc::FrameStatistics::getJitterMean() const
+{
+    return jitter.getMean();
+}
+
+const uint64_t scc::FrameStatistics::getJitterPercentile(double p) const
+{
+    return jitter.getPercentile(p);
+}
+
+void scc::FrameStatistics::setReorderDepth(std::size_t d)
+{
+    // The window is resized by the stream thread, when the next frame arrives
+    reorderDepth = d;
+}
+
+const std::size_t scc::FrameStatistics::getReorderDepth() const
+{
+    return reorderDepth;
+}
+
+void scc::FrameStatistics::setReorderTimeout(std::size_t t)
+{
+    reorderTimeout = t;
+}
+
+const std::size_t scc::FrameStatistics::getReorderTimeout() const
+{
+    return reorderTimeout;
+}
+
+const std::size_t scc::FrameStatistics::getReorderCnt() const
+{
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[ReorderCnt];
+}
+
+const std::size_t scc::FrameStatistics::getReorderLateCnt() const
+{
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[ReorderLateCnt];
+}
+
+const std::size_t scc::FrameStatistics::getReorderTimeoutCnt() const
+{
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[ReorderTimeoutCnt];
+}
+
+const std::size_t scc::FrameStatistics::getReorderOverflowCnt() const
+{
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[ReorderOverflowCnt];
+}
+
+const std::size_t scc::FrameStatistics::getMaxSources() const
+{
+    return maxSources;
+}
+
+const std::size_t scc::FrameStatistics::getSourceCnt() const
+{
+    return sourceCnt;
+}
+
+const std::size_t scc::FrameStatistics::getSourceOverflowCnt() const
+{
+    CounterValues values;
+    std::size_t   size;
+    readCounters(values, size);
+    return values[SourceOverflowCnt];
+}
+
+const uint8_t scc::FrameStatistics::getSourceCrateId(std::size_t i) const
+{
+    if ( i >= getSourceCnt() )
+        return 0;
+
+    return sourceKey[i] >> 8;
+}
+
+const uint8_t scc::FrameStatistics::getSourceSlotNumber(std::size_t i) const
+{
+    if ( i >= getSourceCnt() )
+        return 0;
+
+    return sourceKey[i] & 0xff;
+}
+
+const std::size_t scc::FrameStatistics::getSourceFrameCnt(std::size_t i) const
+{
+    return readSourceCounter(i, SrcFrameCnt);
+}
+
+const std::size_t scc::FrameStatistics::getSourceFrameLossCnt(std::size_t i) const
+{
+    return readSourceCounter(i, SrcFrameLossCnt);
+}
+
+const std::size_t scc::FrameStatistics::getSourceFrameOutOrderCnt(std::size_t i) const
+{
+    return readSourceCounter(i, SrcFrameOutOrderCnt);
+}
+
+const std::size_t scc::FrameStatistics::getSourceResyncCnt(std::size_t i) const
+{
+    return readSourceCounter(i, SrcResyncCnt);
+}
+
+const double scc::FrameStatistics::getSourceFrameRate(std::size_t i) const
+{
+    if ( i >= getSourceCnt() )
+        return 0;
+
+    return sourceFrameRate[i].getInstant();
+}
+
+const double scc::FrameStatistics::getSourceByteRate(std::size_t i) const
+{
+    if ( i >= getSourceCnt() )
+        return 0;
+
+    return sourceByteRate[i].getInstant();
+}
+
+const bp::dict scc::FrameStatistics::getSnapshot() const
+{
+    CounterValues       values;
+    SourceCounterValues sourceValues;
+    std::size_t         size;
+    readCounters(values, size, &sourceValues);
+
+    bp::dict snapshot;
+    for (std::size_t i{0}; i < NumCounters; ++i)
+        snapshot[counterNames[i]] = values[i];
+
+    snapshot["FrameSize"] = size;
+
+    // Per-source counters. The sources are never removed from the table, so the
+    // sources added after the counters were read just show up with no frames.
+    bp::list sources;
+    std::size_t n { getSourceCnt() };
+    for (std::size_t i{0}; i < n; ++i)
+    {
+        bp::dict source;
+        source["CrateId"]    = getSourceCrateId(i);
+        source["SlotNumber"] = getSourceSlotNumber(i);
+
+        for (std::size_t j{0}; j < NumSourceCounters; ++j)
+            source[sourceCounterNames[j]] = sourceValues[i][j];
+
+        sources.append(source);
+    }
+
+    snapshot["Sources"] = sources;
+
+    return snapshot;
+}
+
+const std::size_t scc::FrameStatistics::getSuppressedLogCnt() const
+{
+    return logBadFlags.getSuppressedCnt() + logBadSize.getSuppressedCnt();
 }
 
 void scc::FrameStatistics::clearCnt()
 {
-    frameCnt         = 0;
-    frameLossCnt     = 0;
-    frameOutOrderCnt = 0;
-    badFrameCnt      = 0;
+    // The counters are only written by the stream thread, so they are not
+    // cleared here. Instead, their current values are taken as the new baseline.
+    std::lock_guard<std::mutex> lock(clearMutex);
+
+    CounterValues       raw;
+    SourceCounterValues sourceRaw;
+    uint32_t            seq;
+    do
+    {
+        seq = countersLock.readBegin();
+        for (std::size_t i{0}; i < NumCounters; ++i)
+            raw[i] = counters[i].load(std::memory_order_relaxed);
+
+        for (std::size_t i{0}; i < maxSources; ++i)
+            for (std::size_t j{0}; j < NumSourceCounters; ++j)
+                sourceRaw[i][j] = sourceCounters[i][j].load(std::memory_order_relaxed);
+    } while ( countersLock.readRetry(seq) );
+
+    baselineLock.writeBegin();
+    for (std::size_t i{0}; i < NumCounters; ++i)
+        baseline[i].store(raw[i], std::memory_order_relaxed);
+
+    for (std::size_t i{0}; i < maxSources; ++i)
+        for (std::size_t j{0}; j < NumSourceCounters; ++j)
+            sourceBaseline[i][j].store(sourceRaw[i][j], std::memory_order_relaxed);
+    baselineLock.writeEnd();
+
+    // Clear the peak rates and the inter-arrival histogram. The moving averages
+    // are not cleared, as they already forget the old values.
+    frameRate.clearPeak();
+    byteRate.clearPeak();
+    for (std::size_t i{0}; i < maxSources; ++i)
+    {
+        sourceFrameRate[i].clearPeak();
+        sourceByteRate[i].clearPeak();
+    }
+    interArrival.clear();
+    jitter.clear();
+
+    logBadFlags.clearCnt();
+    logBadSize.clearCnt();
+}
+
+void scc::FrameStatistics::setTraceName(const std::string& name)
+{
+    TraceRecorder::getInstance().setBlockName(traceId, name);
+}
+
+void scc::FrameStatistics::registerMetrics(const std::string& name)
+{
+    MetricsRegistry& registry { MetricsRegistry::getInstance() };
+
+    registry.remove(this);
+
+    // The counters are exported in a single family, with the counter name
+    // as label, using the same names used in the snapshot.
+    for (std::size_t i{0}; i < NumCounters; ++i)
+    {
+        registry.addCounter(this, "smurf_frame_statistics_total", "Frame statistics counters",
+            { { "block", name }, { "counter", counterNames[i] } },
+            [this, i]() -> double
+            {
+                CounterValues values;
+                std::size_t   size;
+                readCounters(values, size);
+                return values[i];
+            });
+    }
+
+    registry.addGauge(this, "smurf_frame_statistics_frame_size_bytes", "Size of the last received frame",
+        { { "block", name } }, [this]() -> double { return getFrameSize(); });
+
+    registry.addGauge(this, "smurf_frame_statistics_frame_rate", "Frame rate over the last 100ms (frames/s)",
+        { { "block", name } }, [this]() -> double { return getFrameRate(); });
+
+    registry.addGauge(this, "smurf_frame_statistics_byte_rate", "Data rate over the last 100ms (bytes/s)",
+        { { "block", name } }, [this]() -> double { return getByteRate(); });
+
+    registry.addGauge(this, "smurf_frame_statistics_sources", "Number of frame sources seen",
+        { { "block", name } }, [this]() -> double { return getSourceCnt(); });
+
+    registry.addCounter(this, "smurf_frame_statistics_suppressed_logs_total", "Number of log messages suppressed by the rate limiters",
+        { { "block", name } }, [this]() -> double { return getSuppressedLogCnt(); });
+
+    registry.addHistogram(this, "smurf_frame_statistics_inter_arrival_seconds", "Time between consecutive frames",
+        { { "block", name } }, &interArrival);
+}
+
+void scc::FrameStatistics::incCounter(Counter c, std::size_t n)
+{
+    // Only the stream thread writes the counters, so a read-modify-write
+    // operation is not needed here.
+    counters[c].store(counters[c].load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+bool scc::FrameStatistics::isResync(std::size_t number, std::size_t last) const
+{
+    std::size_t threshold { ( reorderRing.size() > resyncFrames ) ? reorderRing.size() : resyncFrames };
+
+    return ( number < last ) && ( last - number > threshold );
+}
+
+bool scc::FrameStatistics::checkFrame(std::size_t number, uint64_t counter2, uint32_t counter0)
+{
+    // Store the current and last frame numbers
+    // - Previous frame number
+    prevFrameNumber = frameNumber;  // Previous frame number
+
+    // - Current frame number
+    frameNumber = number;
+
+    // Check if we are missing frames, or receiving out-of-order frames
+    if (firstFrame)
+    {
+        // Don't compare the first frame
+        firstFrame = false;
+
+        checkTiming(counter2, counter0, 0);
+    }
+    else if ( isResync(frameNumber, prevFrameNumber) )
+    {
+        // The frame counter was reset, or it wrapped around. Start over from this frame,
+        // as all the following frames would be out-of-order otherwise.
+        incCounter(ResyncCnt);
+
+        checkTiming(counter2, counter0, 0);
+    }
+    else
+    {
+        // Discard out-of-order frames. The next frame is compared
+        // against the last in-order frame.
+        if ( frameNumber < prevFrameNumber )
+        {
+            incCounter(FrameOutOrderCnt);
+            frameNumber = prevFrameNumber;
+            return false;
+        }
+
+        // If we are missing frame, add the number of missing frames to the counter
+        std::size_t frameNumberDelta = frameNumber - prevFrameNumber - 1;
+        if ( frameNumberDelta )
+          incCounter(FrameLossCnt, frameNumberDelta);
+
+        // Check the firmware timing counters
+        checkTiming(counter2, counter0, frameNumberDelta + 1);
+    }
+
+    return true;
+}
+
+void scc::FrameStatistics::reorderFrame(ris::FramePtr frame, std::size_t number, uint64_t counter2, uint32_t counter0, uint64_t now)
+{
+    std::size_t depth { reorderRing.size() };
+
+    // The first frame sets the start of the sequence
+    if ( firstFrame )
+    {
+        checkFrame(number, counter2, counter0);
+        txFrames.push_back(frame);
+        nextNumber = number + 1;
+        return;
+    }
+
+    // If we have been waiting for a missing frame for too long, skip it
+    if ( heldCnt && ( ( now - waitStart ) >= 1000 * reorderTimeout.load(std::memory_order_relaxed) ) )
+    {
+        incCounter(ReorderTimeoutCnt);
+        skipMissing();
+        waitStart = now;
+    }
+
+    // If the frame counter was reset, or it wrapped around, release the held frames,
+    // which belong to the old sequence, and start over from this frame
+    if ( isResync(number, frameNumber) )
+    {
+        while ( heldCnt )
+            skipMissing();
+
+        checkFrame(number, counter2, counter0);
+        txFrames.push_back(frame);
+        nextNumber = number + 1;
+        return;
+    }
+
+    // Frames arriving after their position was already released are dropped
+    if ( number < nextNumber )
+    {
+        incCounter(ReorderLateCnt);
+        incCounter(FrameOutOrderCnt);
+        return;
+    }
+
+    // If the frame doesn't fit in the window, skip the missing frames until it does.
+    // If there are no held frames, the missing frames are considered lost.
+    while ( number >= nextNumber + depth )
+    {
+        if ( ! heldCnt )
+        {
+            nextNumber = number;
+            break;
+        }
+
+        incCounter(ReorderOverflowCnt);
+        skipMissing();
+        waitStart = now;
+    }
+
+    if ( number == nextNumber )
+    {
+        // This is the next frame in order; release it together
+        // with the held frames which follow it.
+        checkFrame(number, counter2, counter0);
+        txFrames.push_back(frame);
+        ++nextNumber;
+
+        releaseReady();
+
+        // If there are still held frames, start waiting for the next missing one
+        waitStart = now;
+    }
+    else
+    {
+        // The frame arrived ahead of a missing frame. Hold it.
+        ReorderSlot &slot { reorderRing[number % depth] };
+
+        // A frame with the same number is already being held
+        if ( slot.frame )
+        {
+            incCounter(ReorderLateCnt);
+            incCounter(FrameOutOrderCnt);
+            return;
+        }
+
+        if ( ! heldCnt )
+            waitStart = now;
+
+        slot.frame       = frame;
+        slot.frameNumber = number;
+        slot.counter2    = counter2;
+        slot.counter0    = counter0;
+        ++heldCnt;
+
+        incCounter(ReorderCnt);
+    }
+}
+
+void scc::FrameStatistics::releaseReady()
+{
+    std::size_t depth { reorderRing.size() };
+
+    while ( heldCnt )
+    {
+        ReorderSlot &slot { reorderRing[nextNumber % depth] };
+
+        if ( ( ! slot.frame ) || ( slot.frameNumber != nextNumber ) )
+            break;
+
+        checkFrame(slot.frameNumber, slot.counter2, slot.counter0);
+        txFrames.push_back(slot.frame);
+        slot.frame.reset();
+        --heldCnt;
+        ++nextNumber;
+    }
+}
+
+void scc::FrameStatistics::skipMissing()
+{
+    std::size_t depth { reorderRing.size() };
+
+    // Look for the next held frame. The missing frames are counted
+    // as lost when the held frame is checked.
+    for (std::size_t i{1}; i < depth; ++i)
+    {
+        ReorderSlot &slot { reorderRing[(nextNumber + i) % depth] };
+
+        if ( slot.frame && ( slot.frameNumber == nextNumber + i ) )
+        {
+            nextNumber += i;
+            break;
+        }
+    }
+
+    releaseReady();
+}
+
+void scc::FrameStatistics::flushReorder(std::size_t depth)
+{
+    // Release all the held frames, in order
+    while ( heldCnt )
+        skipMissing();
+
+    // Without the window, only the checks follow the frame numbers (including a
+    // resync), so start the window again after the last checked frame
+    if ( ! firstFrame )
+        nextNumber = frameNumber + 1;
+
+    // Resize the window, and make room for the frames which can be released at once
+    std::vector<ReorderSlot>(depth).swap(reorderRing);
+    txFrames.reserve(depth + 1);
+}
+
+void scc::FrameStatistics::checkTiming(uint64_t counter2, uint32_t counter0, std::size_t steps)
+{
+    // On the first frame, just initialize the state
+    if ( 0 == steps )
+    {
+        prevCounter2      = counter2;
+        prevCounter0      = counter0;
+        framesSinceMarker = 0;
+        markerSeen        = false;
+        missingReported   = false;
+        return;
+    }
+
+    // Check the counter2 increment. If frames were lost, the increment
+    // is divided by the number of frame periods.
+    if ( counter2 <= prevCounter2 )
+    {
+        incCounter(Counter2BackwardsCnt);
+    }
+    else
+    {
+        double   delta    { static_cast<double>( counter2 - prevCounter2 ) / steps };
+        uint64_t expected { expectedPeriod.load(std::memory_order_relaxed) };
+
+        // Use the expected increment as reference, or learn it. The learned increment is
+        // seeded with the median of the first increments, so that a single glitch at the
+        // start doesn't become the reference. The increments are not checked meanwhile.
+        if ( ( 0 == expected ) && ( 0 == learnedPeriod ) )
+        {
+            learnDeltas[learnCnt++] = delta;
+
+            if ( learnCnt == learnFrames )
+            {
+                std::nth_element(learnDeltas.begin(), learnDeltas.begin() + learnFrames / 2, learnDeltas.end());
+                learnedPeriod = learnDeltas[learnFrames / 2];
+                learnCnt      = 0;
+            }
+        }
+        else
+        {
+            double ref { expected ? static_cast<double>(expected) : learnedPeriod };
+            period.store(ref, std::memory_order_relaxed);
+
+            uint64_t dev { static_cast<uint64_t>( std::llround( std::fabs( delta - ref ) ) ) };
+            jitter.record(dev);
+
+            uint64_t tolerance { jitterTolerance.load(std::memory_order_relaxed) };
+            if ( tolerance && ( dev > tolerance ) )
+                incCounter(Counter2JitterCnt);
+            else if ( 0 == expected )
+                // Follow slow changes of the increment, excluding the anomalies
+                learnedPeriod += ( delta - learnedPeriod ) / 1024;
+        }
+    }
+
+    prevCounter2 = counter2;
+
+    // Check the counter0 resets, which happen on the 1Hz markers
+    framesSinceMarker += steps;
+
+    std::size_t expectedFrames { framesPerMarker.load(std::memory_order_relaxed) };
+    if ( 0 == expectedFrames )
+        expectedFrames = learnedFrames;
+
+    if ( counter0 < prevCounter0 )
+    {
+        // Only complete intervals are checked. Allow a difference of
+        // one frame, as the frame rate might not be a multiple of 1Hz.
+        if ( markerSeen )
+        {
+            if ( 0 == expectedFrames )
+                learnedFrames = framesSinceMarker;
+            else if ( ( framesSinceMarker + 1 < expectedFrames ) || ( framesSinceMarker > expectedFrames + 1 ) )
+                incCounter(Counter0ResetCnt);
+        }
+
+        markerSeen        = true;
+        missingReported   = false;
+        framesSinceMarker = 0;
+    }
+    else if ( markerSeen && expectedFrames && ( ! missingReported ) && ( framesSinceMarker > 2 * expectedFrames ) )
+    {
+        // Count a missing marker only once, until the next marker is received
+        incCounter(Counter0MissingResetCnt);
+        missingReported = true;
+    }
+
+    prevCounter0 = counter0;
+}
+
+void scc::FrameStatistics::incSourceCounter(std::size_t i, SourceCounter c, std::size_t n)
+{
+    sourceCounters[i][c].store(sourceCounters[i][c].load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+const std::size_t scc::FrameStatistics::readSourceCounter(std::size_t i, SourceCounter c) const
+{
+    if ( i >= maxSources )
+        return 0;
+
+    uint32_t    seq, baseSeq;
+    std::size_t value;
+
+    do
+    {
+        seq     = countersLock.readBegin();
+        baseSeq = baselineLock.readBegin();
+
+        value = sourceCounters[i][c].load(std::memory_order_relaxed) - sourceBaseline[i][c].load(std::memory_order_relaxed);
+    } while ( countersLock.readRetry(seq) || baselineLock.readRetry(baseSeq) );
+
+    return value;
+}
+
+scc::FrameStatistics::SourceCheck scc::FrameStatistics::updateSource(uint8_t crate, uint8_t slot, std::size_t number, std::size_t size, uint64_t now)
+{
+    uint16_t    key { static_cast<uint16_t>( ( crate << 8 ) | slot ) };
+    std::size_t n   { sourceCnt.load(std::memory_order_relaxed) };
+    std::size_t i   { 0 };
+    SourceCheck check { 0, SrcNew, 0 };
+
+    // Look for the source in the table
+    while ( ( i < n ) && ( sourceKey[i].load(std::memory_order_relaxed) != key ) )
+        ++i;
+
+    if ( i == n )
+    {
+        // This is a new source. Add it to the table, if there is room for it.
+        if ( n == maxSources )
+        {
+            incCounter(SourceOverflowCnt);
+            check.index  = maxSources;
+            check.status = SrcUnknown;
+            return check;
+        }
+
+        sourceKey[i].store(key, std::memory_order_relaxed);
+        sourceCnt.store(n + 1, std::memory_order_release);
+    }
+    else
+    {
+        // Check the frame number against the previous in-order frame from the same source
+        std::size_t prev { sourceNumber[i] };
+
+        if ( isResync(number, prev) )
+        {
+            // The frame counter of this source was reset, or it wrapped around. Start over from this frame.
+            incSourceCounter(i, SrcResyncCnt);
+            check.status = SrcResync;
+        }
+        else if ( number < prev )
+        {
+            // The next frame is compared against the last in-order frame
+            incSourceCounter(i, SrcFrameOutOrderCnt);
+            check.status = SrcOutOfOrder;
+        }
+        else
+        {
+            if ( number > prev + 1 )
+                incSourceCounter(i, SrcFrameLossCnt, number - prev - 1);
+
+            check.status = SrcInOrder;
+            check.steps  = number - prev;
+        }
+    }
+
+    if ( SrcOutOfOrder != check.status )
+        sourceNumber[i] = number;
+
+    incSourceCounter(i, SrcFrameCnt);
+    sourceFrameRate[i].update(now, 1);
+    sourceByteRate[i].update(now, size);
+
+    check.index = i;
+    return check;
+}
+
+bool scc::FrameStatistics::checkSourceFrame(const SourceCheck& src, uint64_t counter2, uint32_t counter0)
+{
+    switch ( src.status )
+    {
+        case SrcOutOfOrder:
+            incCounter(FrameOutOrderCnt);
+            return false;
+
+        case SrcResync:
+            incCounter(ResyncCnt);
+            break;
+
+        case SrcInOrder:
+            if ( src.steps > 1 )
+                incCounter(FrameLossCnt, src.steps - 1);
+            break;
+
+        default:
+            // New sources, and sources which didn't fit in the table
+            break;
+    }
+
+    // The timing counters of different sources are not related, so they are only
+    // checked on the frames from the first source, which is always in the table.
+    if ( 0 == src.index )
+        checkTiming(counter2, counter0, ( SrcInOrder == src.status ) ? src.steps : 0);
+
+    return true;
+}
+
+void scc::FrameStatistics::readCounters(CounterValues& values, std::size_t& size, SourceCounterValues* sources) const
+{
+    uint32_t seq, baseSeq;
+
+    // Read the counters and their baselines, and retry if any of them was
+    // modified while reading them.
+    do
+    {
+        seq     = countersLock.readBegin();
+        baseSeq = baselineLock.readBegin();
+
+        for (std::size_t i{0}; i < NumCounters; ++i)
+            values[i] = counters[i].load(std::memory_order_relaxed) - baseline[i].load(std::memory_order_relaxed);
+
+        size = frameSize.load(std::memory_order_relaxed);
+
+        if ( sources )
+            for (std::size_t i{0}; i < maxSources; ++i)
+                for (std::size_t j{0}; j < NumSourceCounters; ++j)
+                    (*sources)[i][j] = sourceCounters[i][j].load(std::memory_order_relaxed) - sourceBaseline[i][j].load(std::memory_order_relaxed);
+    } while ( countersLock.readRetry(seq) || baselineLock.readRetry(baseSeq) );
 }
 
 void scc::FrameStatistics::acceptFrame(ris::FramePtr frame)
@@ -116,35 +1071,55 @@ void scc::FrameStatistics::acceptFrame(ris::FramePtr frame)
     // Only process the frame is the block is enable.
     if (!disable)
     {
+        // Record the time spent on the frame, excluding the time spent by the next slaves
+        TraceScope trace(traceId);
+
         // Acquire lock on frame.
         ris::FrameLockPtr lock{frame->lock()};
 
+        // Update the rate meters and the inter-arrival histogram. All the
+        // received frames are included, even the bad ones.
+        uint64_t now { helpers::getTimeNS() };
+
+        frameRate.update(now, 1);
+        byteRate.update(now, frame->getPayload());
+
+        if ( lastArrival )
+            interArrival.record(now - lastArrival);
+
+        lastArrival = now;
+
         // Check for errors in the frame:
 
         // - Check for frames with errors or flags
         if (  frame->getError() || ( frame->getFlags() & 0x100 ) )
         {
             // Log error
-            eLog_->warning("Received frame with errors and/or flags");
+            logBadFlags.warning("Received frame with errors and/or flags");
 
             // Increase bad frame counter
-            ++badFrameCnt;
+            countersLock.writeBegin();
+            incCounter(BadFrameCnt);
+            countersLock.writeEnd();
 
             return;
         }
 
         // Get the frame size
-        frameSize = frame->getPayload();
+        std::size_t size { frame->getPayload() };
+        frameSize.store(size, std::memory_order_relaxed);
 
         // - Check for frames with size less than at least the header size
-        if ( frameSize < SmurfHeaderRO<ris::FrameIterator>::SmurfHeaderSize )
+        if ( size < SmurfHeaderRO<ris::FrameIterator>::SmurfHeaderSize )
         {
             // Log error
-            eLog_->warning("Received frame with size lower than the header size. Receive frame size=%zu, expected header size=%zu",
-                frameSize, SmurfHeaderRO<ris::FrameIterator>::SmurfHeaderSize);
+            logBadSize.warning("Received frame with size lower than the header size. Receive frame size=%zu, expected header size=%zu",
+                size, SmurfHeaderRO<ris::FrameIterator>::SmurfHeaderSize);
 
             // Increase bad frame counter
-            ++badFrameCnt;
+            countersLock.writeBegin();
+            incCounter(BadFrameCnt);
+            countersLock.writeEnd();
 
             return;
         }
@@ -160,52 +1135,84 @@ void scc::FrameStatistics::acceptFrame(ris::FramePtr frame)
         // - Now we can get the number of channels from the header and check if the total frame size is correct.
         //   The frame should have at least enough room to hold the number of channels defined in its header.
         //   Padded frames are allowed.
-        if ( ( SmurfHeaderRO<ris::FrameIterator>::SmurfHeaderSize + ( numChannels * sizeof(fw_t) ) ) > frameSize )
+        if ( ( SmurfHeaderRO<ris::FrameIterator>::SmurfHeaderSize + ( numChannels * sizeof(fw_t) ) ) > size )
         {
             // Log error
-            eLog_->warning("Received frame does not match expected size. Received frame size=%zu. Minimum expected size: header=%zu + payload=%i",
-                        frameSize, smurfHeaderIn->SmurfHeaderSize, numChannels * sizeof(fw_t));
+            logBadSize.warning("Received frame does not match expected size. Received frame size=%zu. Minimum expected size: header=%zu + payload=%i",
+                        size, smurfHeaderIn->SmurfHeaderSize, numChannels * sizeof(fw_t));
 
             // Increase bad frame counter
-            ++badFrameCnt;
+            countersLock.writeBegin();
+            incCounter(BadFrameCnt);
+            countersLock.writeEnd();
 
             return;
         }
 
         // At this point the frame is valid
+        std::size_t number   { smurfHeaderIn->getFrameCounter() };
+        uint64_t    counter2 { smurfHeaderIn->getCounter2() };
+        uint32_t    counter0 { smurfHeaderIn->getCounter0() };
+
+        trace.setFrame(number);
+
+        // Update all the counters inside the sequence lock, so that the
+        // readers always get a consistent copy of them.
+        countersLock.writeBegin();
 
         // Update the frame counter
-        ++frameCnt;
+        incCounter(FrameCnt);
 
-        // Store the current and last frame numbers
-        // - Previous frame number
-        prevFrameNumber = frameNumber;  // Previous frame number
+        // Update the statistics of the source of this frame
+        SourceCheck src { updateSource(smurfHeaderIn->getCrateID(), smurfHeaderIn->getSlotNumber(), number, size, now) };
 
-        // - Current frame number
-        frameNumber = smurfHeaderIn->getFrameCounter();
+        // Resize the reorder window if requested, releasing the frames being held
+        std::size_t depth { reorderDepth.load(std::memory_order_relaxed) };
+        if ( depth != reorderRing.size() )
+            flushReorder(depth);
 
-        // Check if we are missing frames, or receiving out-of-order frames
-        if (firstFrame)
+        if ( sourceCnt.load(std::memory_order_relaxed) > 1 )
         {
-            // Don't compare the first frame
-            firstFrame = false;
+            // Merged streams: the frame numbers of different sources are not related, so
+            // the frames are checked against the previous frame from the same source. The
+            // frames held in the reorder window, from the first source, are released first.
+            if ( heldCnt )
+                flushReorder(depth);
+
+            if ( checkSourceFrame(src, counter2, counter0) )
+                txFrames.push_back(frame);
+        }
+        else if ( depth )
+        {
+            // Pass the frame through the reorder window
+            reorderFrame(frame, number, counter2, counter0, now);
         }
         else
         {
-            // Discard out-of-order frames
-            if ( frameNumber < prevFrameNumber )
-            {
-                ++frameOutOrderCnt;
-                return;
-            }
+            // Check the frame number and timing counters, and discard out-of-order frames
+            if ( checkFrame(number, counter2, counter0) )
+                txFrames.push_back(frame);
+        }
 
-            // If we are missing frame, add the number of missing frames to the counter
-            std::size_t frameNumberDelta = frameNumber - prevFrameNumber - 1;
-            if ( frameNumberDelta )
-              frameLossCnt += frameNumberDelta;
+        countersLock.writeEnd();
+    }
+    else
+    {
+        // Release the frames held in the reorder window before
+        // sending the frame received while disabled.
+        if ( heldCnt )
+        {
+            countersLock.writeBegin();
+            flushReorder(reorderRing.size());
+            countersLock.writeEnd();
         }
+
+        txFrames.push_back(frame);
     }
 
-    // Send the frame to the next slave.
-    sendFrame(frame);
+    // Send the frames to the next slave.
+    for (auto const &f : txFrames)
+        sendFrame(f);
+
+    txFrames.clear();
 }
@@ -0,0 +1,237 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Latency Probe
+ * ----------------------------------------------------------------------------
+ * File          : LatencyProbe.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Latency Probe Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <boost/python.hpp>
+#include <chrono>
+#include "smurf/core/counters/LatencyProbe.h"
+
+namespace scc = smurf::core::counters;
+
+scc::LatencyProbe::LatencyProbe()
+:
+    ris::Slave(),
+    ris::Master(),
+    disable(false),
+    source(static_cast<int>(TimeSource::UnixTimeSteady)),
+    badFrameCnt(0),
+    negativeCnt(0),
+    last(0),
+    eLog_(rogue::Logging::create("pysmurf.LatencyProbe"))
+{
+}
+
+scc::LatencyProbe::~LatencyProbe()
+{
+    MetricsRegistry::getInstance().remove(this);
+}
+
+scc::LatencyProbePtr scc::LatencyProbe::create()
+{
+    return std::make_shared<LatencyProbe>();
+}
+
+// Setup Class in python
+void scc::LatencyProbe::setup_python()
+{
+    bp::class_< scc::LatencyProbe,
+                scc::LatencyProbePtr,
+                bp::bases<ris::Slave,ris::Master>,
+                boost::noncopyable >
+                ("LatencyProbe", bp::init<>())
+        .def("setDisable",     &LatencyProbe::setDisable)
+        .def("getDisable",     &LatencyProbe::getDisable)
+        .def("setSource",      &LatencyProbe::setSource)
+        .def("getSource",      &LatencyProbe::getSource)
+        .def("getFrameCnt",    &LatencyProbe::getFrameCnt)
+        .def("getBadFrameCnt", &LatencyProbe::getBadFrameCnt)
+        .def("getNegativeCnt", &LatencyProbe::getNegativeCnt)
+        .def("getLast",        &LatencyProbe::getLast)
+        .def("getMin",         &LatencyProbe::getMin)
+        .def("getMax",         &LatencyProbe::getMax)
+        .def("getMean",        &LatencyProbe::getMean)
+        .def("getPercentile",  &LatencyProbe::getPercentile)
+        .def("clearCnt",       &LatencyProbe::clearCnt)
+        .def("registerMetrics", &LatencyProbe::registerMetrics)
+    ;
+    bp::implicitly_convertible< scc::LatencyProbePtr, ris::SlavePtr  >();
+    bp::implicitly_convertible< scc::LatencyProbePtr, ris::MasterPtr >();
+}
+
+void scc::LatencyProbe::setDisable(bool d)
+{
+    disable = d;
+}
+
+const bool scc::LatencyProbe::getDisable() const
+{
+    return disable;
+}
+
+void scc::LatencyProbe::setSource(int s)
+{
+    // Verify that the source is in range
+    if ( ( s < 0 ) || ( s >= static_cast<int>(TimeSource::Size) ) )
+    {
+        eLog_->error("Invalid timestamp source = %i", s);
+        return;
+    }
+
+    source = s;
+
+    // The latencies measured with different sources are not comparable
+    clearCnt();
+}
+
+const int scc::LatencyProbe::getSource() const
+{
+    return source;
+}
+
+const std::size_t scc::LatencyProbe::getFrameCnt() const
+{
+    return histogram.getCount();
+}
+
+const std::size_t scc::LatencyProbe::getBadFrameCnt() const
+{
+    return badFrameCnt;
+}
+
+const std::size_t scc::LatencyProbe::getNegativeCnt() const
+{
+    return negativeCnt;
+}
+
+const uint64_t scc::LatencyProbe::getLast() const
+{
+    return last;
+}
+
+const uint64_t scc::LatencyProbe::getMin() const
+{
+    return histogram.getMin();
+}
+
+const uint64_t scc::LatencyProbe::getMax() const
+{
+    return histogram.getMax();
+}
+
+const double scc::LatencyProbe::getMean() const
+{
+    return histogram.getMean();
+}
+
+const uint64_t scc::LatencyProbe::getPercentile(double p) const
+{
+    return histogram.getPercentile(p);
+}
+
+void scc::LatencyProbe::clearCnt()
+{
+    badFrameCnt = 0;
+    negativeCnt = 0;
+    last        = 0;
+    histogram.clear();
+}
+
+void scc::LatencyProbe::registerMetrics(const std::string& name)
+{
+    MetricsRegistry& registry { MetricsRegistry::getInstance() };
+
+    registry.remove(this);
+
+    registry.addCounter(this, "smurf_latency_probe_bad_frames_total", "Number of bad frames",
+        { { "block", name } }, [this]() -> double { return getBadFrameCnt(); });
+
+    registry.addCounter(this, "smurf_latency_probe_negative_total", "Number of frames with timestamps in the future",
+        { { "block", name } }, [this]() -> double { return getNegativeCnt(); });
+
+    registry.addGauge(this, "smurf_latency_probe_last_seconds", "Last measured latency",
+        { { "block", name } }, [this]() -> double { return getLast() * 1e-9; });
+
+    registry.addHistogram(this, "smurf_latency_probe_latency_seconds", "Frame latency",
+        { { "block", name } }, &histogram);
+}
+
+uint64_t scc::LatencyProbe::getRealtimeNS()
+{
+    return std::chrono::time_point_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now()).time_since_epoch().count();
+}
+
+void scc::LatencyProbe::acceptFrame(ris::FramePtr frame)
+{
+    rogue::GilRelease noGil;
+
+    // Only process the frame is the block is enable.
+    if (!disable)
+    {
+        // Acquire lock on frame.
+        ris::FrameLockPtr lock{frame->lock()};
+
+        // Check for frames with errors or flags, or without a complete header
+        if ( frame->getError() || ( frame->getFlags() & 0x100 ) ||
+             ( frame->getPayload() < SmurfHeaderRO<ris::FrameIterator>::SmurfHeaderSize ) )
+        {
+            ++badFrameCnt;
+        }
+        else
+        {
+            SmurfHeaderROPtr<ris::FrameIterator> header(SmurfHeaderRO<ris::FrameIterator>::create(frame));
+
+            // Read the timestamp and the local clock
+            uint64_t t, now;
+            switch ( static_cast<TimeSource>(source.load()) )
+            {
+                case TimeSource::UnixTimeRealtime:
+                    t   = header->getUnixTime();
+                    now = getRealtimeNS();
+                    break;
+                case TimeSource::Counter2Realtime:
+                {
+                    uint64_t c { header->getCounter2() };
+                    t   = ( c >> 32 ) * 1000000000ULL + ( c & 0xffffffff );
+                    now = getRealtimeNS();
+                    break;
+                }
+                default:
+                    t   = header->getUnixTime();
+                    now = helpers::getTimeNS();
+                    break;
+            }
+
+            // Timestamps in the future can not be added to the histogram. This
+            // usually means that the clocks used are not synchronized.
+            if ( t > now )
+            {
+                ++negativeCnt;
+            }
+            else
+            {
+                last = now - t;
+                histogram.record(now - t);
+            }
+        }
+    }
+
+    // Send the frame to the next slave.
+    sendFrame(frame);
+}
@@ -21,6 +21,7 @@
 #include <boost/python.hpp>
 #include "smurf/core/counters/module.h"
 #include "smurf/core/counters/FrameStatistics.h"
+#include "smurf/core/counters/LatencyProbe.h"
 
 namespace bp  = boost::python;
 namespace scc = smurf::core::counters;
@@ -37,4 +38,5 @@ void scc::setup_module()
     bp::scope io_scope = module;
 
     scc::FrameStatistics::setup_python();
+    scc::LatencyProbe::setup_python();
 }
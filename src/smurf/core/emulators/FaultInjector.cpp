@@ -0,0 +1,375 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Fault Injector
+ * ----------------------------------------------------------------------------
+ * File          : FaultInjector.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Fault Injector Class
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <boost/python.hpp>
+#include <unistd.h>
+#include "smurf/core/emulators/FaultInjector.h"
+
+namespace sce = smurf::core::emulators;
+namespace ris = rogue::interfaces::stream;
+
+sce::FaultInjector::FaultInjector()
+:
+    ris::Slave(),
+    ris::Master(),
+    eLog_(rogue::Logging::create("pysmurf.FaultInjector")),
+    disable_(true),
+    periodic_(false),
+    delay_(1000),
+    burstSize_(10),
+    frameCnt_(0),
+    lastFaultTime_(0),
+    burstCnt_(0),
+    gen(rd()),
+    dis(0.0, 1.0)
+{
+    rate_.fill(0);
+    acc_.fill(0);
+    for (auto &c : faultCnt_)
+        c = 0;
+}
+
+sce::FaultInjector::~FaultInjector()
+{
+    MetricsRegistry::getInstance().remove(this);
+}
+
+sce::FaultInjectorPtr sce::FaultInjector::create()
+{
+    return std::make_shared<FaultInjector>();
+}
+
+// Setup Class in python
+void sce::FaultInjector::setup_python()
+{
+    bp::class_< sce::FaultInjector,
+                sce::FaultInjectorPtr,
+                bp::bases<ris::Slave,ris::Master>,
+                boost::noncopyable >
+                ("FaultInjector", bp::init<>())
+        .def("setDisable",       &FaultInjector::setDisable)
+        .def("getDisable",       &FaultInjector::getDisable)
+        .def("setPeriodic",      &FaultInjector::setPeriodic)
+        .def("getPeriodic",      &FaultInjector::getPeriodic)
+        .def("setRate",          &FaultInjector::setRate)
+        .def("getRate",          &FaultInjector::getRate)
+        .def("setDelay",         &FaultInjector::setDelay)
+        .def("getDelay",         &FaultInjector::getDelay)
+        .def("setBurstSize",     &FaultInjector::setBurstSize)
+        .def("getBurstSize",     &FaultInjector::getBurstSize)
+        .def("getFaultCnt",      &FaultInjector::getFaultCnt)
+        .def("getFrameCnt",      &FaultInjector::getFrameCnt)
+        .def("getLastFaultTime", &FaultInjector::getLastFaultTime)
+        .def("clearCnt",         &FaultInjector::clearCnt)
+        .def("registerMetrics",  &FaultInjector::registerMetrics)
+    ;
+    bp::implicitly_convertible< sce::FaultInjectorPtr, ris::SlavePtr  >();
+    bp::implicitly_convertible< sce::FaultInjectorPtr, ris::MasterPtr >();
+}
+
+void sce::FaultInjector::setDisable(bool d)
+{
+    disable_ = d;
+}
+
+const bool sce::FaultInjector::getDisable() const
+{
+    return disable_;
+}
+
+void sce::FaultInjector::setPeriodic(bool p)
+{
+    // Take the mutex before changing the parameters
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    periodic_ = p;
+
+    // Restart the periodic schedules
+    acc_.fill(0);
+}
+
+const bool sce::FaultInjector::getPeriodic() const
+{
+    return periodic_;
+}
+
+void sce::FaultInjector::setRate(std::size_t fault, double value)
+{
+    // Verify that the fault type and the rate are in range
+    if ( ( fault >= numFaults ) || ( value < 0 ) || ( value > 1 ) )
+    {
+        eLog_->error("Invalid fault rate. Fault type=%zu (maximum=%zu), rate=%f (allowed range=[0, 1])",
+            fault, numFaults - 1, value);
+        return;
+    }
+
+    // Take the mutex before changing the parameters
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    rate_.at(fault) = value;
+    acc_.at(fault)  = 0;
+}
+
+const double sce::FaultInjector::getRate(std::size_t fault) const
+{
+    if ( fault >= numFaults )
+        return 0;
+
+    return rate_.at(fault);
+}
+
+void sce::FaultInjector::setDelay(std::size_t value)
+{
+    delay_ = value;
+}
+
+const std::size_t sce::FaultInjector::getDelay() const
+{
+    return delay_;
+}
+
+void sce::FaultInjector::setBurstSize(std::size_t value)
+{
+    // The burst size must be at least 1
+    if (value)
+        burstSize_ = value;
+}
+
+const std::size_t sce::FaultInjector::getBurstSize() const
+{
+    return burstSize_;
+}
+
+const std::size_t sce::FaultInjector::getFaultCnt(std::size_t fault) const
+{
+    if ( fault >= numFaults )
+        return 0;
+
+    return faultCnt_.at(fault);
+}
+
+const std::size_t sce::FaultInjector::getFrameCnt() const
+{
+    return frameCnt_;
+}
+
+const uint64_t sce::FaultInjector::getLastFaultTime() const
+{
+    return lastFaultTime_;
+}
+
+void sce::FaultInjector::clearCnt()
+{
+    for (auto &c : faultCnt_)
+        c = 0;
+
+    frameCnt_ = 0;
+}
+
+void sce::FaultInjector::registerMetrics(const std::string& name)
+{
+    // Fault names, in the same order as FaultType
+    static const char* faultNames[numFaults] = { "Reorder", "Duplicate", "Truncate", "BitFlip", "Error", "Delay", "Burst" };
+
+    MetricsRegistry& registry { MetricsRegistry::getInstance() };
+
+    registry.remove(this);
+
+    registry.addCounter(this, "smurf_fault_injector_frames_total", "Number of received frames",
+        { { "block", name } }, [this]() -> double { return getFrameCnt(); });
+
+    for (std::size_t i{0}; i < numFaults; ++i)
+    {
+        registry.addCounter(this, "smurf_fault_injector_faults_total", "Number of injected faults, by fault type",
+            { { "block", name }, { "fault", faultNames[i] } }, [this, i]() -> double { return getFaultCnt(i); });
+    }
+}
+
+// This method must be called holding the mutex
+bool sce::FaultInjector::inject(FaultType f)
+{
+    std::size_t i { static_cast<std::size_t>(f) };
+
+    if ( rate_[i] <= 0 )
+        return false;
+
+    if ( periodic_ )
+    {
+        // Inject one fault each time the accumulated rate reaches one
+        acc_[i] += rate_[i];
+        if ( acc_[i] < 1 )
+            return false;
+
+        acc_[i] -= 1;
+        return true;
+    }
+
+    return ( dis(gen) < rate_[i] );
+}
+
+ris::FramePtr sce::FaultInjector::copyFrame(ris::FramePtr frame)
+{
+    std::size_t size { frame->getPayload() };
+
+    ris::FramePtr newFrame { reqFrame(size, true) };
+    newFrame->setPayload(size);
+    std::copy(frame->beginRead(), frame->endRead(), newFrame->beginWrite());
+    newFrame->setError(frame->getError());
+    newFrame->setFlags(frame->getFlags());
+
+    return newFrame;
+}
+
+void sce::FaultInjector::acceptFrame(ris::FramePtr frame)
+{
+    // Frames to be sent to the next slave, in order
+    std::vector<ris::FramePtr> txFrames;
+
+    // Delay to apply before sending the frames (us)
+    std::size_t delay { 0 };
+
+    rogue::GilRelease noGil;
+
+    // If the processing block is disabled, just release the
+    // frames still being held, and pass the frame through.
+    if (disable_)
+    {
+        if (reorderFrame_)
+            txFrames.push_back(reorderFrame_);
+
+        txFrames.insert(txFrames.end(), burstFrames_.begin(), burstFrames_.end());
+        txFrames.push_back(frame);
+
+        reorderFrame_.reset();
+        burstFrames_.clear();
+        burstCnt_ = 0;
+    }
+    else
+    {
+        ++frameCnt_;
+
+        // Decide which faults to inject on this frame
+        std::array<bool, numFaults> faults;
+        {
+            // Take the mutex before using the parameters
+            std::lock_guard<std::mutex> lock(mtx_);
+
+            for (std::size_t i{0}; i < numFaults; ++i)
+                faults[i] = inject(static_cast<FaultType>(i));
+
+            if ( faults[static_cast<std::size_t>(FaultType::Delay)] )
+                delay = delay_;
+        }
+
+        // Faults which modify the frame
+        {
+            // Acquire lock on frame
+            ris::FrameLockPtr fLock = frame->lock();
+
+            std::size_t payload { frame->getPayload() };
+
+            // Truncate the frame to a random size
+            if ( faults[static_cast<std::size_t>(FaultType::Truncate)] && payload )
+                frame->setPayload( static_cast<uint32_t>( dis(gen) * payload ) );
+
+            // Flip a random bit, which can be on the header or in the data area
+            payload = frame->getPayload();
+            if ( faults[static_cast<std::size_t>(FaultType::BitFlip)] && payload )
+            {
+                ris::FrameIterator it { frame->begin() + static_cast<int32_t>( dis(gen) * payload ) };
+                *it ^= ( 1 << ( gen() % 8 ) );
+            }
+            else
+            {
+                faults[static_cast<std::size_t>(FaultType::BitFlip)] = false;
+            }
+
+            // Set the frame error
+            if ( faults[static_cast<std::size_t>(FaultType::Error)] )
+                frame->setError(0x1);
+
+            txFrames.push_back(frame);
+
+            // Send a copy of the frame as well
+            if ( faults[static_cast<std::size_t>(FaultType::Duplicate)] )
+                txFrames.push_back(copyFrame(frame));
+        }
+
+        // Send the frame held on the previous cycle after the current one. Otherwise, hold the current
+        // frame (without its duplicate, if any) to be sent after the next one.
+        if (reorderFrame_)
+        {
+            txFrames.push_back(reorderFrame_);
+            reorderFrame_.reset();
+            faults[static_cast<std::size_t>(FaultType::Reorder)] = false;
+        }
+        else if ( faults[static_cast<std::size_t>(FaultType::Reorder)] )
+        {
+            reorderFrame_ = txFrames.front();
+            txFrames.erase(txFrames.begin());
+        }
+
+        // Hold the frames while a burst is being formed, and send them all together
+        // when the burst is completed.
+        if ( burstCnt_ )
+        {
+            faults[static_cast<std::size_t>(FaultType::Burst)] = false;
+            --burstCnt_;
+        }
+        else if ( faults[static_cast<std::size_t>(FaultType::Burst)] )
+        {
+            burstCnt_ = burstSize_ - 1;
+        }
+
+        if ( burstCnt_ || ! burstFrames_.empty() )
+        {
+            burstFrames_.insert(burstFrames_.end(), txFrames.begin(), txFrames.end());
+            txFrames.clear();
+
+            if ( ! burstCnt_ )
+            {
+                txFrames.assign(burstFrames_.begin(), burstFrames_.end());
+                burstFrames_.clear();
+            }
+        }
+
+        // Update the fault counters
+        bool injected { false };
+        for (std::size_t i{0}; i < numFaults; ++i)
+        {
+            if ( faults[i] )
+            {
+                ++faultCnt_[i];
+                injected = true;
+            }
+        }
+
+        if (injected)
+            lastFaultTime_ = helpers::getTimeNS();
+    }
+
+    // Delay the frames
+    if (delay)
+        usleep(delay);
+
+    // Send the frames to the next slave
+    for (auto const &f : txFrames)
+        sendFrame(f);
+}
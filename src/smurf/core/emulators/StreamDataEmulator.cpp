@@ -22,6 +22,8 @@
 #include "smurf/core/emulators/StreamDataEmulator.h"
 #include "smurf/core/common/SmurfHeader.h"
 #include <cmath>
+#include <limits>
+#include <algorithm>
 
 namespace sce = smurf::core::emulators;
 namespace ris = rogue::interfaces::stream;
@@ -30,16 +32,23 @@ template <typename T>
 sce::StreamDataEmulator<T>::StreamDataEmulator()
 :
     eLog_(rogue::Logging::create("pysmurf.StreamDataEmulator")),
+    logCopy_(eLog_, "failed to copy frame"),
+    logBadFlags_(eLog_, "frame with errors and/or flags"),
+    logBadSize_(eLog_, "frame with wrong size"),
+    cfg_(),
+    config_(cfg_),
     disable_(true),
-    type_(SignalType::Zeros),
-    amplitude_(maxAmplitude),
-    offset_(0),
-    period_(2),
-    halfPeriod_(1),
+    traceId_(TraceRecorder::getInstance().registerBlock("StreamDataEmulator")),
+    counterEpoch_(0),
+    detectorEpoch_(0),
+    oscEpoch_(0),
     periodCounter_(0),
+    dropFrame_(false),
+    resetDetector_(true),
+    resetOscillators_(true),
+    commonPink_(0),
     gen(rd()),
-    dis(-amplitude_ + offset_, amplitude_ + offset_),
-    dropFrame_(false)
+    dis(-static_cast<double>(cfg_.amplitude) + cfg_.offset, static_cast<double>(cfg_.amplitude) + cfg_.offset)
 {
 }
 
@@ -60,6 +69,9 @@ void sce::StreamDataEmulator<T>::setup_python(const std::string& name)
                 (name.c_str(), bp::init<>())
         .def("setDisable",        &StreamDataEmulator<T>::setDisable)
         .def("getDisable",        &StreamDataEmulator<T>::getDisable)
+        .def("getSuppressedLogCnt",   &StreamDataEmulator<T>::getSuppressedLogCnt)
+        .def("clearSuppressedLogCnt", &StreamDataEmulator<T>::clearSuppressedLogCnt)
+        .def("setTraceName",          &StreamDataEmulator<T>::setTraceName)
         .def("setType",           &StreamDataEmulator<T>::setType)
         .def("getType",           &StreamDataEmulator<T>::getType)
         .def("setAmplitude",      &StreamDataEmulator<T>::setAmplitude)
@@ -68,7 +80,28 @@ void sce::StreamDataEmulator<T>::setup_python(const std::string& name)
         .def("getOffset",         &StreamDataEmulator<T>::getOffset)
         .def("setPeriod",         &StreamDataEmulator<T>::setPeriod)
         .def("getPeriod",         &StreamDataEmulator<T>::getPeriod)
-
+        .def("setWhiteNoise",          &StreamDataEmulator<T>::setWhiteNoise)
+        .def("getWhiteNoise",          &StreamDataEmulator<T>::getWhiteNoise)
+        .def("setPinkNoise",           &StreamDataEmulator<T>::setPinkNoise)
+        .def("getPinkNoise",           &StreamDataEmulator<T>::getPinkNoise)
+        .def("setDriftRate",           &StreamDataEmulator<T>::setDriftRate)
+        .def("getDriftRate",           &StreamDataEmulator<T>::getDriftRate)
+        .def("setFluxJumpProbability", &StreamDataEmulator<T>::setFluxJumpProbability)
+        .def("getFluxJumpProbability", &StreamDataEmulator<T>::getFluxJumpProbability)
+        .def("setFluxJumpAmplitude",   &StreamDataEmulator<T>::setFluxJumpAmplitude)
+        .def("getFluxJumpAmplitude",   &StreamDataEmulator<T>::getFluxJumpAmplitude)
+        .def("setGlitchProbability",   &StreamDataEmulator<T>::setGlitchProbability)
+        .def("getGlitchProbability",   &StreamDataEmulator<T>::getGlitchProbability)
+        .def("setGlitchAmplitude",     &StreamDataEmulator<T>::setGlitchAmplitude)
+        .def("getGlitchAmplitude",     &StreamDataEmulator<T>::getGlitchAmplitude)
+        .def("setCommonMode",          &StreamDataEmulator<T>::setCommonMode)
+        .def("getCommonMode",          &StreamDataEmulator<T>::getCommonMode)
+        .def("setSineFrequencies",     &StreamDataEmulator<T>::setSineFrequencies)
+        .def("getSineFrequencies",     &StreamDataEmulator<T>::getSineFrequencies)
+        .def("setSineAmplitudes",      &StreamDataEmulator<T>::setSineAmplitudes)
+        .def("getSineAmplitudes",      &StreamDataEmulator<T>::getSineAmplitudes)
+        .def("setSinePhases",          &StreamDataEmulator<T>::setSinePhases)
+        .def("getSinePhases",          &StreamDataEmulator<T>::getSinePhases)
     ;
     bp::implicitly_convertible< sce::StreamDataEmulatorPtr<T>, ris::SlavePtr  >();
     bp::implicitly_convertible< sce::StreamDataEmulatorPtr<T>, ris::MasterPtr >();
@@ -86,74 +119,97 @@ const bool sce::StreamDataEmulator<T>::getDisable() const
     return disable_;
 }
 
+template <typename T>
+void sce::StreamDataEmulator<T>::setTraceName(const std::string& name)
+{
+    TraceRecorder::getInstance().setBlockName(traceId_, name);
+}
+
+template <typename T>
+const std::size_t sce::StreamDataEmulator<T>::getSuppressedLogCnt() const
+{
+    return logCopy_.getSuppressedCnt() + logBadFlags_.getSuppressedCnt() + logBadSize_.getSuppressedCnt();
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::clearSuppressedLogCnt()
+{
+    logCopy_.clearCnt();
+    logBadFlags_.clearCnt();
+    logBadSize_.clearCnt();
+}
+
 template <typename T>
 void sce::StreamDataEmulator<T>::setType(int value)
 {
     // Verify that the type is in range
-    if (value < static_cast<int>(SignalType::Size))
+    if ( ( value >= 0 ) && ( value < static_cast<int>(SignalType::Size) ) )
     {
         // Take th mutex before changing the parameters
-        std::lock_guard<std::mutex> lock(mtx_);
+        std::lock_guard<std::mutex> lock(cfgMtx_);
 
-        type_ = static_cast<SignalType>(value);
+        cfg_.type = static_cast<SignalType>(value);
 
         // Rest the frame period counter
-        periodCounter_ = 0;
+        ++cfg_.counterEpoch;
+
+        publishConfig();
     }
 }
 
 template <typename T>
 const int sce::StreamDataEmulator<T>::getType() const
 {
-    return static_cast<int>(type_);
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return static_cast<int>(cfg_.type);
 }
 
 template <typename T>
 void sce::StreamDataEmulator<T>::setAmplitude(uT_t value)
 {
-    // The amplitude value can not be zero, nor higher that maxAmplitude
-    if ((value) && (value <= maxAmplitude ) )
+    // The amplitude value can not be zero
+    if (value)
     {
         // Take th mutex before changing the parameters
-        std::lock_guard<std::mutex> lock(mtx_);
+        std::lock_guard<std::mutex> lock(cfgMtx_);
 
-        amplitude_  = value;
+        cfg_.amplitude = value;
 
-        // Update the range of the uniform_real_distribution when
-        // the amplitude changes.
-        dis = std::uniform_real_distribution<double>(-amplitude_ + offset_, amplitude_ + offset_);
+        // Rest the frame period counter. The stream thread will also update
+        // the range of the uniform_real_distribution.
+        ++cfg_.counterEpoch;
 
-        // Rest the frame period counter
-        periodCounter_ = 0;
+        publishConfig();
     }
 }
 
 template <typename T>
 const typename sce::StreamDataEmulator<T>::uT_t sce::StreamDataEmulator<T>::getAmplitude() const
 {
-    return amplitude_;
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return cfg_.amplitude;
 }
 
 template <typename T>
 void sce::StreamDataEmulator<T>::setOffset(T value)
 {
     // Take th mutex before changing the parameters
-    std::lock_guard<std::mutex> lock(mtx_);
+    std::lock_guard<std::mutex> lock(cfgMtx_);
 
-    offset_ = value;
+    cfg_.offset = value;
 
-    // Update the range of the uniform_real_distribution when
-    // the offset changes.
-    dis = std::uniform_real_distribution<double>(-amplitude_ + offset_, amplitude_ + offset_);
+    // Rest the frame period counter. The stream thread will also update
+    // the range of the uniform_real_distribution.
+    ++cfg_.counterEpoch;
 
-    // Rest the frame period counter
-    periodCounter_ = 0;
+    publishConfig();
 }
 
 template <typename T>
 const T sce::StreamDataEmulator<T>::getOffset() const
 {
-    return offset_;
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return cfg_.offset;
 }
 
 template <typename T>
@@ -163,23 +219,285 @@ void sce::StreamDataEmulator<T>::setPeriod(std::size_t value)
     if (value >= 2)
     {
         // Take th mutex before changing the parameters
-        std::lock_guard<std::mutex> lock(mtx_);
+        std::lock_guard<std::mutex> lock(cfgMtx_);
 
         // Update the period value
-        period_ = value;
+        cfg_.period = value;
 
         // Get the half period value, for convenience
-        halfPeriod_ = period_ / 2;
+        cfg_.halfPeriod = value / 2;
 
         // Rest the frame period counter
-        periodCounter_ = 0;
+        ++cfg_.counterEpoch;
+
+        publishConfig();
     }
 }
 
 template <typename T>
 const std::size_t sce::StreamDataEmulator<T>::getPeriod() const
 {
-    return period_;
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return cfg_.period;
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::setWhiteNoise(double value)
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    cfg_.whiteNoise = std::abs(value);
+    publishConfig();
+}
+
+template <typename T>
+const double sce::StreamDataEmulator<T>::getWhiteNoise() const
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return cfg_.whiteNoise;
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::setPinkNoise(double value)
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    cfg_.pinkNoise = std::abs(value);
+    publishConfig();
+}
+
+template <typename T>
+const double sce::StreamDataEmulator<T>::getPinkNoise() const
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return cfg_.pinkNoise;
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::setDriftRate(double value)
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    cfg_.driftRate = std::abs(value);
+
+    // Each channel gets a new random drift rate
+    ++cfg_.detectorEpoch;
+
+    publishConfig();
+}
+
+template <typename T>
+const double sce::StreamDataEmulator<T>::getDriftRate() const
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return cfg_.driftRate;
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::setFluxJumpProbability(double value)
+{
+    // The probability must be in the range [0, 1]
+    if ( ( value >= 0 ) && ( value <= 1 ) )
+    {
+        std::lock_guard<std::mutex> lock(cfgMtx_);
+        cfg_.jumpProb = value;
+        publishConfig();
+    }
+}
+
+template <typename T>
+const double sce::StreamDataEmulator<T>::getFluxJumpProbability() const
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return cfg_.jumpProb;
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::setFluxJumpAmplitude(double value)
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    cfg_.jumpAmp = std::abs(value);
+    publishConfig();
+}
+
+template <typename T>
+const double sce::StreamDataEmulator<T>::getFluxJumpAmplitude() const
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return cfg_.jumpAmp;
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::setGlitchProbability(double value)
+{
+    // The probability must be in the range [0, 1]
+    if ( ( value >= 0 ) && ( value <= 1 ) )
+    {
+        std::lock_guard<std::mutex> lock(cfgMtx_);
+        cfg_.glitchProb = value;
+        publishConfig();
+    }
+}
+
+template <typename T>
+const double sce::StreamDataEmulator<T>::getGlitchProbability() const
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return cfg_.glitchProb;
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::setGlitchAmplitude(double value)
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    cfg_.glitchAmp = value;
+    publishConfig();
+}
+
+template <typename T>
+const double sce::StreamDataEmulator<T>::getGlitchAmplitude() const
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return cfg_.glitchAmp;
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::setCommonMode(double value)
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    cfg_.commonMode = std::abs(value);
+    publishConfig();
+}
+
+template <typename T>
+const double sce::StreamDataEmulator<T>::getCommonMode() const
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return cfg_.commonMode;
+}
+
+template <typename T>
+std::vector<double> sce::StreamDataEmulator<T>::listToVector(const bp::list& l)
+{
+    std::vector<double> temp;
+    std::size_t listSize = len(l);
+
+    // Only accept as many elements as the maximum number of channels in a frame
+    if ( listSize > maxNumCh )
+        listSize = maxNumCh;
+
+    for (std::size_t i{0}; i < listSize; ++i)
+        temp.push_back(bp::extract<double>(l[i]));
+
+    return temp;
+}
+
+template <typename T>
+bp::list sce::StreamDataEmulator<T>::vectorToList(const std::vector<double>& v)
+{
+    bp::list temp;
+
+    for (auto const &e : v)
+        temp.append(e);
+
+    return temp;
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::setSineFrequencies(bp::list l)
+{
+    std::vector<double> temp { listToVector(l) };
+
+    // Take th mutex before changing the parameters
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    cfg_.sineFreq.swap(temp);
+    ++cfg_.oscEpoch;
+    publishConfig();
+}
+
+template <typename T>
+const bp::list sce::StreamDataEmulator<T>::getSineFrequencies() const
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return vectorToList(cfg_.sineFreq);
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::setSineAmplitudes(bp::list l)
+{
+    std::vector<double> temp { listToVector(l) };
+
+    // Take th mutex before changing the parameters
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    cfg_.sineAmp.swap(temp);
+    ++cfg_.oscEpoch;
+    publishConfig();
+}
+
+template <typename T>
+const bp::list sce::StreamDataEmulator<T>::getSineAmplitudes() const
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return vectorToList(cfg_.sineAmp);
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::setSinePhases(bp::list l)
+{
+    std::vector<double> temp { listToVector(l) };
+
+    // Take th mutex before changing the parameters
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    cfg_.sinePhase.swap(temp);
+    ++cfg_.oscEpoch;
+    publishConfig();
+}
+
+template <typename T>
+const bp::list sce::StreamDataEmulator<T>::getSinePhases() const
+{
+    std::lock_guard<std::mutex> lock(cfgMtx_);
+    return vectorToList(cfg_.sinePhase);
+}
+
+// This method must be called holding the configuration mutex
+template <typename T>
+void sce::StreamDataEmulator<T>::publishConfig()
+{
+    config_.getBack() = cfg_;
+    config_.publish();
+}
+
+// This method must only be called from the stream thread
+template <typename T>
+const typename sce::StreamDataEmulator<T>::Config& sce::StreamDataEmulator<T>::updateConfig()
+{
+    // Check if the setters published a new configuration
+    if ( config_.update() )
+    {
+        const Config& c { config_.getFront() };
+
+        // Reset the frame period counter, and update the range of the
+        // uniform_real_distribution, as the amplitude or offset might have changed.
+        if ( c.counterEpoch != counterEpoch_ )
+        {
+            counterEpoch_  = c.counterEpoch;
+            periodCounter_ = 0;
+            dis = std::uniform_real_distribution<double>(-static_cast<double>(c.amplitude) + c.offset,
+                                                          static_cast<double>(c.amplitude) + c.offset);
+        }
+
+        if ( c.detectorEpoch != detectorEpoch_ )
+        {
+            detectorEpoch_ = c.detectorEpoch;
+            resetDetector_ = true;
+        }
+
+        if ( c.oscEpoch != oscEpoch_ )
+        {
+            oscEpoch_         = c.oscEpoch;
+            resetOscillators_ = true;
+        }
+    }
+
+    return config_.getFront();
 }
 
 template <typename T>
@@ -191,13 +509,16 @@ void sce::StreamDataEmulator<T>::acceptFrame(ris::FramePtr frame)
         // Only process the frame is the block is enable.
         if (!disable_)
         {
+            // Record the time spent on the frame, excluding the time spent by the next slaves
+            TraceScope trace(traceId_);
+
             // Acquire lock on frame
             ris::FrameLockPtr fLock = frame->lock();
 
             // Make sure the frame is a single buffer, copy if necessary
             if ( ! this->ensureSingleBuffer(frame,true) )
             {
-                eLog_->error("Failed to copy frame to single buffer. Check downstream slave types, maybe add a FIFO?");
+                logCopy_.error("Failed to copy frame to single buffer. Check downstream slave types, maybe add a FIFO?");
                 return;
             }
 
@@ -207,13 +528,13 @@ void sce::StreamDataEmulator<T>::acceptFrame(ris::FramePtr frame)
             // Check for frames with errors or flags
             if ( frame->getError() || ( frame->getFlags() & 0x100 ) )
             {
-                eLog_->error("Received frame with errors and/or flags");
+                logBadFlags_.error("Received frame with errors and/or flags");
             }
 
             // Check for frames with size less than at least the header size
             if ( frameSize < SmurfHeaderRO<ris::FrameIterator>::SmurfHeaderSize )
             {
-                eLog_->error("Received frame with size lower than the header size. Received frame size=%zu, expected header size=%zu",
+                logBadSize_.error("Received frame with size lower than the header size. Received frame size=%zu, expected header size=%zu",
                     frameSize, SmurfHeaderRO<ris::FrameIterator>::SmurfHeaderSize);
                 return;
             }
@@ -221,6 +542,8 @@ void sce::StreamDataEmulator<T>::acceptFrame(ris::FramePtr frame)
             // The frame has at least the header, so we can construct a (smart) pointer to it
             SmurfHeaderROPtr<ris::FrameIterator> header = SmurfHeaderRO<ris::FrameIterator>::create(frame);
 
+            trace.setFrame(header->getFrameCounter());
+
             // Read the number of channel from the header
             uint32_t numChannels { header->getNumberChannels() };
 
@@ -228,7 +551,7 @@ void sce::StreamDataEmulator<T>::acceptFrame(ris::FramePtr frame)
             // of channels defined in its header. Padded frames are allowed.
             if ( header->SmurfHeaderSize + (numChannels * sizeof(T)) > frameSize )
             {
-                eLog_->error("Received frame does not match expected size. Received frame size=%zu. Minimum expected sizes: header=%zu, payload=%i",
+                logBadSize_.error("Received frame does not match expected size. Received frame size=%zu. Minimum expected sizes: header=%zu, payload=%i",
                         frameSize, header->SmurfHeaderSize, numChannels * sizeof(T));
                 return;
             }
@@ -242,8 +565,11 @@ void sce::StreamDataEmulator<T>::acceptFrame(ris::FramePtr frame)
             // Create T accessor to the data
             ris::FrameAccessor<T> dPtr(fPtr, numChannels);
 
+            // Get the latest configuration
+            const Config& c { updateConfig() };
+
             // Generate the type of signal selected
-            switch(type_)
+            switch(c.type)
             {
                 case SignalType::Zeros:
                     genZeroWave(dPtr);
@@ -255,19 +581,25 @@ void sce::StreamDataEmulator<T>::acceptFrame(ris::FramePtr frame)
                     genRandomWave(dPtr);
                     break;
                 case SignalType::Square:
-                    genSquareWave(dPtr);
+                    genSquareWave(dPtr, c);
                     break;
                 case SignalType::Sawtooth:
-                    getSawtoothWave(dPtr);
+                    getSawtoothWave(dPtr, c);
                     break;
                 case SignalType::Triangle:
-                    genTriangleWave(dPtr);
+                    genTriangleWave(dPtr, c);
                     break;
                 case SignalType::Sine:
-                    genSinWave(dPtr);
+                    genSinWave(dPtr, c);
                     break;
                 case SignalType::DropFrame:
-                    genFrameDrop();
+                    genFrameDrop(c);
+                    break;
+                case SignalType::Detector:
+                    genDetectorWave(dPtr, c);
+                    break;
+                case SignalType::ChannelSine:
+                    genChannelSineWave(dPtr, c);
                     break;
             }
         }
@@ -308,113 +640,296 @@ void sce::StreamDataEmulator<T>::genRandomWave(ris::FrameAccessor<T> &dPtr)
     // applying the selected amplitude and offset.
     for (std::size_t i{0}; i < dPtr.size(); ++i )
         // Use dis to transform the random unsigned int generated by gen into a
-        // double in [-amplitude_ + offset, amplitude_ + offset).
+        // double in [-amplitude + offset, amplitude + offset).
         // Each call to dis(gen) generates a new random double.
         dPtr.at(i) = static_cast<T>(dis(gen));
 }
 
 template <typename T>
-void sce::StreamDataEmulator<T>::genSquareWave(ris::FrameAccessor<T> &dPtr)
+void sce::StreamDataEmulator<T>::genSquareWave(ris::FrameAccessor<T> &dPtr, const Config& c)
 {
     T s;
 
-    {
-        // Take th mutex before using the parameters
-        std::lock_guard<std::mutex> lock(mtx_);
-
-        // Generate a square signal between [-'amplitude_', 'amplitude_'], with an
-        // offset of 'offset_' and with period 'period_'.
-        if ( periodCounter_ < halfPeriod_ )
-            s = -amplitude_ + offset_;
-        else
-            s = amplitude_ + offset_;
-
-        // Reset the period counter when it reaches the define period
-        if ( ( ++periodCounter_ >= period_ ) )
-            periodCounter_ = 0;
-    }
+    // Generate a square signal between [-'amplitude', 'amplitude'], with an
+    // offset of 'offset' and with period 'period'.
+    if ( periodCounter_ < c.halfPeriod )
+        s = -c.amplitude + c.offset;
+    else
+        s = c.amplitude + c.offset;
+
+    // Reset the period counter when it reaches the define period
+    if ( ( ++periodCounter_ >= c.period ) )
+        periodCounter_ = 0;
 
     // Set all channels to the same signal
     std::fill(dPtr.begin(), dPtr.end(), s);
 }
 
 template <typename T>
-void sce::StreamDataEmulator<T>::getSawtoothWave(ris::FrameAccessor<T> &dPtr)
+void sce::StreamDataEmulator<T>::getSawtoothWave(ris::FrameAccessor<T> &dPtr, const Config& c)
 {
     T s;
 
-    {
-        // Take th mutex before using the parameters
-        std::lock_guard<std::mutex> lock(mtx_);
-
-        // Generate a sawtooth signal between [offset, 'amplitude_'], with a
-        // period 'period_'.
-        s = offset_ + periodCounter_ * amplitude_ / ( period_ - 1);
+    // Generate a sawtooth signal between [offset, 'amplitude'], with a
+    // period 'period'.
+    s = c.offset + periodCounter_ * c.amplitude / ( c.period - 1);
 
-        // Reset the period counter when it reaches the define period
-        if ( ( ++periodCounter_ >= period_ ) )
-            periodCounter_ = 0;
-    }
+    // Reset the period counter when it reaches the define period
+    if ( ( ++periodCounter_ >= c.period ) )
+        periodCounter_ = 0;
 
     // Set all channels to the same signal
     std::fill(dPtr.begin(), dPtr.end(), s);
 }
 
 template <typename T>
-void sce::StreamDataEmulator<T>::genTriangleWave(ris::FrameAccessor<T> &dPtr)
+void sce::StreamDataEmulator<T>::genTriangleWave(ris::FrameAccessor<T> &dPtr, const Config& c)
 {
     T s;
 
-    {
-        // Take th mutex before using the parameters
-        std::lock_guard<std::mutex> lock(mtx_);
-
-        // Generate a triangle signal between [-'amplitude_', 'amplitude_'], with an
-        // offset of 'offset_' and with period 'period_'.
-        s = ( std::abs<T>( periodCounter_ - halfPeriod_ ) )
-            * 2 * amplitude_ / halfPeriod_ - amplitude_ + offset_;
+    // Generate a triangle signal between [-'amplitude', 'amplitude'], with an
+    // offset of 'offset' and with period 'period'.
+    s = ( std::abs<T>( periodCounter_ - c.halfPeriod ) )
+        * 2 * c.amplitude / c.halfPeriod - c.amplitude + c.offset;
 
-        // Reset the period counter when it reaches the define period
-        if ( ( ++periodCounter_ >= period_ ) )
-            periodCounter_ = 0;
-    }
+    // Reset the period counter when it reaches the define period
+    if ( ( ++periodCounter_ >= c.period ) )
+        periodCounter_ = 0;
 
     // Set all channels to the same signal
     std::fill(dPtr.begin(), dPtr.end(), s);
 }
 
 template <typename T>
-void sce::StreamDataEmulator<T>::genSinWave(ris::FrameAccessor<T> &dPtr)
+void sce::StreamDataEmulator<T>::genSinWave(ris::FrameAccessor<T> &dPtr, const Config& c)
 {
     T s;
 
+    // Generate a sine signal between [-'amplitude', 'amplitude'], with an
+    // offset of 'offset' and with period 'period'.
+    s = c.amplitude * std::sin( 2 * M_PI * ++periodCounter_ / c.period ) + c.offset;
+
+    // Set all channels to the same signal
+    std::fill(dPtr.begin(), dPtr.end(), s);
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::genFrameDrop(const Config& c)
+{
+    // Set the flag to drop a frame and reset the period counter when
+    // it reaches the define period.
+    if ( ( ++periodCounter_ >= c.period ) )
     {
-        // Take th mutex before using the parameters
-        std::lock_guard<std::mutex> lock(mtx_);
+        dropFrame_ = true;
+        periodCounter_ = 0;
+    }
+}
 
-        // Generate a sine signal between [-'amplitude_', 'amplitude_'], with an
-        // offset of 'offset_' and with period 'period_'.
-        s = amplitude_ * std::sin( 2 * M_PI * ++periodCounter_ / period_ ) + offset_;
+namespace
+{
+    // Xorshift random number generator. It returns a uniformly distributed
+    // number in the interval [-1, 1). It is much cheaper than the standard
+    // generators, and can be vectorized when used in a loop over channels.
+    inline double xorshiftUniform(uint32_t &s)
+    {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        return static_cast<int32_t>(s) * ( 1.0 / 2147483648.0 );
     }
 
-    // Set all channels to the same signal
-    std::fill(dPtr.begin(), dPtr.end(), s);
+    // Approximated normal distributed number (zero mean, unit variance), using
+    // the sum of four uniformly distributed numbers.
+    inline double xorshiftNormal(uint32_t &s)
+    {
+        return ( xorshiftUniform(s) + xorshiftUniform(s) + xorshiftUniform(s) + xorshiftUniform(s) ) * 0.8660254037844386;
+    }
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::resetDetector(std::size_t numCh, const Config& c)
+{
+    std::vector<double>(numCh, 0).swap(phase_);
+    std::vector<double>(numCh, 0).swap(drift_);
+    std::vector<double>(numCh, 0).swap(pink0_);
+    std::vector<double>(numCh, 0).swap(pink1_);
+    std::vector<double>(numCh, 0).swap(pink2_);
+    std::vector<uint32_t>(numCh, 0).swap(seed_);
+    commonPink_ = 0;
+
+    // Each channel starts with a random phase and drift rate, and
+    // it gets its own (non-zero) random number generator seed.
+    std::uniform_real_distribution<double> phaseDis(-0x8000, 0x8000);
+    std::uniform_real_distribution<double> driftDis(-c.driftRate, c.driftRate);
+    for (std::size_t i{0}; i < numCh; ++i)
+    {
+        phase_[i] = phaseDis(gen);
+        drift_[i] = driftDis(gen);
+        seed_[i]  = gen() | 1;
+    }
+
+    resetDetector_ = false;
 }
 
 template <typename T>
-void sce::StreamDataEmulator<T>::genFrameDrop()
+void sce::StreamDataEmulator<T>::genDetectorWave(ris::FrameAccessor<T> &dPtr, const Config& c)
 {
+    std::size_t numCh { dPtr.size() };
+
+    // Re-initialize the per-channel state if the parameters requested it,
+    // or if the number of channels changed.
+    if ( resetDetector_ || ( phase_.size() != numCh ) )
+        resetDetector(numCh, c);
+
+    // Copy the parameters to local variables, so that they are not
+    // read from memory on each cycle of the loop.
+    const double white      { c.whiteNoise };
+    const double pink       { c.pinkNoise / 3.0 }; // Normalize the RMS of the 1/f noise filter output
+    const double jumpProb   { c.jumpProb };
+    const double jumpAmp    { c.jumpAmp };
+    const double glitchProb { c.glitchProb };
+    const double glitchAmp  { c.glitchAmp };
+    const double common     { c.commonMode };
+    const T      offset     { c.offset };
+
+    // Common mode signal, as a slow random walk with unit variance, added to all channels.
+    std::normal_distribution<double> normDis(0, 1);
+    commonPink_ = 0.999 * commonPink_ + 0.0447101778122163 * normDis(gen);
+    const double cm { common * commonPink_ + offset };
+
+    // Map the probabilities to the interval [-1, 1) used by the generator
+    const double jumpThreshold   { 2 * jumpProb   - 1 };
+    const double glitchThreshold { 2 * glitchProb - 1 };
+
+    // Raw pointers to the per-channel state. The loop has no branches and no
+    // dependencies between channels, so that the compiler can vectorize it.
+    double*   phase { phase_.data() };
+    double*   drift { drift_.data() };
+    double*   p0    { pink0_.data() };
+    double*   p1    { pink1_.data() };
+    double*   p2    { pink2_.data() };
+    uint32_t* seed  { seed_.data()  };
+    T*        out   { dPtr.begin()  };
+
+    for (std::size_t i{0}; i < numCh; ++i)
     {
-        // Take th mutex before using the parameters
-        std::lock_guard<std::mutex> lock(mtx_);
+        // White noise
+        const double w { xorshiftNormal(seed[i]) };
+
+        // 1/f noise, using a 3 pole filter (Paul Kellet's economy method) over its own
+        // white noise sample, so that it is independent of the white noise component
+        const double u { xorshiftNormal(seed[i]) };
+        p0[i] = 0.99765 * p0[i] + u * 0.0990460;
+        p1[i] = 0.96300 * p1[i] + u * 0.2965164;
+        p2[i] = 0.57000 * p2[i] + u * 1.0526913;
+        const double f { p0[i] + p1[i] + p2[i] + u * 0.1848 };
+
+        // Flux jumps are permanent steps, with random sign
+        const double uJump { xorshiftUniform(seed[i]) };
+        const double jump  { ( uJump < jumpThreshold ) ? ( ( seed[i] & 0x2 ) ? jumpAmp : -jumpAmp ) : 0.0 };
+
+        // Glitches only last one frame
+        const double uGlitch { xorshiftUniform(seed[i]) };
+        const double glitch  { ( uGlitch < glitchThreshold ) ? glitchAmp : 0.0 };
+
+        // Accumulate the drift and the flux jumps, wrapping the phase in
+        // the interval [-0x8000, 0x8000), like the firmware phase does.
+        double p { phase[i] + drift[i] + jump };
+        p -= 0x10000 * std::floor( ( p + 0x8000 ) * ( 1.0 / 0x10000 ) );
+        phase[i] = p;
+
+        // Add all the components, and wrap the result to the 16-bit phase range
+        const double v { p + white * w + pink * f + cm + glitch };
+        out[i] = static_cast<T>( static_cast<int16_t>( static_cast<int32_t>( std::lrint(v) ) ) );
+    }
+}
+
+namespace
+{
+    // Sine lookup table, with one full period. It has an extra point at the
+    // end, so that the interpolation doesn't need to wrap the index.
+    const std::size_t sineTableBits = 10;
+    const std::size_t sineTableSize = 1 << sineTableBits;
 
-        // Set the flag to drop a frame and reset the period counter when
-        // it reaches the define period.
-        if ( ( ++periodCounter_ >= period_ ) )
+    struct SineTable
+    {
+        double v[sineTableSize + 1];
+
+        SineTable()
         {
-            dropFrame_ = true;
-            periodCounter_ = 0;
+            for (std::size_t i{0}; i <= sineTableSize; ++i)
+                v[i] = std::sin( 2 * M_PI * i / sineTableSize );
         }
+    };
+
+    const SineTable sineTable;
+
+    // Sine of a 32-bit phase accumulator value (a full period maps to 2^32), using the
+    // lookup table with linear interpolation. The upper bits select the table entry and
+    // the next 16 bits are used as the interpolation fraction.
+    inline double sineLookup(uint32_t phase)
+    {
+        const uint32_t i    { phase >> ( 32 - sineTableBits ) };
+        const double   frac { ( ( phase >> ( 16 - sineTableBits ) ) & 0xffff ) * ( 1.0 / 0x10000 ) };
+        return sineTable.v[i] + frac * ( sineTable.v[i + 1] - sineTable.v[i] );
+    }
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::resetOscillators(std::size_t numCh, const Config& c)
+{
+    std::vector<uint32_t>(numCh, 0).swap(oscPhase_);
+    std::vector<uint32_t>(numCh, 0).swap(oscStep_);
+    std::vector<double>(numCh, 0).swap(oscAmp_);
+
+    // Convert the frequencies and phases to phase accumulator units (a full period maps to 2^32).
+    // Channels without parameters keep a zero amplitude.
+    for (std::size_t i{0}; i < numCh; ++i)
+    {
+        if ( i < c.sineFreq.size() )
+            oscStep_[i] = static_cast<uint32_t>( static_cast<int64_t>( std::llround( c.sineFreq[i] * 4294967296.0 ) ) );
+
+        if ( i < c.sinePhase.size() )
+            oscPhase_[i] = static_cast<uint32_t>( static_cast<int64_t>( std::llround( c.sinePhase[i] / 360.0 * 4294967296.0 ) ) );
+
+        if ( i < c.sineAmp.size() )
+            oscAmp_[i] = c.sineAmp[i];
+    }
+
+    resetOscillators_ = false;
+}
+
+template <typename T>
+void sce::StreamDataEmulator<T>::genChannelSineWave(ris::FrameAccessor<T> &dPtr, const Config& c)
+{
+    std::size_t numCh { dPtr.size() };
+
+    // Re-initialize the oscillators if the parameters changed,
+    // or if the number of channels changed.
+    if ( resetOscillators_ || ( oscPhase_.size() != numCh ) )
+        resetOscillators(numCh, c);
+
+    const double offset { static_cast<double>(c.offset) };
+
+    // Range of the output type. The values are saturated to it before the
+    // conversion, as converting an out of range value is undefined.
+    const double lower { static_cast<double>( std::numeric_limits<T>::min() ) };
+    const double upper { static_cast<double>( std::numeric_limits<T>::max() ) };
+
+    // Raw pointers to the per-channel oscillators. The loop has no branches and no
+    // dependencies between channels, so that the compiler can vectorize it.
+    uint32_t*       phase { oscPhase_.data() };
+    const uint32_t* step  { oscStep_.data()  };
+    const double*   amp   { oscAmp_.data()   };
+    T*              out   { dPtr.begin()     };
+
+    for (std::size_t i{0}; i < numCh; ++i)
+    {
+        const double v { amp[i] * sineLookup(phase[i]) + offset };
+        out[i] = static_cast<T>( std::min( std::max( v, lower ), upper ) );
+
+        // Advance the phase accumulator. It wraps around at the end of each period.
+        phase[i] += step[i];
     }
 }
 
@@ -0,0 +1,399 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF SysgenCryo Emulator
+ * ----------------------------------------------------------------------------
+ * File          : SysgenCryoEmulator.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF SysgenCryo Emulator Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <cmath>
+#include <chrono>
+#include <complex>
+#include <cstring>
+#include <algorithm>
+#include <boost/python.hpp>
+#include "smurf/core/emulators/SysgenCryoEmulator.h"
+#include "smurf/core/common/Helpers.h"
+
+namespace sce = smurf::core::emulators;
+namespace rim = rogue::interfaces::memory;
+
+namespace
+{
+    // Sign extend a 24-bit field
+    inline int32_t signExtend24(uint32_t v)
+    {
+        return static_cast<int32_t>(v << 8) >> 8;
+    }
+
+    // Round and saturate a value to a signed 24-bit field
+    inline uint32_t toField24(double v)
+    {
+        double r { std::round(v) };
+        r = std::min(std::max(r, -8388608.0), 8388607.0);
+        return static_cast<uint32_t>(static_cast<int32_t>(r)) & 0x00FFFFFF;
+    }
+}
+
+sce::SysgenCryoEmulator::SysgenCryoEmulator(std::size_t numBands)
+:
+    rim::Slave(4, 4096),
+    numBands(numBands),
+    config(numBands * 2 * numChannels, 0),
+    resonators(numBands * numChannels, Resonator{ 0.0, 0.1, 0.9 }),
+    latency(0),
+    bandwidth(0),
+    noise(0),
+    linkFree(0),
+    tranCnt(0),
+    readBytes(0),
+    writeBytes(0),
+    runTx(true),
+    gen(0),
+    dis(0.0, 1.0),
+    eLog_(rogue::Logging::create("pysmurf.SysgenCryoEmulator"))
+{
+    // Start the thread once all the variables have been initialized
+    txThread = std::thread( &SysgenCryoEmulator::runThread, this );
+
+    if( pthread_setname_np( txThread.native_handle(), "SysgenCryoEmu" ) )
+        perror( "pthread_setname_np failed for SysgenCryoEmulator thread" );
+}
+
+sce::SysgenCryoEmulator::~SysgenCryoEmulator()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        runTx = false;
+    }
+    queueCV.notify_all();
+
+    rogue::GilRelease noGil;
+    txThread.join();
+}
+
+sce::SysgenCryoEmulatorPtr sce::SysgenCryoEmulator::create(std::size_t numBands)
+{
+    return std::make_shared<SysgenCryoEmulator>(numBands);
+}
+
+// Setup Class in python
+void sce::SysgenCryoEmulator::setup_python()
+{
+    bp::class_< sce::SysgenCryoEmulator,
+                sce::SysgenCryoEmulatorPtr,
+                bp::bases<rim::Slave>,
+                boost::noncopyable >
+                ("SysgenCryoEmulator", bp::init<std::size_t>())
+        .def("setLatency",            &SysgenCryoEmulator::setLatency)
+        .def("getLatency",            &SysgenCryoEmulator::getLatency)
+        .def("setBandwidth",          &SysgenCryoEmulator::setBandwidth)
+        .def("getBandwidth",          &SysgenCryoEmulator::getBandwidth)
+        .def("setNoise",              &SysgenCryoEmulator::setNoise)
+        .def("getNoise",              &SysgenCryoEmulator::getNoise)
+        .def("setResonator",          &SysgenCryoEmulator::setResonator)
+        .def("getResonatorFrequency", &SysgenCryoEmulator::getResonatorFrequency)
+        .def("randomizeResonators",   &SysgenCryoEmulator::randomizeResonators)
+        .def("getNumBands",           &SysgenCryoEmulator::getNumBands)
+        .def("getTransactionCnt",     &SysgenCryoEmulator::getTransactionCnt)
+        .def("getReadBytes",          &SysgenCryoEmulator::getReadBytes)
+        .def("getWriteBytes",         &SysgenCryoEmulator::getWriteBytes)
+        .def("clearCnt",              &SysgenCryoEmulator::clearCnt)
+    ;
+    bp::implicitly_convertible< sce::SysgenCryoEmulatorPtr, rim::SlavePtr >();
+}
+
+void sce::SysgenCryoEmulator::setLatency(double value)
+{
+    if ( value < 0 )
+    {
+        eLog_->error("Trying to set a negative latency = %f", value);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    latency = value;
+}
+
+const double sce::SysgenCryoEmulator::getLatency() const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    return latency;
+}
+
+void sce::SysgenCryoEmulator::setBandwidth(double value)
+{
+    if ( value < 0 )
+    {
+        eLog_->error("Trying to set a negative bandwidth = %f", value);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    bandwidth = value;
+}
+
+const double sce::SysgenCryoEmulator::getBandwidth() const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    return bandwidth;
+}
+
+void sce::SysgenCryoEmulator::setNoise(double value)
+{
+    if ( value < 0 )
+    {
+        eLog_->error("Trying to set a negative noise = %f", value);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    noise = value;
+}
+
+const double sce::SysgenCryoEmulator::getNoise() const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    return noise;
+}
+
+void sce::SysgenCryoEmulator::setResonator(std::size_t band, std::size_t channel, double frequency, double bandwidth, double depth)
+{
+    if ( ( band >= numBands ) || ( channel >= numChannels ) )
+    {
+        eLog_->error("Invalid band %zu or channel %zu", band, channel);
+        return;
+    }
+
+    if ( bandwidth <= 0 )
+    {
+        eLog_->error("Trying to set a resonator bandwidth <= 0");
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    resonators[band * numChannels + channel] = Resonator{ frequency, bandwidth, std::min(std::max(depth, 0.0), 1.0) };
+}
+
+const double sce::SysgenCryoEmulator::getResonatorFrequency(std::size_t band, std::size_t channel) const
+{
+    if ( ( band >= numBands ) || ( channel >= numChannels ) )
+        return 0;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    return resonators[band * numChannels + channel].frequency;
+}
+
+void sce::SysgenCryoEmulator::randomizeResonators(double maxOffset, uint32_t seed)
+{
+    std::mt19937                           g(seed);
+    std::uniform_real_distribution<double> d(-maxOffset, maxOffset);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto &r : resonators)
+        r.frequency = d(g);
+}
+
+const std::size_t sce::SysgenCryoEmulator::getNumBands() const
+{
+    return numBands;
+}
+
+const std::size_t sce::SysgenCryoEmulator::getTransactionCnt() const
+{
+    return tranCnt;
+}
+
+const std::size_t sce::SysgenCryoEmulator::getReadBytes() const
+{
+    return readBytes;
+}
+
+const std::size_t sce::SysgenCryoEmulator::getWriteBytes() const
+{
+    return writeBytes;
+}
+
+void sce::SysgenCryoEmulator::clearCnt()
+{
+    tranCnt    = 0;
+    readBytes  = 0;
+    writeBytes = 0;
+}
+
+void sce::SysgenCryoEmulator::doTransaction(rim::TransactionPtr tran)
+{
+    rogue::GilRelease noGil;
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+
+        // Without delays, and with no delayed transactions in front
+        // of this one, the transaction is completed right away
+        if ( ( 0 == latency ) && ( 0 == bandwidth ) && queue.empty() )
+        {
+            process(tran);
+            return;
+        }
+
+        // The transaction is transferred when the link is free, and
+        // completed 'latency' after the end of the transfer
+        uint64_t now   { helpers::getTimeNS() };
+        uint64_t start { std::max(now, linkFree) };
+        uint64_t xfer  { ( bandwidth > 0 ) ? static_cast<uint64_t>( tran->size() / bandwidth * 1e9 ) : 0 };
+
+        linkFree = start + xfer;
+        queue.push_back( Pending{ tran, linkFree + static_cast<uint64_t>( latency * 1e3 ) } );
+    }
+
+    queueCV.notify_all();
+}
+
+void sce::SysgenCryoEmulator::process(rim::TransactionPtr tran)
+{
+    rim::TransactionLockPtr lock { tran->lock() };
+
+    if ( tran->expired() )
+        return;
+
+    uint64_t address { tran->address() };
+    uint32_t size    { tran->size() };
+    uint32_t type    { tran->type() };
+
+    if ( ( address % 4 ) || ( size % 4 ) )
+    {
+        tran->error("Unaligned access: address = 0x%llx, size = %u", static_cast<unsigned long long>(address), size);
+        return;
+    }
+
+    if ( address + size > numBands * bandSize )
+    {
+        tran->error("Address out of range: address = 0x%llx, size = %u", static_cast<unsigned long long>(address), size);
+        return;
+    }
+
+    uint8_t* data { tran->begin() };
+
+    for (uint32_t i{0}; i < size; i += 4)
+    {
+        uint64_t    a       { address + i };
+        std::size_t band    { static_cast<std::size_t>( a / bandSize ) };
+        std::size_t bank    { static_cast<std::size_t>( ( a % bandSize ) / bankSize ) };
+        std::size_t channel { static_cast<std::size_t>( ( a % bankSize ) / 4 ) };
+        uint32_t    word;
+
+        if ( ( rim::Write == type ) || ( rim::Post == type ) )
+        {
+            // Writes to the status banks are ignored
+            if ( bank < 2 )
+            {
+                std::memcpy(&word, data + i, 4);
+                config[( band * 2 + bank ) * numChannels + channel] = word;
+            }
+        }
+        else
+        {
+            if ( bank < 2 )
+                word = config[( band * 2 + bank ) * numChannels + channel];
+            else if ( 2 == bank )
+                word = status0(band, channel);
+            else
+                word = status1(band, channel);
+
+            std::memcpy(data + i, &word, 4);
+        }
+    }
+
+    ++tranCnt;
+    if ( ( rim::Write == type ) || ( rim::Post == type ) )
+        writeBytes += size;
+    else
+        readBytes += size;
+
+    tran->done();
+}
+
+uint32_t sce::SysgenCryoEmulator::status0(std::size_t band, std::size_t channel)
+{
+    uint32_t  c1        { config[( band * 2 + 1 ) * numChannels + channel] };
+    uint32_t  amplitude { ( c1 >> 24 ) & 0xF };
+    bool      feedback  { ( c1 >> 31 ) != 0 };
+    double    frequency { signExtend24(c1) * frequencySpan / 16777216.0 };
+    double    lfo       { 0 };
+
+    // When the loop is locked, it follows the resonator. The output is in
+    // the same units as the center frequency.
+    if ( feedback && amplitude )
+        lfo = ( resonators[band * numChannels + channel].frequency - frequency ) * 16777216.0 / frequencySpan;
+
+    return toField24(lfo) | ( amplitude << 24 );
+}
+
+uint32_t sce::SysgenCryoEmulator::status1(std::size_t band, std::size_t channel)
+{
+    uint32_t  c0        { config[( band * 2 + 0 ) * numChannels + channel] };
+    uint32_t  c1        { config[( band * 2 + 1 ) * numChannels + channel] };
+    uint32_t  amplitude { ( c1 >> 24 ) & 0xF };
+    bool      feedback  { ( c1 >> 31 ) != 0 };
+    double    frequency { signExtend24(c1) * frequencySpan / 16777216.0 };
+    double    etaMag    { static_cast<int16_t>(c0 & 0xFFFF) / 1024.0 };
+    double    etaPhase  { static_cast<int16_t>(c0 >> 16) * M_PI / 32768.0 };
+    double    error     { 0 };
+
+    // With the loop open, the error is the real part of eta * S21 at the channel
+    // frequency. When the loop is locked, only the noise is left.
+    if ( amplitude && ( ! feedback ) )
+    {
+        const Resonator&     r   { resonators[band * numChannels + channel] };
+        double               x   { 2.0 * ( frequency - r.frequency ) / r.bandwidth };
+        std::complex<double> s21 { ( 1.0 - r.depth / std::complex<double>(1.0, x) ) * ( amplitude / 15.0 ) };
+        std::complex<double> eta { std::polar(etaMag, etaPhase) };
+
+        error = std::real(eta * s21) * errorScale;
+    }
+
+    if ( noise > 0 )
+        error += noise * dis(gen);
+
+    return toField24(error);
+}
+
+void sce::SysgenCryoEmulator::runThread()
+{
+    eLog_->logThreadId();
+
+    std::unique_lock<std::mutex> lock(mtx);
+
+    while(runTx)
+    {
+        if ( queue.empty() )
+        {
+            queueCV.wait( lock );
+            continue;
+        }
+
+        // Wait until the oldest transaction is due
+        uint64_t now { helpers::getTimeNS() };
+        if ( queue.front().due > now )
+        {
+            queueCV.wait_for( lock, std::chrono::nanoseconds( queue.front().due - now ) );
+            continue;
+        }
+
+        Pending p { queue.front() };
+        queue.pop_front();
+        process(p.tran);
+    }
+}
@@ -22,6 +22,8 @@
 #include "smurf/core/emulators/module.h"
 #include "smurf/core/emulators/StreamDataEmulator.h"
 #include "smurf/core/emulators/StreamDataSource.h"
+#include "smurf/core/emulators/FaultInjector.h"
+#include "smurf/core/emulators/SysgenCryoEmulator.h"
 
 namespace bp  = boost::python;
 namespace sce = smurf::core::emulators;
@@ -40,4 +42,6 @@ void sce::setup_module()
     sce::StreamDataEmulator<int16_t>::setup_python("StreamDataEmulatorI16");
     sce::StreamDataEmulator<int32_t>::setup_python("StreamDataEmulatorI32");
     sce::StreamDataSource::setup_python();
+    sce::FaultInjector::setup_python();
+    sce::SysgenCryoEmulator::setup_python();
 }
@@ -1,8 +1,10 @@
 #include <smurf/core/engines/SysgenCryo.h>
 #include <math.h>
 #include <chrono>
+#include <algorithm>
 
 namespace bp  = boost::python;
+namespace np  = boost::python::numpy;
 namespace sce = smurf::core::engines;
 
 void sce::SysgenCryo::setOffset(uint32_t offset) {
@@ -22,192 +24,542 @@ void sce::SysgenCryo::setBand(uint32_t band) {
 
 
 void sce::SysgenCryo::updateConfig0Shadow( bool read ) {
-    uint32_t ret[NUM_CHANNELS_C];
     if (read)
     {
-	readReg(config0_address_, 4*NUM_CHANNELS_C, ret);
-        for(int i = 0; i < NUM_CHANNELS_C; i++)
-        {
-            config0_shadow[i].reg = ret[i];
-        }
+        reqRead(config0_address_, 4*NUM_CHANNELS_C, &(config0_shadow[0].reg));
     } 
     else
     {
-        for(int i = 0; i < NUM_CHANNELS_C; i++)
-        {
-            ret[i] = config0_shadow[i].reg;
-        }
-	writeReg(config0_address_, 4*NUM_CHANNELS_C, ret);
+        reqWrite(config0_address_, 4*NUM_CHANNELS_C, &(config0_shadow[0].reg));
     } 
+    waitAll();
+
+    // The shadow now matches the registers
+    config0_dirty_.reset();
+    config0_valid_ = true;
     return;
 }
 
 void sce::SysgenCryo::updateConfig1Shadow(bool read) {
-    uint32_t ret[NUM_CHANNELS_C];
     if (read)
     {
-	readReg(config1_address_, 4*NUM_CHANNELS_C, ret);
-        for(int i = 0; i < NUM_CHANNELS_C; i++)
-        {
-            config1_shadow[i].reg = ret[i];
-        }
+        reqRead(config1_address_, 4*NUM_CHANNELS_C, &(config1_shadow[0].reg));
     } 
     else
     {
-        for(int i = 0; i < NUM_CHANNELS_C; i++)
-        {
-            ret[i] = config1_shadow[i].reg;
-        }
-	writeReg(config1_address_, 4*NUM_CHANNELS_C, ret);
+        reqWrite(config1_address_, 4*NUM_CHANNELS_C, &(config1_shadow[0].reg));
     } 
+    waitAll();
+
+    // The shadow now matches the registers
+    config1_dirty_.reset();
+    config1_valid_ = true;
     return;
 }
 
 void sce::SysgenCryo::updateStatus0Shadow(bool read) {
-    uint32_t ret[NUM_CHANNELS_C];
     if (read)
     {
-	readReg(status0_address_, 4*NUM_CHANNELS_C, ret);
-        for(int i = 0; i < NUM_CHANNELS_C; i++)
-        {
-            status0_shadow[i].reg = ret[i];
-        }
+        reqRead(status0_address_, 4*NUM_CHANNELS_C, &(status0_shadow[0].reg));
     } 
     else
     {
-        for(int i = 0; i < NUM_CHANNELS_C; i++)
-        {
-            ret[i] = status0_shadow[i].reg;
-        }
-	writeReg(status0_address_, 4*NUM_CHANNELS_C, ret);
+        reqWrite(status0_address_, 4*NUM_CHANNELS_C, &(status0_shadow[0].reg));
     } 
+    waitAll();
     return;
 }
 
 void sce::SysgenCryo::updateStatus1Shadow(bool read) {
-    uint32_t ret[NUM_CHANNELS_C];
     if (read)
     {
-	readReg(status1_address_, 4*NUM_CHANNELS_C, ret);
-        for(int i = 0; i < NUM_CHANNELS_C; i++)
-        {
-            status1_shadow[i].reg = ret[i];
-        }
+        reqRead(status1_address_, 4*NUM_CHANNELS_C, &(status1_shadow[0].reg));
     } 
     else
     {
-        for(int i = 0; i < NUM_CHANNELS_C; i++)
-        {
-            ret[i] = status1_shadow[i].reg;
-        }
-	writeReg(status1_address_, 4*NUM_CHANNELS_C, ret);
+        reqWrite(status1_address_, 4*NUM_CHANNELS_C, &(status1_shadow[0].reg));
     } 
+    waitAll();
     return;
 }
 
 void sce::SysgenCryo::readAll() {
 
-    updateConfig0Shadow(true);
-    updateConfig1Shadow(true);
-    updateStatus0Shadow(true);
-    updateStatus1Shadow(true);
+    snapshot();
 
     return;
 }
 
-bool sce::SysgenCryo::readReg(uint32_t address, size_t size, uint32_t *reg) {
-    uint32_t id;
+double sce::SysgenCryo::snapshot() {
+    // Split the read in chunks of the maximum access size, if the slave can't do it at once
+    uint32_t chunk = this->reqMaxAccess() & ~3u;
+    if (chunk == 0 || chunk > BANKS_SIZE_C)
+    {
+        chunk = BANKS_SIZE_C;
+    }
 
-    this->clearError();
-    id = this->reqTransaction(address, size, reg, rogue::interfaces::memory::Read);
-    this->waitTransaction(id);
+    auto start = std::chrono::system_clock::now();
+    for (uint32_t pos = 0; pos < BANKS_SIZE_C; pos += chunk)
+    {
+        uint32_t size = ( BANKS_SIZE_C - pos < chunk ) ? ( BANKS_SIZE_C - pos ) : chunk;
+        reqRead(offset_ + pos, size, &snapshot_buffer_[pos/4]);
+    }
+    bool ok = waitAll();
+    auto stop = std::chrono::system_clock::now();
 
-    if ( this->getError() != "" ) {
-        printf("got error\n");
-        return false;
+    if (!ok)
+    {
+        return 0;
+    }
+
+    for (int i = 0; i < NUM_CHANNELS_C; i++)
+    {
+        config0_shadow[i].reg = snapshot_buffer_[CONFIG0_BASE_ADDR_C/4 + i];
+        config1_shadow[i].reg = snapshot_buffer_[CONFIG1_BASE_ADDR_C/4 + i];
+        status0_shadow[i].reg = snapshot_buffer_[STATUS0_BASE_ADDR_C/4 + i];
+        status1_shadow[i].reg = snapshot_buffer_[STATUS1_BASE_ADDR_C/4 + i];
     }
-    return true;
+
+    config0_dirty_.reset();
+    config1_dirty_.reset();
+    config0_valid_ = true;
+    config1_valid_ = true;
+
+    snapshot_time_ = std::chrono::duration<double>( ( start + ( stop - start ) / 2 ).time_since_epoch() ).count();
+    return snapshot_time_;
 }
 
+double sce::SysgenCryo::getSnapshotTime() {
+    return snapshot_time_;
+}
 
-bool sce::SysgenCryo::writeReg(uint32_t address, size_t size, uint32_t *reg) {
-    uint32_t id;
+// The conversion kernels work on plain arrays of packed words, with the scale
+// factors precomputed, so that the loops over all the channels are vectorized
+// by the compiler. The single channel methods use the same kernels, with n = 1.
+void sce::SysgenCryo::packEtaMag(const double *values, uint32_t *words, int n) {
+    const double lower = MIN_ETA_MAG_C;
+    const double upper = MAX_ETA_MAG_C;
+    const double scale = ETA_MAG_TO_REG_C;
+    for (int i = 0; i < n; i++)
+    {
+        double   v     = std::min(std::max(values[i], lower), upper);
+        uint32_t field = (uint32_t) (int32_t) round(v * scale);
+        words[i] = (words[i] & 0xFFFF0000) | (field & 0x0000FFFF);
+    }
+    return;
+}
 
-    this->clearError();
-    id = this->reqTransaction(address, size, reg, rogue::interfaces::memory::Write);
-    this->waitTransaction(id);
+void sce::SysgenCryo::unpackEtaMag(const uint32_t *words, double *values, int n) {
+    const double scale = REG_TO_ETA_MAG_C;
+    for (int i = 0; i < n; i++)
+    {
+        values[i] = (double) ( (int32_t) (words[i] << 16) >> 16 ) * scale;
+    }
+    return;
+}
 
-    if ( this->getError() != "" ) {
-        printf("got error\n");
-        return false;
+void sce::SysgenCryo::packEtaPhase(const double *values, uint32_t *words, int n) {
+    const double lower = MIN_ETA_PHASE_C;
+    const double upper = MAX_ETA_PHASE_C;
+    const double scale = ETA_PHASE_TO_REG_C;
+    for (int i = 0; i < n; i++)
+    {
+        double   v     = std::min(std::max(values[i], lower), upper);
+        uint32_t field = (uint32_t) (int32_t) round(v * scale);
+        words[i] = (words[i] & 0x0000FFFF) | (field << 16);
     }
-    return true;
+    return;
 }
 
-void sce::SysgenCryo::setFeedbackEnable(int channel, int enable, bool write) {
-    config1_shadow[channel].feedbackEnable = enable;
+void sce::SysgenCryo::unpackEtaPhase(const uint32_t *words, double *values, int n) {
+    const double scale = REG_TO_ETA_PHASE_C;
+    for (int i = 0; i < n; i++)
+    {
+        values[i] = (double) ( (int32_t) words[i] >> 16 ) * scale;
+    }
+    return;
+}
+
+void sce::SysgenCryo::packCenterFrequency(const double *values, uint32_t *words, int n) {
+    const double lower = MIN_FREQUENCY_C;
+    const double upper = MAX_FREQUENCY_C;
+    const double scale = FREQUENCY_TO_REG_C;
+    for (int i = 0; i < n; i++)
+    {
+        double   v     = std::min(std::max(values[i], lower), upper);
+        uint32_t field = (uint32_t) (int64_t) round(v * scale);
+        words[i] = (words[i] & 0xFF000000) | (field & 0x00FFFFFF);
+    }
+    return;
+}
+
+void sce::SysgenCryo::unpackCenterFrequency(const uint32_t *words, double *values, int n) {
+    const double scale = REG_TO_FREQUENCY_C;
+    for (int i = 0; i < n; i++)
+    {
+        values[i] = (double) ( (int32_t) (words[i] << 8) >> 8 ) * scale;
+    }
+    return;
+}
+
+void sce::SysgenCryo::packAmplitudeScale(const int *values, uint32_t *words, int n) {
+    const int lower = MIN_AMPLITUDE_C;
+    const int upper = MAX_AMPLITUDE_C;
+    for (int i = 0; i < n; i++)
+    {
+        uint32_t field = (uint32_t) std::min(std::max(values[i], lower), upper);
+        words[i] = (words[i] & 0xF0FFFFFF) | (field << 24);
+    }
+    return;
+}
+
+void sce::SysgenCryo::unpackAmplitudeScale(const uint32_t *words, int *values, int n) {
+    for (int i = 0; i < n; i++)
+    {
+        values[i] = (int) ( (words[i] >> 24) & 0xF );
+    }
+    return;
+}
+
+void sce::SysgenCryo::packFeedbackEnable(const int *values, uint32_t *words, int n) {
+    for (int i = 0; i < n; i++)
+    {
+        words[i] = (words[i] & 0x7FFFFFFF) | ( ((uint32_t) values[i] & 0x1) << 31 );
+    }
+    return;
+}
+
+void sce::SysgenCryo::unpackFeedbackEnable(const uint32_t *words, int *values, int n) {
+    for (int i = 0; i < n; i++)
+    {
+        values[i] = (int) (words[i] >> 31);
+    }
+    return;
+}
+
+void sce::SysgenCryo::unpackLoopFilterOutput(const uint32_t *words, double *values, int n) {
+    for (int i = 0; i < n; i++)
+    {
+        values[i] = (double) ( (int32_t) (words[i] << 8) >> 8 );
+    }
+    return;
+}
+
+void sce::SysgenCryo::unpackFrequencyError(const uint32_t *words, double *values, int n) {
+    const double scale = REG_TO_FREQ_ERROR_C;
+    for (int i = 0; i < n; i++)
+    {
+        values[i] = (double) ( (int32_t) (words[i] << 8) >> 8 ) * scale;
+    }
+    return;
+}
+
+void sce::SysgenCryo::storeConfig0(const uint32_t *words) {
+    for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
+    {
+        if ( !config0_valid_ || config0_shadow[channel].reg != words[channel] )
+        {
+            config0_shadow[channel].reg = words[channel];
+            config0_dirty_.set(channel);
+        }
+    }
+    return;
+}
+
+void sce::SysgenCryo::storeConfig1(const uint32_t *words) {
+    for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
+    {
+        if ( !config1_valid_ || config1_shadow[channel].reg != words[channel] )
+        {
+            config1_shadow[channel].reg = words[channel];
+            config1_dirty_.set(channel);
+        }
+    }
+    return;
+}
+
+
+void sce::SysgenCryo::commitConfig0(int channel, uint32_t old, bool write) {
+    if (write)
+    {
+        writeReg(config0_address_ + 4*channel, 4, &(config0_shadow[channel].reg));
+        config0_dirty_.reset(channel);
+    }
+    else if ( !config0_valid_ || config0_shadow[channel].reg != old )
+    {
+        config0_dirty_.set(channel);
+    }
+    return;
+}
+
+void sce::SysgenCryo::commitConfig1(int channel, uint32_t old, bool write) {
     if (write)
     {
         writeReg(config1_address_ + 4*channel, 4, &(config1_shadow[channel].reg));
+        config1_dirty_.reset(channel);
     }
+    else if ( !config1_valid_ || config1_shadow[channel].reg != old )
+    {
+        config1_dirty_.set(channel);
+    }
+    return;
+}
+
+int sce::SysgenCryo::flushBank(uint32_t address, uint32_t *shadow, std::bitset<NUM_CHANNELS_C> &dirty, bool valid,
+                               const std::bitset<NUM_CHANNELS_C> &mask) {
+    int transactions = 0;
+    int channel      = 0;
+
+    while (channel < NUM_CHANNELS_C)
+    {
+        if (!dirty.test(channel) || !mask.test(channel))
+        {
+            ++channel;
+            continue;
+        }
+
+        // Extend the range over the following dirty words. If the shadow is valid, the
+        // clean words match the registers, so short gaps of clean words can be included.
+        // A dirty word outside the mask ends the range, as it must not be written.
+        int first = channel;
+        int last  = channel;
+        for (int next = channel + 1; next < NUM_CHANNELS_C; ++next)
+        {
+            if (dirty.test(next))
+            {
+                if ( !mask.test(next) || next - last - 1 > ( valid ? FLUSH_MAX_GAP_C : 0 ) )
+                {
+                    break;
+                }
+                last = next;
+            }
+        }
+
+        reqWrite(address + 4*first, 4*(last - first + 1), &shadow[first]);
+        ++transactions;
+        channel = last + 1;
+
+        for (int i = first; i <= last; ++i)
+        {
+            dirty.reset(i);
+        }
+    }
+
+    return transactions;
+}
+
+int sce::SysgenCryo::flush() {
+    std::bitset<NUM_CHANNELS_C> all;
+    all.set();
+    return flushChannels(all);
+}
+
+int sce::SysgenCryo::flushChannels(const std::bitset<NUM_CHANNELS_C> &channels) {
+    int transactions = 0;
+
+    // The config shadows are arrays of 32-bit words
+    transactions += flushBank(config0_address_, &(config0_shadow[0].reg), config0_dirty_, config0_valid_, channels);
+    transactions += flushBank(config1_address_, &(config1_shadow[0].reg), config1_dirty_, config1_valid_, channels);
+    waitAll();
+
+    return transactions;
+}
+
+int sce::SysgenCryo::getDirtyCount() {
+    return config0_dirty_.count() + config1_dirty_.count();
+}
+
+bool sce::SysgenCryo::readReg(uint32_t address, size_t size, uint32_t *reg) {
+    return waitFor(reqRead(address, size, reg));
+}
+
+
+bool sce::SysgenCryo::writeReg(uint32_t address, size_t size, uint32_t *reg) {
+    return waitFor(reqWrite(address, size, reg));
+}
+
+uint32_t sce::SysgenCryo::reqRead(uint32_t address, size_t size, uint32_t *reg, std::function<void(bool)> callback) {
+    return reqAsync(address, size, reg, rogue::interfaces::memory::Read, callback);
+}
+
+uint32_t sce::SysgenCryo::reqWrite(uint32_t address, size_t size, const uint32_t *reg, std::function<void(bool)> callback) {
+    return reqAsync(address, size, const_cast<uint32_t*>(reg), rogue::interfaces::memory::Write, callback);
+}
+
+uint32_t sce::SysgenCryo::reqAsync(uint32_t address, size_t size, uint32_t *reg, uint32_t type, std::function<void(bool)> callback) {
+    // Bound the number of outstanding transactions
+    while ( pending_.size() >= max_in_flight_ )
+    {
+        completeOldest();
+    }
+
+    pending_.push_back(pending_transaction());
+    pending_transaction &tran = pending_.back();
+    tran.callback = callback;
+
+    // Copy the write data, so that the caller can change its buffer
+    // (usually a shadow register) before the transaction completes
+    void *data = reg;
+    if (type == rogue::interfaces::memory::Write)
+    {
+        tran.data.assign(reg, reg + size/4);
+        data = tran.data.data();
+    }
+
+    tran.id = this->reqTransaction(address, size, data, type);
+    return tran.id;
+}
+
+bool sce::SysgenCryo::completeOldest() {
+    if (pending_.empty())
+    {
+        return true;
+    }
+
+    // The transaction (and its data) is removed from the queue only after it completes
+    pending_transaction &tran = pending_.front();
+    this->waitTransaction(tran.id);
+
+    bool ok = ( this->getError() == "" );
+    if (!ok)
+    {
+        printf("got error\n");
+        this->clearError();
+    }
+
+    if (tran.callback)
+    {
+        tran.callback(ok);
+    }
+
+    pending_.pop_front();
+    return ok;
+}
 
+bool sce::SysgenCryo::waitAll() {
+    bool ok = true;
+    while (!pending_.empty())
+    {
+        ok &= completeOldest();
+    }
+    return ok;
+}
+
+bool sce::SysgenCryo::waitFor(uint32_t id) {
+    bool ok = true;
+    while (!pending_.empty())
+    {
+        bool last = ( pending_.front().id == id );
+        ok &= completeOldest();
+        if (last)
+        {
+            break;
+        }
+    }
+    return ok;
+}
+
+void sce::SysgenCryo::setMaxInFlight(size_t max_in_flight) {
+    max_in_flight_ = ( max_in_flight < 1 ) ? 1 : max_in_flight;
+    return;
+}
+
+size_t sce::SysgenCryo::getMaxInFlight() {
+    return max_in_flight_;
+}
+
+size_t sce::SysgenCryo::getInFlight() {
+    return pending_.size();
+}
+
+void sce::SysgenCryo::setScanDwell(uint32_t dwell) {
+    scan_dwell_ = dwell;
+    return;
+}
+
+uint32_t sce::SysgenCryo::getScanDwell() {
+    return scan_dwell_;
+}
+
+void sce::SysgenCryo::setFeedbackEnable(int channel, int enable, bool write) {
+    uint32_t old = config1_shadow[channel].reg;
+    packFeedbackEnable(&enable, &(config1_shadow[channel].reg), 1);
+    commitConfig1(channel, old, write);
     return;
 }
 
-int sce::SysgenCryo::getFeedbackEnable(int channel, bool read) { 
+int sce::SysgenCryo::getFeedbackEnable(int channel, bool read) {
     if (read)
     {
         readReg(config1_address_ + 4*channel, 4, &(config1_shadow[channel].reg));
+        config1_dirty_.reset(channel);
     }
-    return config1_shadow[channel].feedbackEnable;
+    int value;
+    unpackFeedbackEnable(&(config1_shadow[channel].reg), &value, 1);
+    return value;
 }
 
 void sce::SysgenCryo::setFeedbackEnableArray(std::vector<int> array, bool write) {
+    if (array.size() < NUM_CHANNELS_C)
+    {
+        printf("Invalid array size\n");
+        return;
+    }
+    setFeedbackEnableArray(array.data(), write);
+    return;
+}
+
+void sce::SysgenCryo::setFeedbackEnableArray(const int *array, bool write) {
+    uint32_t words[NUM_CHANNELS_C];
     for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
     {
-        setFeedbackEnable(channel, array[channel], false);
-    } 
+        words[channel] = config1_shadow[channel].reg;
+    }
+    packFeedbackEnable(array, words, NUM_CHANNELS_C);
+    storeConfig1(words);
     if (write)
     { 
-        updateConfig1Shadow( false );
+        flush();
     } 
     return;
 }
 
 void sce::SysgenCryo::setFeedbackEnableArrayPy( const bp::object& iterable, bool write ) {
-    std::vector<int> array = py_list_to_std_vector<int>( iterable );
-    setFeedbackEnableArray( array, write);
+    np::ndarray array = py_to_ndarray<int>( iterable );
+    if (array.shape(0) < NUM_CHANNELS_C)
+    {
+        printf("Invalid array size\n");
+        return;
+    }
+    setFeedbackEnableArray( reinterpret_cast<const int*>( array.get_data() ), write );
     return;
 }
 
 std::vector<int> sce::SysgenCryo::getFeedbackEnableArray( bool read ) {
-    std::vector<int> array(512);
+    std::vector<int> array(NUM_CHANNELS_C);
+    getFeedbackEnableArray(array.data(), read);
+    return array;
+}
+
+void sce::SysgenCryo::getFeedbackEnableArray(int *array, bool read) {
     if (read)
     {
         updateConfig1Shadow( true );
     }
-    for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
-    {
-        array[channel] = getFeedbackEnable(channel, false);
-    } 
-    return array;
+    unpackFeedbackEnable(&(config1_shadow[0].reg), array, NUM_CHANNELS_C);
+    return;
 }
 
-bp::list sce::SysgenCryo::getFeedbackEnableArrayPy( bool read ) {
-    std::vector<int> array;
-    bp::list list;
-    array = getFeedbackEnableArray( read );
-    list = std_vector_to_py_list<int>( array );
-    return list;
+np::ndarray sce::SysgenCryo::getFeedbackEnableArrayPy( bool read ) {
+    np::ndarray array = new_ndarray<int>( NUM_CHANNELS_C );
+    getFeedbackEnableArray( reinterpret_cast<int*>( array.get_data() ), read );
+    return array;
 }
 
 void sce::SysgenCryo::setCenterFrequencyMHz(int channel, double frequency, bool write) {
-    frequency = clamp(frequency, MIN_FREQUENCY_C, MAX_FREQUENCY_C);
-    config1_shadow[channel].centerFrequency = (int) round( frequency * pow(2, 24) / FREQUENCY_SPAN_C * 1e6 );
-    if (write)
-    {
-        writeReg(config1_address_ + 4*channel, 4, &(config1_shadow[channel].reg));
-    }
+    uint32_t old = config1_shadow[channel].reg;
+    packCenterFrequency(&frequency, &(config1_shadow[channel].reg), 1);
+    commitConfig1(channel, old, write);
     return;
 }
 
@@ -215,56 +567,74 @@ double sce::SysgenCryo::getCenterFrequencyMHz(int channel, bool read) {
     if (read)
     {
         readReg(config1_address_ + 4*channel, 4, &(config1_shadow[channel].reg));
+        config1_dirty_.reset(channel);
     }
-    return ( (double) config1_shadow[channel].centerFrequency ) * pow(2, -24) * FREQUENCY_SPAN_C * 1e-6;
+    double value;
+    unpackCenterFrequency(&(config1_shadow[channel].reg), &value, 1);
+    return value;
 }
 
 void sce::SysgenCryo::setCenterFrequencyArray(std::vector<double> array, bool write) {
+    if (array.size() < NUM_CHANNELS_C)
+    {
+        printf("Invalid array size\n");
+        return;
+    }
+    setCenterFrequencyArray(array.data(), write);
+    return;
+}
+
+void sce::SysgenCryo::setCenterFrequencyArray(const double *array, bool write) {
+    uint32_t words[NUM_CHANNELS_C];
     for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
     {
-        setCenterFrequencyMHz(channel, array[channel], false);
-    } 
+        words[channel] = config1_shadow[channel].reg;
+    }
+    packCenterFrequency(array, words, NUM_CHANNELS_C);
+    storeConfig1(words);
     if (write)
     { 
-        updateConfig1Shadow( false );
+        flush();
     } 
     return;
 }
 
 void sce::SysgenCryo::setCenterFrequencyArrayPy( const bp::object& iterable, bool write ) {
-    std::vector<double> array = py_list_to_std_vector<double>( iterable );
-    setCenterFrequencyArray( array, write);
+    np::ndarray array = py_to_ndarray<double>( iterable );
+    if (array.shape(0) < NUM_CHANNELS_C)
+    {
+        printf("Invalid array size\n");
+        return;
+    }
+    setCenterFrequencyArray( reinterpret_cast<const double*>( array.get_data() ), write );
     return;
 }
 
 std::vector<double> sce::SysgenCryo::getCenterFrequencyArray( bool read ) {
-    std::vector<double> array(512);
+    std::vector<double> array(NUM_CHANNELS_C);
+    getCenterFrequencyArray(array.data(), read);
+    return array;
+}
+
+void sce::SysgenCryo::getCenterFrequencyArray(double *array, bool read) {
     if (read)
     {
         updateConfig1Shadow( true );
     }
-    for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
-    {
-        array[channel] = getCenterFrequencyMHz(channel, false);
-    } 
-    return array;
+    unpackCenterFrequency(&(config1_shadow[0].reg), array, NUM_CHANNELS_C);
+    return;
 }
 
-bp::list sce::SysgenCryo::getCenterFrequencyArrayPy( bool read ) {
-    std::vector<double> array;
-    bp::list list;
-    array = getCenterFrequencyArray( read );
-    list = std_vector_to_py_list<double>( array );
-    return list;
+np::ndarray sce::SysgenCryo::getCenterFrequencyArrayPy( bool read ) {
+    np::ndarray array = new_ndarray<double>( NUM_CHANNELS_C );
+    getCenterFrequencyArray( reinterpret_cast<double*>( array.get_data() ), read );
+    return array;
 }
 
 void sce::SysgenCryo::setAmplitudeScale(int channel, int amplitude, bool write) {
-    amplitude = clamp(amplitude, MIN_AMPLITUDE_C, MAX_AMPLITUDE_C);
-    config1_shadow[channel].amplitudeScale = amplitude;
-    if (write)
-    {
-        writeReg(config1_address_ + 4*channel, 4, &(config1_shadow[channel].reg));
-    }
+    uint32_t old = config1_shadow[channel].reg;
+    packAmplitudeScale(&amplitude, &(config1_shadow[channel].reg), 1);
+    commitConfig1(channel, old, write);
     return;
 }
 
@@ -272,47 +642,68 @@ int sce::SysgenCryo::getAmplitudeScale(int channel, bool read) {
     if (read)
     {
         readReg(config1_address_ + 4*channel, 4, &(config1_shadow[channel].reg));
+        config1_dirty_.reset(channel);
     }
-    return config1_shadow[channel].amplitudeScale;
+    int value;
+    unpackAmplitudeScale(&(config1_shadow[channel].reg), &value, 1);
+    return value;
 }
 
 void sce::SysgenCryo::setAmplitudeScaleArray(std::vector<int> array, bool write) {
+    if (array.size() < NUM_CHANNELS_C)
+    {
+        printf("Invalid array size\n");
+        return;
+    }
+    setAmplitudeScaleArray(array.data(), write);
+    return;
+}
+
+void sce::SysgenCryo::setAmplitudeScaleArray(const int *array, bool write) {
+    uint32_t words[NUM_CHANNELS_C];
     for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
     {
-        setAmplitudeScale(channel, array[channel], false);
-    } 
+        words[channel] = config1_shadow[channel].reg;
+    }
+    packAmplitudeScale(array, words, NUM_CHANNELS_C);
+    storeConfig1(words);
     if (write)
     { 
-        updateConfig1Shadow( false );
+        flush();
     } 
     return;
 }
 
 void sce::SysgenCryo::setAmplitudeScaleArrayPy( const bp::object& iterable, bool write ) {
-    std::vector<int> array = py_list_to_std_vector<int>( iterable );
-    setAmplitudeScaleArray(array, write);
+    np::ndarray array = py_to_ndarray<int>( iterable );
+    if (array.shape(0) < NUM_CHANNELS_C)
+    {
+        printf("Invalid array size\n");
+        return;
+    }
+    setAmplitudeScaleArray( reinterpret_cast<const int*>( array.get_data() ), write );
     return;
 }
 
 std::vector<int> sce::SysgenCryo::getAmplitudeScaleArray( bool read ) {
-    std::vector<int> array(512);
+    std::vector<int> array(NUM_CHANNELS_C);
+    getAmplitudeScaleArray(array.data(), read);
+    return array;
+}
+
+void sce::SysgenCryo::getAmplitudeScaleArray(int *array, bool read) {
     if (read)
     {
         updateConfig1Shadow( true );
     }
-    for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
-    {
-        array[channel] = getAmplitudeScale(channel, false);
-    } 
-    return array;
+    unpackAmplitudeScale(&(config1_shadow[0].reg), array, NUM_CHANNELS_C);
+    return;
 }
 
-bp::list sce::SysgenCryo::getAmplitudeScaleArrayPy( bool read ) {
-    std::vector<int> array;
-    bp::list list;
-    array = getAmplitudeScaleArray( read );
-    list = std_vector_to_py_list<int>( array );
-    return list;
+np::ndarray sce::SysgenCryo::getAmplitudeScaleArrayPy( bool read ) {
+    np::ndarray array = new_ndarray<int>( NUM_CHANNELS_C );
+    getAmplitudeScaleArray( reinterpret_cast<int*>( array.get_data() ), read );
+    return array;
 }
 
 int sce::SysgenCryo::getAmplitudeReadback(int channel, bool read) {
@@ -324,12 +715,9 @@ int sce::SysgenCryo::getAmplitudeReadback(int channel, bool read) {
 }
 
 void sce::SysgenCryo::setEtaPhaseDegree(int channel, double etaPhase, bool write) {
-    etaPhase = clamp(etaPhase, MIN_ETA_PHASE_C, MAX_ETA_PHASE_C);
-    config0_shadow[channel].etaPhase = (int) round( etaPhase * pow(2, 15) / 180.0 );
-    if (write)
-    {
-        writeReg(config0_address_ + 4*channel, 4, &(config0_shadow[channel].reg));
-    }
+    uint32_t old = config0_shadow[channel].reg;
+    packEtaPhase(&etaPhase, &(config0_shadow[channel].reg), 1);
+    commitConfig0(channel, old, write);
     return;
 }
 
@@ -337,56 +725,74 @@ double sce::SysgenCryo::getEtaPhaseDegree(int channel, bool read) {
     if (read)
     {
         readReg(config0_address_ + 4*channel, 4, &(config0_shadow[channel].reg));
+        config0_dirty_.reset(channel);
     }
-    return ( (double) config0_shadow[channel].etaPhase ) * pow(2, -15) * 180.0;
+    double value;
+    unpackEtaPhase(&(config0_shadow[channel].reg), &value, 1);
+    return value;
 }
 
 void sce::SysgenCryo::setEtaPhaseArray(std::vector<double> etaPhase, bool write) {
+    if (etaPhase.size() < NUM_CHANNELS_C)
+    {
+        printf("Invalid array size\n");
+        return;
+    }
+    setEtaPhaseArray(etaPhase.data(), write);
+    return;
+}
+
+void sce::SysgenCryo::setEtaPhaseArray(const double *etaPhase, bool write) {
+    uint32_t words[NUM_CHANNELS_C];
     for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
     {
-        setEtaPhaseDegree(channel, etaPhase[channel], false);
-    } 
+        words[channel] = config0_shadow[channel].reg;
+    }
+    packEtaPhase(etaPhase, words, NUM_CHANNELS_C);
+    storeConfig0(words);
     if (write)
     { 
-        updateConfig0Shadow( false );
+        flush();
     } 
     return;
 }
 
 void sce::SysgenCryo::setEtaPhaseArrayPy( const bp::object& iterable, bool write ) {
-    std::vector<double> etaPhaseArray= py_list_to_std_vector<double>( iterable );
-    setEtaPhaseArray( etaPhaseArray, write);
+    np::ndarray array = py_to_ndarray<double>( iterable );
+    if (array.shape(0) < NUM_CHANNELS_C)
+    {
+        printf("Invalid array size\n");
+        return;
+    }
+    setEtaPhaseArray( reinterpret_cast<const double*>( array.get_data() ), write );
     return;
 }
 
 std::vector<double> sce::SysgenCryo::getEtaPhaseArray( bool read ) {
-    std::vector<double> etaPhaseArray(512);
+    std::vector<double> etaPhase(NUM_CHANNELS_C);
+    getEtaPhaseArray(etaPhase.data(), read);
+    return etaPhase;
+}
+
+void sce::SysgenCryo::getEtaPhaseArray(double *etaPhase, bool read) {
     if (read)
     {
         updateConfig0Shadow( true );
     }
-    for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
-    {
-        etaPhaseArray[channel] = getEtaPhaseDegree(channel, false);
-    } 
-    return etaPhaseArray;
+    unpackEtaPhase(&(config0_shadow[0].reg), etaPhase, NUM_CHANNELS_C);
+    return;
 }
 
-bp::list sce::SysgenCryo::getEtaPhaseArrayPy( bool read ) {
-    std::vector<double> etaPhaseArray;
-    bp::list list;
-    etaPhaseArray = getEtaPhaseArray( read );
-    list = std_vector_to_py_list<double>( etaPhaseArray );
-    return list;
+np::ndarray sce::SysgenCryo::getEtaPhaseArrayPy( bool read ) {
+    np::ndarray array = new_ndarray<double>( NUM_CHANNELS_C );
+    getEtaPhaseArray( reinterpret_cast<double*>( array.get_data() ), read );
+    return array;
 }
 
 void sce::SysgenCryo::setEtaMagScaled(int channel, double etaMag, bool write) {
-    etaMag = clamp(etaMag, MIN_ETA_MAG_C, MAX_ETA_MAG_C);
-    config0_shadow[channel].etaMag = (int) round( etaMag * pow(2, 10) );
-    if (write)
-    {
-        writeReg(config0_address_ + 4*channel, 4, &(config0_shadow[channel].reg));
-    }
+    uint32_t old = config0_shadow[channel].reg;
+    packEtaMag(&etaMag, &(config0_shadow[channel].reg), 1);
+    commitConfig0(channel, old, write);
     return;
 }
 
@@ -394,47 +800,68 @@ double sce::SysgenCryo::getEtaMagScaled(int channel, bool read) {
     if (read)
     {
         readReg(config0_address_ + 4*channel, 4, &(config0_shadow[channel].reg));
+        config0_dirty_.reset(channel);
     }
-    return ( (double) config0_shadow[channel].etaMag ) * pow(2, -10);
+    double value;
+    unpackEtaMag(&(config0_shadow[channel].reg), &value, 1);
+    return value;
 }
 
 void sce::SysgenCryo::setEtaMagArray(std::vector<double> etaMag, bool write) {
-    for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
+    if (etaMag.size() < NUM_CHANNELS_C)
     {
-        setEtaMagScaled(channel, etaMag[channel], false);
-    } 
-    if (write)
+        printf("Invalid array size\n");
+        return;
+    }
+    setEtaMagArray(etaMag.data(), write);
+    return;
+}
+
+void sce::SysgenCryo::setEtaMagArray(const double *etaMag, bool write) {
+    uint32_t words[NUM_CHANNELS_C];
+    for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
     {
-        updateConfig0Shadow( false );
+        words[channel] = config0_shadow[channel].reg;
     }
+    packEtaMag(etaMag, words, NUM_CHANNELS_C);
+    storeConfig0(words);
+    if (write)
+    { 
+        flush();
+    } 
     return;
 }
 
 void sce::SysgenCryo::setEtaMagArrayPy( const bp::object& iterable, bool write ) {
-    std::vector<double> etaMagArray = py_list_to_std_vector<double>( iterable );
-    setEtaMagArray( etaMagArray, write);
+    np::ndarray array = py_to_ndarray<double>( iterable );
+    if (array.shape(0) < NUM_CHANNELS_C)
+    {
+        printf("Invalid array size\n");
+        return;
+    }
+    setEtaMagArray( reinterpret_cast<const double*>( array.get_data() ), write );
     return;
 }
 
 std::vector<double> sce::SysgenCryo::getEtaMagArray( bool read ) {
-    std::vector<double> etaMagArray(512);
+    std::vector<double> etaMag(NUM_CHANNELS_C);
+    getEtaMagArray(etaMag.data(), read);
+    return etaMag;
+}
+
+void sce::SysgenCryo::getEtaMagArray(double *etaMag, bool read) {
     if (read)
     {
         updateConfig0Shadow( true );
     }
-    for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
-    {
-        etaMagArray[channel] = getEtaMagScaled(channel, false);
-    } 
-    return etaMagArray;
+    unpackEtaMag(&(config0_shadow[0].reg), etaMag, NUM_CHANNELS_C);
+    return;
 }
 
-bp::list sce::SysgenCryo::getEtaMagArrayPy( bool read ) {
-    std::vector<double> array;
-    bp::list list;
-    array = getEtaMagArray( read );
-    list = std_vector_to_py_list<double>( array );
-    return list;
+np::ndarray sce::SysgenCryo::getEtaMagArrayPy( bool read ) {
+    np::ndarray array = new_ndarray<double>( NUM_CHANNELS_C );
+    getEtaMagArray( reinterpret_cast<double*>( array.get_data() ), read );
+    return array;
 }
 
 void sce::SysgenCryo::regReadTest(int nloops)
@@ -454,6 +881,21 @@ void sce::SysgenCryo::regReadTest(int nloops)
     printf("  Duration: %f\n", (double)duration.count());
     printf("  Hz: %f\n", hz);
 
+    // Same reads, but keeping up to max_in_flight_ transactions outstanding
+    uint32_t ret[NUM_CHANNELS_C];
+    start = std::chrono::high_resolution_clock::now();
+    for(int i = 0; i < nloops; i++)
+    {
+        reqRead(config0_address_, 4*NUM_CHANNELS_C, ret);
+    }
+    waitAll();
+    stop = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+    hz = ((double)nloops)/(((double)duration.count())*1e-6);
+    printf("Pipelined (max in flight: %zu)\n", max_in_flight_);
+    printf("  Duration: %f\n", (double)duration.count());
+    printf("  Hz: %f\n", hz);
+
 }
 
 double sce::SysgenCryo::getLoopFilterOutput(int channel, bool read) {
@@ -461,28 +903,30 @@ double sce::SysgenCryo::getLoopFilterOutput(int channel, bool read) {
     {
         readReg(status0_address_ + 4*channel, 4, &(status0_shadow[channel].reg));
     }
-    return status0_shadow[channel].loopFilterOutput;
+    double value;
+    unpackLoopFilterOutput(&(status0_shadow[channel].reg), &value, 1);
+    return value;
 }
 
 std::vector<double> sce::SysgenCryo::getLoopFilterOutputArray( bool read ) {
-    std::vector<double> array(512);
+    std::vector<double> array(NUM_CHANNELS_C);
+    getLoopFilterOutputArray(array.data(), read);
+    return array;
+}
+
+void sce::SysgenCryo::getLoopFilterOutputArray(double *array, bool read) {
     if (read)
     {
         updateStatus0Shadow( true );
     }
-    for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
-    {
-        array[channel] = sce::SysgenCryo::getLoopFilterOutput(channel, false);
-    } 
-    return array;
+    unpackLoopFilterOutput(&(status0_shadow[0].reg), array, NUM_CHANNELS_C);
+    return;
 }
 
-bp::list sce::SysgenCryo::getLoopFilterOutputArrayPy( bool read ) {
-    std::vector<double> array;
-    bp::list list;
-    array = getLoopFilterOutputArray( read );
-    list = std_vector_to_py_list<double>( array );
-    return list;
+np::ndarray sce::SysgenCryo::getLoopFilterOutputArrayPy( bool read ) {
+    np::ndarray array = new_ndarray<double>( NUM_CHANNELS_C );
+    getLoopFilterOutputArray( reinterpret_cast<double*>( array.get_data() ), read );
+    return array;
 }
 
 double sce::SysgenCryo::getFrequencyErrorMHz(int channel, bool read) {
@@ -490,28 +934,30 @@ double sce::SysgenCryo::getFrequencyErrorMHz(int channel, bool read) {
     {
         readReg(status1_address_ + 4*channel, 4, &(status1_shadow[channel].reg));
     }
-    return ( (double) status1_shadow[channel].frequencyError ) * pow(2, -23) * FREQUENCY_SPAN_C * 1e-6;
+    double value;
+    unpackFrequencyError(&(status1_shadow[channel].reg), &value, 1);
+    return value;
 }
 
 std::vector<double> sce::SysgenCryo::getFrequencyErrorArray( bool read ) {
-    std::vector<double> array(512);
+    std::vector<double> array(NUM_CHANNELS_C);
+    getFrequencyErrorArray(array.data(), read);
+    return array;
+}
+
+void sce::SysgenCryo::getFrequencyErrorArray(double *array, bool read) {
     if (read)
     {
         updateStatus1Shadow( true );
     }
-    for (int channel = 0; channel < NUM_CHANNELS_C; channel++)
-    {
-        array[channel] = getFrequencyErrorMHz(channel, false);
-    } 
-    return array;
+    unpackFrequencyError(&(status1_shadow[0].reg), array, NUM_CHANNELS_C);
+    return;
 }
 
-bp::list sce::SysgenCryo::getFrequencyErrorArrayPy( bool read ) {
-    std::vector<double> array;
-    bp::list list;
-    array = getFrequencyErrorArray( read );
-    list = std_vector_to_py_list<double>( array );
-    return list;
+np::ndarray sce::SysgenCryo::getFrequencyErrorArrayPy( bool read ) {
+    np::ndarray array = new_ndarray<double>( NUM_CHANNELS_C );
+    getFrequencyErrorArray( reinterpret_cast<double*>( array.get_data() ), read );
+    return array;
 }
 
 
@@ -534,24 +980,56 @@ std::vector<double> sce::SysgenCryo::getResultsReal() {
     return results_real_;
 }
 
-bp::list sce::SysgenCryo::getResultsRealPy() {
-    std::vector<double> array;
-    bp::list list;
-    array = getResultsReal();
-    list = std_vector_to_py_list<double>( array );
-    return list;
+np::ndarray sce::SysgenCryo::getResultsRealPy() {
+    std::vector<double> array = getResultsReal();
+    np::ndarray ndarray = new_ndarray<double>( array.size() );
+    std::copy( array.begin(), array.end(), reinterpret_cast<double*>( ndarray.get_data() ) );
+    return ndarray;
 }
 
 std::vector<double> sce::SysgenCryo::getResultsImag() {
     return results_imag_;
 }
 
-bp::list sce::SysgenCryo::getResultsImagPy() {
-    std::vector<double> array;
-    bp::list list;
-    array = getResultsImag();
-    list = std_vector_to_py_list<double>( array );
-    return list;
+np::ndarray sce::SysgenCryo::getResultsImagPy() {
+    std::vector<double> array = getResultsImag();
+    np::ndarray ndarray = new_ndarray<double>( array.size() );
+    std::copy( array.begin(), array.end(), reinterpret_cast<double*>( ndarray.get_data() ) );
+    return ndarray;
+}
+
+void sce::SysgenCryo::sweepChannel(int channel, double centerFrequency, const std::vector<double> &frequencies, double *results) {
+    std::vector<uint32_t> raw(frequencies.size());
+
+    // Queue a frequency write and a frequency error read for each point. The
+    // transactions are processed in order. With a dwell time, each write is
+    // completed, and the read is done after the dwell time, so that it sees
+    // its own point after the DSP settled.
+    for(size_t i = 0; i < frequencies.size(); i++)
+    { 
+        setCenterFrequencyMHz(channel, centerFrequency + frequencies[i], false);
+        reqWrite(config1_address_ + 4*channel, 4, &(config1_shadow[channel].reg));
+        if (scan_dwell_)
+        {
+            waitAll();
+            usleep(scan_dwell_);
+        }
+        reqRead(status1_address_ + 4*channel, 4, &raw[i]);
+    } 
+    waitAll();
+
+    status1 value;
+    for(size_t i = 0; i < frequencies.size(); i++)
+    { 
+        value.reg  = raw[i];
+        results[i] = value.frequencyError;
+    } 
+
+    if (!raw.empty())
+    {
+        status1_shadow[channel].reg = raw.back();
+    }
+    return;
 }
 
 void sce::SysgenCryo::runEtaScan(std::vector<int> channels, int amplitude, std::vector<double> frequencies) {
@@ -561,11 +1039,27 @@ void sce::SysgenCryo::runEtaScan(std::vector<int> channels, int amplitude, std::
     std::vector<double> resultsReal(total_points);
     std::vector<double> resultsImag(total_points);
 
+    // Write the pending configuration changes of the scanned channels first. The
+    // changes of the other channels stay pending.
+    std::bitset<NUM_CHANNELS_C> scanned;
+    for (int i = 0; i < num_channels; ++i)
+    {
+        if (channels[i] < 0 || channels[i] >= NUM_CHANNELS_C)
+        {
+            printf("Invalid channel number\n");
+            return;
+        }
+        scanned.set(channels[i]);
+    }
+    flushChannels(scanned);
+
     // turn off all channels
     for (int i = 0; i < num_channels; ++i)
     { 
-        setAmplitudeScale(channels[i], 0, true);
+        setAmplitudeScale(channels[i], 0, false);
+        reqWrite(config1_address_ + 4*channels[i], 4, &(config1_shadow[channels[i]].reg));
     } 
+    waitAll();
 
     for (int i = 0; i < num_channels; ++i)
     {
@@ -573,41 +1067,375 @@ void sce::SysgenCryo::runEtaScan(std::vector<int> channels, int amplitude, std::
 	int offset  = i*freqs_per_channel;
 	double centerFrequency = getCenterFrequencyMHz(channel, false);
 
-        setAmplitudeScale(channel, amplitude, true);
-        setFeedbackEnable(channel, 0, true);
-        setEtaMagScaled(channel, 1.0, true);
-        setEtaPhaseDegree(channel, 0.0, true);
-        setCenterFrequencyMHz(channel, frequencies[0], true);
+        setAmplitudeScale(channel, amplitude, false);
+        setFeedbackEnable(channel, 0, false);
+        reqWrite(config1_address_ + 4*channel, 4, &(config1_shadow[channel].reg));
+        setEtaMagScaled(channel, 1.0, false);
+        setEtaPhaseDegree(channel, 0.0, false);
+        reqWrite(config0_address_ + 4*channel, 4, &(config0_shadow[channel].reg));
+        setCenterFrequencyMHz(channel, frequencies[0], false);
+        reqWrite(config1_address_ + 4*channel, 4, &(config1_shadow[channel].reg));
+        waitAll();
         usleep(100);
-        for(int i = 0; i < frequencies.size(); i++)
-        { 
-            setCenterFrequencyMHz(channel, centerFrequency + frequencies[i], true);
-            readReg(status1_address_ + 4*channel, 4, &(status1_shadow[channel].reg));
-            resultsReal[offset + i] = status1_shadow[channel].frequencyError;
-        } 
-
-        setEtaPhaseDegree(channel, -90.0, true);
-        setCenterFrequencyMHz(channel, frequencies[0], true);
+        sweepChannel(channel, centerFrequency, frequencies, &resultsReal[offset]);
+
+        setEtaPhaseDegree(channel, -90.0, false);
+        reqWrite(config0_address_ + 4*channel, 4, &(config0_shadow[channel].reg));
+        setCenterFrequencyMHz(channel, frequencies[0], false);
+        reqWrite(config1_address_ + 4*channel, 4, &(config1_shadow[channel].reg));
+        waitAll();
         usleep(100);
-        for(int i = 0; i < frequencies.size(); i++)
-        { 
-            setCenterFrequencyMHz(channel, centerFrequency + frequencies[i], true);
-            readReg(status1_address_ + 4*channel, 4, &(status1_shadow[channel].reg));
-            resultsImag[offset + i] = status1_shadow[channel].frequencyError;
-        } 
+        sweepChannel(channel, centerFrequency, frequencies, &resultsImag[offset]);
 	
-        setCenterFrequencyMHz(channel, centerFrequency, true);
-        setAmplitudeScale(channel, 0, true);
+        setCenterFrequencyMHz(channel, centerFrequency, false);
+        setAmplitudeScale(channel, 0, false);
+        reqWrite(config1_address_ + 4*channel, 4, &(config1_shadow[channel].reg));
     }
-    results_real_ = resultsReal;
-    results_imag_ = resultsImag;
+    waitAll();
+
+    // The scanned channels were written directly
+    for (int i = 0; i < num_channels; ++i)
+    {
+        config0_dirty_.reset(channels[i]);
+        config1_dirty_.reset(channels[i]);
+    }
+    results_real_     = resultsReal;
+    results_imag_     = resultsImag;
+    scan_channels_    = channels;
+    scan_frequencies_ = frequencies;
     return;
 }
 
 void sce::SysgenCryo::runEtaScanPy(const bp::object &channelspy, int amplitude, const bp::object &iterable) {
-    std::vector<double> frequencies = py_list_to_std_vector<double>( iterable );
-    std::vector<int> channels = py_list_to_std_vector<int>( channelspy );
+    np::ndarray frequenciesnp = py_to_ndarray<double>( iterable );
+    np::ndarray channelsnp    = py_to_ndarray<int>( channelspy );
+    const double *f = reinterpret_cast<const double*>( frequenciesnp.get_data() );
+    const int    *c = reinterpret_cast<const int*>( channelsnp.get_data() );
+    std::vector<double> frequencies(f, f + frequenciesnp.shape(0));
+    std::vector<int> channels(c, c + channelsnp.shape(0));
     runEtaScan(channels, amplitude, frequencies);
     return;
 }
 
+void sce::SysgenCryo::sweepChannels(const std::vector<int> &channels, const std::vector<double> &centerFrequencies,
+                                    const std::vector<double> &frequencies, int first, int last, std::vector<double> &results) {
+    int    num_channels      = channels.size();
+    int    freqs_per_channel = frequencies.size();
+    int    range             = last - first + 1;
+    std::vector<uint32_t> raw(freqs_per_channel*range);
+
+    // For each step, queue one write of the config1 words of all the channels, and
+    // one read of their status1 words. The transactions are processed in order. With
+    // a dwell time, the read is done after the write completed and the DSP settled.
+    for (int j = 0; j < freqs_per_channel; ++j)
+    {
+        for (int i = 0; i < num_channels; ++i)
+        {
+            setCenterFrequencyMHz(channels[i], centerFrequencies[i] + frequencies[j], false);
+        }
+        reqWrite(config1_address_ + 4*first, 4*range, &(config1_shadow[first].reg));
+        if (scan_dwell_)
+        {
+            waitAll();
+            usleep(scan_dwell_);
+        }
+        reqRead(status1_address_ + 4*first, 4*range, &raw[j*range]);
+    }
+    waitAll();
+
+    status1 value;
+    for (int i = 0; i < num_channels; ++i)
+    {
+        for (int j = 0; j < freqs_per_channel; ++j)
+        {
+            value.reg = raw[j*range + channels[i] - first];
+            results[i*freqs_per_channel + j] = value.frequencyError;
+        }
+    }
+
+    for (int k = 0; k < range && freqs_per_channel > 0; ++k)
+    {
+        status1_shadow[first + k].reg = raw[(freqs_per_channel - 1)*range + k];
+    }
+    return;
+}
+
+void sce::SysgenCryo::runEtaScanParallel(std::vector<int> channels, int amplitude, std::vector<double> frequencies) {
+    int num_channels      = channels.size();
+    int freqs_per_channel = frequencies.size();
+    int total_points      = num_channels*freqs_per_channel;
+    std::vector<double> resultsReal(total_points);
+    std::vector<double> resultsImag(total_points);
+    std::vector<double> centerFrequencies(num_channels);
+
+    if (num_channels == 0 || freqs_per_channel == 0)
+    {
+        results_real_     = resultsReal;
+        results_imag_     = resultsImag;
+        scan_channels_    = channels;
+        scan_frequencies_ = frequencies;
+        return;
+    }
+
+    // The bulk transactions cover the range of words from the lowest to the highest
+    // scanned channel. Read the configuration first, so the channels in that range
+    // which are not scanned are written back with their current values.
+    int first = *std::min_element(channels.begin(), channels.end());
+    int last  = *std::max_element(channels.begin(), channels.end());
+    int range = last - first + 1;
+
+    if (first < 0 || last >= NUM_CHANNELS_C)
+    {
+        printf("Invalid channel number\n");
+        return;
+    }
+
+    // Write the pending configuration changes in the range first, as the range is
+    // read back. The changes of the other channels stay pending.
+    std::bitset<NUM_CHANNELS_C> inRange;
+    for (int channel = first; channel <= last; ++channel)
+    {
+        inRange.set(channel);
+    }
+    flushChannels(inRange);
+
+    reqRead(config0_address_ + 4*first, 4*range, &(config0_shadow[first].reg));
+    reqRead(config1_address_ + 4*first, 4*range, &(config1_shadow[first].reg));
+    waitAll();
+
+    for (int i = 0; i < num_channels; ++i)
+    {
+        int channel = channels[i];
+        centerFrequencies[i] = getCenterFrequencyMHz(channel, false);
+
+        setAmplitudeScale(channel, amplitude, false);
+        setFeedbackEnable(channel, 0, false);
+        setEtaMagScaled(channel, 1.0, false);
+        setEtaPhaseDegree(channel, 0.0, false);
+        setCenterFrequencyMHz(channel, frequencies[0], false);
+    }
+    reqWrite(config0_address_ + 4*first, 4*range, &(config0_shadow[first].reg));
+    reqWrite(config1_address_ + 4*first, 4*range, &(config1_shadow[first].reg));
+    waitAll();
+    usleep(100);
+    sweepChannels(channels, centerFrequencies, frequencies, first, last, resultsReal);
+
+    for (int i = 0; i < num_channels; ++i)
+    {
+        setEtaPhaseDegree(channels[i], -90.0, false);
+        setCenterFrequencyMHz(channels[i], frequencies[0], false);
+    }
+    reqWrite(config0_address_ + 4*first, 4*range, &(config0_shadow[first].reg));
+    reqWrite(config1_address_ + 4*first, 4*range, &(config1_shadow[first].reg));
+    waitAll();
+    usleep(100);
+    sweepChannels(channels, centerFrequencies, frequencies, first, last, resultsImag);
+
+    for (int i = 0; i < num_channels; ++i)
+    {
+        setCenterFrequencyMHz(channels[i], centerFrequencies[i], false);
+        setAmplitudeScale(channels[i], 0, false);
+    }
+    reqWrite(config1_address_ + 4*first, 4*range, &(config1_shadow[first].reg));
+    waitAll();
+
+    // The channel range was written directly
+    for (int channel = first; channel <= last; ++channel)
+    {
+        config0_dirty_.reset(channel);
+        config1_dirty_.reset(channel);
+    }
+
+    results_real_     = resultsReal;
+    results_imag_     = resultsImag;
+    scan_channels_    = channels;
+    scan_frequencies_ = frequencies;
+    return;
+}
+
+void sce::SysgenCryo::runEtaScanParallelPy(const bp::object &channelspy, int amplitude, const bp::object &iterable) {
+    np::ndarray frequenciesnp = py_to_ndarray<double>( iterable );
+    np::ndarray channelsnp    = py_to_ndarray<int>( channelspy );
+    const double *f = reinterpret_cast<const double*>( frequenciesnp.get_data() );
+    const int    *c = reinterpret_cast<const int*>( channelsnp.get_data() );
+    std::vector<double> frequencies(f, f + frequenciesnp.shape(0));
+    std::vector<int> channels(c, c + channelsnp.shape(0));
+    runEtaScanParallel(channels, amplitude, frequencies);
+    return;
+}
+
+// This is the eta estimator of the tuning scripts, with the two point difference
+// across the resonance replaced by a least-squares fit. The responses are converted
+// to MHz, like the frequency error, so the eta magnitude is already scaled like the
+// etaMag register. The loops over the scan points have no branches, so that they are
+// vectorized by the compiler.
+void sce::SysgenCryo::estimateEta(double deltaFrequency, bool apply, bool write) {
+    int num_channels      = scan_channels_.size();
+    int freqs_per_channel = scan_frequencies_.size();
+    int total_points      = num_channels*freqs_per_channel;
+
+    if (num_channels == 0 || freqs_per_channel < 2 || (int) results_real_.size() != total_points)
+    {
+        printf("No eta scan results\n");
+        return;
+    }
+
+    const double  scale = REG_TO_FREQ_ERROR_C;
+    const double *f     = &scan_frequencies_[0];
+    const double *re    = &results_real_[0];
+    const double *im    = &results_imag_[0];
+
+    std::vector<double> power(total_points);
+    std::vector<double> etaPhase(num_channels);
+    std::vector<double> etaMag(num_channels);
+    std::vector<double> etaCenter(num_channels);
+
+    for (int k = 0; k < total_points; ++k)
+    {
+        power[k] = re[k]*re[k] + im[k]*im[k];
+    }
+
+    for (int i = 0; i < num_channels; ++i)
+    {
+        const double *p  = &power[i*freqs_per_channel];
+        const double *r  = &re[i*freqs_per_channel];
+        const double *q  = &im[i*freqs_per_channel];
+        int           n  = freqs_per_channel;
+        int           c  = std::min_element(p, p + n) - p;
+        double        f0 = f[c];
+
+        // Refine the center with a parabola through the minimum and its neighbours
+        etaCenter[i] = f0;
+        if (c > 0 && c < n - 1)
+        {
+            double a   = (f0 - f[c-1]) * (p[c] - p[c+1]);
+            double b   = (f0 - f[c+1]) * (p[c] - p[c-1]);
+            double den = a - b;
+            if (den != 0)
+            {
+                double x = f0 - 0.5 * ( (f0 - f[c-1]) * a - (f0 - f[c+1]) * b ) / den;
+                etaCenter[i] = std::min(std::max(x, f[c-1]), f[c+1]);
+            }
+        }
+
+        // The fit goes from the last point below f0 - delta to the first point above
+        // f0 + delta, like the two points used by the tuning scripts
+        int left  = 0;
+        int right = n - 1;
+        for (int j = 0; j < n; ++j)
+        {
+            if (f[j] < f0 - deltaFrequency) left = j;
+        }
+        for (int j = n - 1; j >= 0; --j)
+        {
+            if (f[j] > f0 + deltaFrequency) right = j;
+        }
+
+        // Least-squares line of the response versus frequency, relative to f0
+        double sx = 0, sxx = 0, sr = 0, sq = 0, sxr = 0, sxq = 0;
+        for (int j = left; j <= right; ++j)
+        {
+            double x = f[j] - f0;
+            sx  += x;
+            sxx += x*x;
+            sr  += r[j];
+            sq  += q[j];
+            sxr += x*r[j];
+            sxq += x*q[j];
+        }
+
+        double m   = right - left + 1;
+        double den = m*sxx - sx*sx;
+        double sre = ( den != 0 ) ? ( m*sxr - sx*sr ) / den * scale : 0;
+        double sim = ( den != 0 ) ? ( m*sxq - sx*sq ) / den * scale : 0;
+        double mag = sre*sre + sim*sim;
+
+        // eta = 1 / slope. A flat response gives a zero eta.
+        if (mag > 0)
+        {
+            etaPhase[i] = atan2(-sim, sre) * 180.0 / M_PI;
+            etaMag[i]   = 1.0 / sqrt(mag);
+        }
+        else
+        {
+            etaPhase[i] = 0;
+            etaMag[i]   = 0;
+        }
+    }
+
+    eta_phase_estimate_  = etaPhase;
+    eta_mag_estimate_    = etaMag;
+    eta_center_estimate_ = etaCenter;
+
+    if (apply)
+    {
+        std::vector<uint32_t> words(num_channels);
+        int clamped = 0;
+        for (int i = 0; i < num_channels; ++i)
+        {
+            words[i] = config0_shadow[scan_channels_[i]].reg;
+            if (etaMag[i] > MAX_ETA_MAG_C)
+            {
+                ++clamped;
+            }
+        }
+
+        if (clamped)
+        {
+            printf("estimateEta: the eta magnitude of %d channels is above the register range, it was set to %f\n", clamped, MAX_ETA_MAG_C);
+        }
+
+        packEtaPhase(&etaPhase[0], &words[0], num_channels);
+        packEtaMag(&etaMag[0], &words[0], num_channels);
+
+        std::bitset<NUM_CHANNELS_C> estimated;
+        for (int i = 0; i < num_channels; ++i)
+        {
+            config0_shadow[scan_channels_[i]].reg = words[i];
+            config0_dirty_.set(scan_channels_[i]);
+            estimated.set(scan_channels_[i]);
+        }
+
+        // Only the estimated channels are written. They are contiguous in most cases,
+        // and then their config0 words go in a single write.
+        if (write)
+        {
+            flushBank(config0_address_, &(config0_shadow[0].reg), config0_dirty_, config0_valid_, estimated);
+            waitAll();
+        }
+    }
+    return;
+}
+
+std::vector<double> sce::SysgenCryo::getEtaPhaseEstimate() {
+    return eta_phase_estimate_;
+}
+
+np::ndarray sce::SysgenCryo::getEtaPhaseEstimatePy() {
+    std::vector<double> array = getEtaPhaseEstimate();
+    np::ndarray ndarray = new_ndarray<double>( array.size() );
+    std::copy( array.begin(), array.end(), reinterpret_cast<double*>( ndarray.get_data() ) );
+    return ndarray;
+}
+
+std::vector<double> sce::SysgenCryo::getEtaMagEstimate() {
+    return eta_mag_estimate_;
+}
+
+np::ndarray sce::SysgenCryo::getEtaMagEstimatePy() {
+    std::vector<double> array = getEtaMagEstimate();
+    np::ndarray ndarray = new_ndarray<double>( array.size() );
+    std::copy( array.begin(), array.end(), reinterpret_cast<double*>( ndarray.get_data() ) );
+    return ndarray;
+}
+
+std::vector<double> sce::SysgenCryo::getEtaCenterEstimate() {
+    return eta_center_estimate_;
+}
+
+np::ndarray sce::SysgenCryo::getEtaCenterEstimatePy() {
+    std::vector<double> array = getEtaCenterEstimate();
+    np::ndarray ndarray = new_ndarray<double>( array.size() );
+    std::copy( array.begin(), array.end(), reinterpret_cast<double*>( ndarray.get_data() ) );
+    return ndarray;
+}
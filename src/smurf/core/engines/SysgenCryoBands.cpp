@@ -0,0 +1,268 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF SysgenCryo Bands
+ * ----------------------------------------------------------------------------
+ * File          : SysgenCryoBands.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF SysgenCryo Bands Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <string>
+#include <stdexcept>
+#include <boost/python.hpp>
+#include "smurf/core/engines/SysgenCryoBands.h"
+
+namespace sce = smurf::core::engines;
+namespace np  = boost::python::numpy;
+
+sce::SysgenCryoBands::SysgenCryoBands(std::size_t numBands, uint32_t baseOffset, uint32_t bandStride)
+:
+    workers(numBands),
+    pending(0),
+    runWorkers(true),
+    eLog_(rogue::Logging::create("pysmurf.SysgenCryoBands"))
+{
+    for (std::size_t i{0}; i < numBands; ++i)
+    {
+        SysgenCryoPtr band { SysgenCryo::create() };
+        band->setBand(i);
+        band->setOffset(baseOffset + i * bandStride);
+        bands.push_back(band);
+    }
+
+    // Start the workers once all the variables have been initialized
+    for (std::size_t i{0}; i < numBands; ++i)
+    {
+        workers[i].thread = std::thread( &SysgenCryoBands::runWorker, this, i );
+
+        std::string name { "SysgenCryo" + std::to_string(i) };
+        if( pthread_setname_np( workers[i].thread.native_handle(), name.c_str() ) )
+            perror( "pthread_setname_np failed for a SysgenCryo worker thread" );
+    }
+}
+
+sce::SysgenCryoBands::~SysgenCryoBands()
+{
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        runWorkers = false;
+    }
+    jobCV.notify_all();
+
+    rogue::GilRelease noGil;
+    for (auto &w : workers)
+        w.thread.join();
+}
+
+sce::SysgenCryoBandsPtr sce::SysgenCryoBands::create(std::size_t numBands, uint32_t baseOffset, uint32_t bandStride)
+{
+    return std::make_shared<SysgenCryoBands>(numBands, baseOffset, bandStride);
+}
+
+// Setup Class in python
+void sce::SysgenCryoBands::setup_python()
+{
+    bp::class_< sce::SysgenCryoBands,
+                sce::SysgenCryoBandsPtr,
+                boost::noncopyable >
+                ("SysgenCryoBands", bp::init<std::size_t, uint32_t, uint32_t>())
+        .def("getNumBands",          &SysgenCryoBands::getNumBands)
+        .def("run",                  &SysgenCryoBands::runPy)
+        .def("setSlave",             &SysgenCryoBands::setSlave)
+        .def("wait",                 &SysgenCryoBands::wait)
+        .def("getPending",           &SysgenCryoBands::getPending)
+        .def("readAll",              &SysgenCryoBands::readAll)
+        .def("flush",                &SysgenCryoBands::flush)
+        .def("startEtaScan",         &SysgenCryoBands::startEtaScanPy)
+        .def("startEtaScanParallel", &SysgenCryoBands::startEtaScanParallelPy)
+    ;
+}
+
+const std::size_t sce::SysgenCryoBands::getNumBands() const
+{
+    return bands.size();
+}
+
+void sce::SysgenCryoBands::run(std::size_t band, std::function<void(SysgenCryo&)> fn)
+{
+    if ( band >= bands.size() )
+        throw std::runtime_error("Invalid band number " + std::to_string(band));
+
+    std::unique_lock<std::mutex> lock(workers[band].mutex, std::defer_lock);
+    {
+        rogue::GilRelease noGil;
+        lock.lock();
+    }
+
+    fn(*bands[band]);
+}
+
+bp::object sce::SysgenCryoBands::runPy(std::size_t band, bp::object fn)
+{
+    if ( band >= bands.size() )
+        throw std::runtime_error("Invalid band number " + std::to_string(band));
+
+    // Don't hold the GIL while waiting for the running operation, as it might need it
+    std::unique_lock<std::mutex> lock(workers[band].mutex, std::defer_lock);
+    {
+        rogue::GilRelease noGil;
+        lock.lock();
+    }
+
+    return fn(bands[band]);
+}
+
+void sce::SysgenCryoBands::setSlave(rim::SlavePtr slave)
+{
+    for (auto const &b : bands)
+        b->setSlave(slave);
+}
+
+void sce::SysgenCryoBands::submit(std::size_t band, std::function<void(SysgenCryo&)> job)
+{
+    if ( band >= bands.size() )
+    {
+        eLog_->error("Invalid band number %zu", band);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+
+        if ( ! runWorkers )
+        {
+            eLog_->error("Operation on band %zu not queued: the workers are stopped", band);
+            return;
+        }
+
+        workers[band].jobs.push_back(job);
+        ++pending;
+    }
+
+    jobCV.notify_all();
+}
+
+void sce::SysgenCryoBands::wait()
+{
+    rogue::GilRelease noGil;
+
+    std::unique_lock<std::mutex> lock(jobMutex);
+    doneCV.wait( lock, [this]{ return 0 == pending; } );
+}
+
+const std::size_t sce::SysgenCryoBands::getPending() const
+{
+    std::lock_guard<std::mutex> lock(jobMutex);
+    return pending;
+}
+
+void sce::SysgenCryoBands::readAll()
+{
+    for (std::size_t i{0}; i < bands.size(); ++i)
+        submit(i, [](SysgenCryo& b) { b.snapshot(); });
+
+    wait();
+}
+
+void sce::SysgenCryoBands::flush()
+{
+    for (std::size_t i{0}; i < bands.size(); ++i)
+        submit(i, [](SysgenCryo& b) { b.flush(); });
+
+    wait();
+}
+
+void sce::SysgenCryoBands::startEtaScan(std::size_t band, std::vector<int> channels, int amplitude, std::vector<double> frequencies)
+{
+    submit(band, [channels, amplitude, frequencies](SysgenCryo& b) { b.runEtaScan(channels, amplitude, frequencies); });
+}
+
+void sce::SysgenCryoBands::startEtaScanPy(std::size_t band, const bp::object& channels, int amplitude, const bp::object& frequencies)
+{
+    np::ndarray c { py_to_ndarray<int>(channels) };
+    np::ndarray f { py_to_ndarray<double>(frequencies) };
+    const int*    cData { reinterpret_cast<const int*>(c.get_data()) };
+    const double* fData { reinterpret_cast<const double*>(f.get_data()) };
+
+    startEtaScan(band, std::vector<int>(cData, cData + c.shape(0)), amplitude, std::vector<double>(fData, fData + f.shape(0)));
+}
+
+void sce::SysgenCryoBands::startEtaScanParallel(std::size_t band, std::vector<int> channels, int amplitude, std::vector<double> frequencies)
+{
+    submit(band, [channels, amplitude, frequencies](SysgenCryo& b) { b.runEtaScanParallel(channels, amplitude, frequencies); });
+}
+
+void sce::SysgenCryoBands::startEtaScanParallelPy(std::size_t band, const bp::object& channels, int amplitude, const bp::object& frequencies)
+{
+    np::ndarray c { py_to_ndarray<int>(channels) };
+    np::ndarray f { py_to_ndarray<double>(frequencies) };
+    const int*    cData { reinterpret_cast<const int*>(c.get_data()) };
+    const double* fData { reinterpret_cast<const double*>(f.get_data()) };
+
+    startEtaScanParallel(band, std::vector<int>(cData, cData + c.shape(0)), amplitude, std::vector<double>(fData, fData + f.shape(0)));
+}
+
+void sce::SysgenCryoBands::runWorker(std::size_t band)
+{
+    eLog_->logThreadId();
+
+    Worker&     w { workers[band] };
+    SysgenCryo& b { *bands[band] };
+
+    for(;;)
+    {
+        std::function<void(SysgenCryo&)> job;
+
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobCV.wait( lock, [this, &w]{ return ( ! runWorkers ) || ( ! w.jobs.empty() ); } );
+
+            // On stop, cancel the operations still queued on this band, and
+            // remove them from 'pending' so that wait() does not block forever
+            if ( ! runWorkers )
+            {
+                if ( ! w.jobs.empty() )
+                    eLog_->warning("Cancelling %zu queued operations on band %zu", w.jobs.size(), band);
+
+                pending -= w.jobs.size();
+                w.jobs.clear();
+                doneCV.notify_all();
+                return;
+            }
+
+            job = w.jobs.front();
+        }
+
+        // The operation stays in the queue while it runs, so that
+        // 'pending' only reaches zero when all the operations are done.
+        // The band engine is only accessed while holding its mutex.
+        try
+        {
+            std::lock_guard<std::mutex> bandLock(w.mutex);
+            job(b);
+        }
+        catch (std::exception &e)
+        {
+            eLog_->error("Operation on band %zu failed: %s", band, e.what());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            w.jobs.pop_front();
+            --pending;
+        }
+
+        doneCV.notify_all();
+    }
+}
@@ -0,0 +1,356 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF SysgenCryo Poller
+ * ----------------------------------------------------------------------------
+ * File          : SysgenCryoPoller.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF SysgenCryo Poller Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <chrono>
+#include <algorithm>
+#include <boost/python.hpp>
+#include "smurf/core/engines/SysgenCryoPoller.h"
+
+namespace sce = smurf::core::engines;
+namespace np  = boost::python::numpy;
+
+const std::size_t sce::SysgenCryoPoller::numChannels;
+const uint32_t    sce::SysgenCryoPoller::statusOffset;
+const uint32_t    sce::SysgenCryoPoller::statusSize;
+
+sce::SysgenCryoPoller::SysgenCryoPoller()
+:
+    rim::Master(),
+    offset(0),
+    enable(false),
+    rate(10),
+    raw(statusSize / 4),
+    depth(1024),
+    head(0),
+    count(0),
+    times(depth, 0),
+    lfo(depth * numChannels, 0),
+    ferr(depth * numChannels, 0),
+    pollCnt(0),
+    errorCnt(0),
+    runTx(true),
+    eLog_(rogue::Logging::create("pysmurf.SysgenCryoPoller"))
+{
+    // Start the thread once all the variables have been initialized
+    txThread = std::thread( &SysgenCryoPoller::runThread, this );
+
+    if( pthread_setname_np( txThread.native_handle(), "SysgenCryoPoll" ) )
+        perror( "pthread_setname_np failed for SysgenCryoPoller thread" );
+}
+
+sce::SysgenCryoPoller::~SysgenCryoPoller()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        runTx = false;
+    }
+    cv.notify_all();
+
+    rogue::GilRelease noGil;
+    txThread.join();
+}
+
+sce::SysgenCryoPollerPtr sce::SysgenCryoPoller::create()
+{
+    return std::make_shared<SysgenCryoPoller>();
+}
+
+// Setup Class in python
+void sce::SysgenCryoPoller::setup_python()
+{
+    bp::class_< sce::SysgenCryoPoller,
+                sce::SysgenCryoPollerPtr,
+                bp::bases<rim::Master>,
+                boost::noncopyable >
+                ("SysgenCryoPoller", bp::init<>())
+        .def("setOffset",     &SysgenCryoPoller::setOffset)
+        .def("getOffset",     &SysgenCryoPoller::getOffset)
+        .def("setEnable",     &SysgenCryoPoller::setEnable)
+        .def("getEnable",     &SysgenCryoPoller::getEnable)
+        .def("setRate",       &SysgenCryoPoller::setRate)
+        .def("getRate",       &SysgenCryoPoller::getRate)
+        .def("setDepth",      &SysgenCryoPoller::setDepth)
+        .def("getDepth",      &SysgenCryoPoller::getDepth)
+        .def("getCount",      &SysgenCryoPoller::getCount)
+        .def("getPollCnt",    &SysgenCryoPoller::getPollCnt)
+        .def("getErrorCnt",   &SysgenCryoPoller::getErrorCnt)
+        .def("getLatestTime", &SysgenCryoPoller::getLatestTime)
+        .def("getLatest",     &SysgenCryoPoller::getLatestPy)
+        .def("getRange",      &SysgenCryoPoller::getRangePy)
+        .def("clear",         &SysgenCryoPoller::clear)
+    ;
+    bp::implicitly_convertible< sce::SysgenCryoPollerPtr, rim::MasterPtr >();
+}
+
+void sce::SysgenCryoPoller::setOffset(uint32_t o)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    offset = o;
+}
+
+const uint32_t sce::SysgenCryoPoller::getOffset() const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    return offset;
+}
+
+void sce::SysgenCryoPoller::setEnable(bool e)
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        enable = e;
+    }
+
+    // Wake up the thread, so that the change is applied immediately
+    cv.notify_all();
+}
+
+const bool sce::SysgenCryoPoller::getEnable() const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    return enable;
+}
+
+void sce::SysgenCryoPoller::setRate(double r)
+{
+    if ( r <= 0 )
+    {
+        eLog_->error("Trying to set a rate <= 0: %f", r);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        rate = r;
+    }
+
+    cv.notify_all();
+}
+
+const double sce::SysgenCryoPoller::getRate() const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    return rate;
+}
+
+void sce::SysgenCryoPoller::setDepth(std::size_t d)
+{
+    if ( 0 == d )
+    {
+        eLog_->error("Trying to set depth = 0");
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    depth = d;
+    head  = 0;
+    count = 0;
+    times.assign(depth, 0);
+    lfo.assign(depth * numChannels, 0);
+    ferr.assign(depth * numChannels, 0);
+}
+
+const std::size_t sce::SysgenCryoPoller::getDepth() const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    return depth;
+}
+
+const std::size_t sce::SysgenCryoPoller::getCount() const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    return count;
+}
+
+const std::size_t sce::SysgenCryoPoller::getPollCnt() const
+{
+    return pollCnt;
+}
+
+const std::size_t sce::SysgenCryoPoller::getErrorCnt() const
+{
+    return errorCnt;
+}
+
+const double sce::SysgenCryoPoller::getLatestTime() const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+
+    if ( 0 == count )
+        return 0;
+
+    return times[( head + depth - 1 ) % depth];
+}
+
+bp::tuple sce::SysgenCryoPoller::getLatestPy() const
+{
+    np::ndarray l { new_ndarray<double>(numChannels) };
+    np::ndarray f { new_ndarray<double>(numChannels) };
+    double      t { 0 };
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+
+        if ( 0 == count )
+        {
+            std::fill_n(reinterpret_cast<double*>(l.get_data()), numChannels, 0.0);
+            std::fill_n(reinterpret_cast<double*>(f.get_data()), numChannels, 0.0);
+        }
+        else
+        {
+            std::size_t i { ( head + depth - 1 ) % depth };
+            t = times[i];
+            std::copy_n(&lfo[i * numChannels],  numChannels, reinterpret_cast<double*>(l.get_data()));
+            std::copy_n(&ferr[i * numChannels], numChannels, reinterpret_cast<double*>(f.get_data()));
+        }
+    }
+
+    return bp::make_tuple(t, l, f);
+}
+
+bp::tuple sce::SysgenCryoPoller::getRangePy(double t0, double t1) const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+
+    // Find the polls in the range, from the oldest one. The
+    // timestamps grow with the index, so they are contiguous.
+    std::size_t oldest { ( head + depth - count ) % depth };
+    std::size_t first  { count };
+    std::size_t n      { 0 };
+
+    for (std::size_t k{0}; k < count; ++k)
+    {
+        double t { times[( oldest + k ) % depth] };
+
+        if ( ( t >= t0 ) && ( t <= t1 ) )
+        {
+            if ( first == count )
+                first = k;
+            ++n;
+        }
+    }
+
+    np::ndarray t { new_ndarray<double>(n) };
+    np::ndarray l { np::empty(bp::make_tuple(n, numChannels), np::dtype::get_builtin<double>()) };
+    np::ndarray f { np::empty(bp::make_tuple(n, numChannels), np::dtype::get_builtin<double>()) };
+
+    double* tData { reinterpret_cast<double*>(t.get_data()) };
+    double* lData { reinterpret_cast<double*>(l.get_data()) };
+    double* fData { reinterpret_cast<double*>(f.get_data()) };
+
+    for (std::size_t k{0}; k < n; ++k)
+    {
+        std::size_t i { ( oldest + first + k ) % depth };
+        tData[k] = times[i];
+        std::copy_n(&lfo[i * numChannels],  numChannels, lData + k * numChannels);
+        std::copy_n(&ferr[i * numChannels], numChannels, fData + k * numChannels);
+    }
+
+    return bp::make_tuple(t, l, f);
+}
+
+void sce::SysgenCryoPoller::clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        head  = 0;
+        count = 0;
+    }
+
+    pollCnt  = 0;
+    errorCnt = 0;
+}
+
+void sce::SysgenCryoPoller::poll()
+{
+    uint32_t address;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        address = offset + statusOffset;
+    }
+
+    // Split the read in chunks of the maximum access size, if the slave can't do it at once
+    uint32_t chunk { reqMaxAccess() & ~3u };
+    if ( ( 0 == chunk ) || ( chunk > statusSize ) )
+        chunk = statusSize;
+
+    auto start = std::chrono::system_clock::now();
+    for (uint32_t pos{0}; pos < statusSize; pos += chunk)
+        reqTransaction(address + pos, std::min(chunk, statusSize - pos), &raw[pos / 4], rim::Read);
+    waitTransaction(0);
+    auto stop = std::chrono::system_clock::now();
+
+    ++pollCnt;
+
+    std::string err { getError() };
+    if ( ! err.empty() )
+    {
+        clearError();
+        ++errorCnt;
+        eLog_->warning("Status poll failed: %s", err.c_str());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    times[head] = std::chrono::duration<double>( ( start + ( stop - start ) / 2 ).time_since_epoch() ).count();
+    SysgenCryo::unpackLoopFilterOutput(&raw[0],           &lfo[head * numChannels],  numChannels);
+    SysgenCryo::unpackFrequencyError(&raw[numChannels],   &ferr[head * numChannels], numChannels);
+
+    head = ( head + 1 ) % depth;
+    if ( count < depth )
+        ++count;
+}
+
+void sce::SysgenCryoPoller::runThread()
+{
+    eLog_->logThreadId();
+
+    std::unique_lock<std::mutex> lock(mtx);
+    auto next = std::chrono::steady_clock::now();
+
+    while(runTx)
+    {
+        auto now = std::chrono::steady_clock::now();
+
+        if ( ! enable )
+        {
+            cv.wait( lock );
+            next = std::chrono::steady_clock::now();
+            continue;
+        }
+
+        if ( now < next )
+        {
+            cv.wait_until( lock, next );
+            continue;
+        }
+
+        // Schedule the next poll. If the polls fall behind, the missed ones are skipped.
+        auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::duration<double>( 1.0 / rate ) );
+        next += period;
+        if ( next < now )
+            next = now + period;
+
+        lock.unlock();
+        poll();
+        lock.lock();
+    }
+}
@@ -19,10 +19,14 @@
 **/
 
 #include <boost/python.hpp>
+#include <boost/python/numpy.hpp>
 #include <smurf/core/engines/module.h>
 #include <smurf/core/engines/SysgenCryo.h>
+#include <smurf/core/engines/SysgenCryoBands.h>
+#include <smurf/core/engines/SysgenCryoPoller.h>
 
 namespace bp  = boost::python;
+namespace np  = boost::python::numpy;
 namespace sce = smurf::core::engines;
 
 void sce::setup_module()
@@ -36,5 +40,10 @@ void sce::setup_module()
     // set the current scope to the new sub-module
     bp::scope io_scope = module;
 
+    // The array methods use NumPy arrays
+    np::initialize();
+
     sce::SysgenCryo::setup_python();
+    sce::SysgenCryoBands::setup_python();
+    sce::SysgenCryoPoller::setup_python();
 }
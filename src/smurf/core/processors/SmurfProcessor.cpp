@@ -47,16 +47,31 @@ scp::SmurfProcessor::SmurfProcessor()
     disableDownsampler(false),
     factor(20),
     sampleCnt(0),
+    frameCnt(0),
+    badFrameCnt(0),
+    txFrameCnt(0),
+    traceId(TraceRecorder::getInstance().registerBlock("SmurfProcessor")),
+    txTraceId(TraceRecorder::getInstance().registerBlock("SmurfProcessorTx")),
+    perf(NumPerfStages),
+    txPerf(1),
     headerCopy(SmurfHeader<std::vector<uint8_t>::iterator>::SmurfHeaderSize, 0),
     runTxThread(true),
     txDataReady(false),
     pktTransmitterThread(std::thread( &SmurfProcessor::pktTansmitter, this )),
-    eLog_(rogue::Logging::create("pysmurf.SmurfProcessor"))
+    eLog_(rogue::Logging::create("pysmurf.SmurfProcessor")),
+    logBadFlags(eLog_, "frame with errors and/or flags"),
+    logBadSize(eLog_, "frame with wrong size"),
+    logBadNumCh(eLog_, "frame with less channels than supported")
 {
     if( pthread_setname_np( pktTransmitterThread.native_handle(), "pktTransmitter" ) )
         perror( "pthread_setname_np failed for pktTransmitterThread thread" );
 }
 
+scp::SmurfProcessor::~SmurfProcessor()
+{
+    MetricsRegistry::getInstance().remove(this);
+}
+
 scp::SmurfProcessorPtr scp::SmurfProcessor::create()
 {
     return std::make_shared<SmurfProcessor>();
@@ -96,6 +111,25 @@ void scp::SmurfProcessor::setup_python()
         .def("getDownsamplerDisable",   &SmurfProcessor::getDownsamplerDisable)
         .def("setFactor",               &SmurfProcessor::setFactor)
         .def("getFactor",               &SmurfProcessor::getFactor)
+        // Counters
+        .def("getFrameCnt",             &SmurfProcessor::getFrameCnt)
+        .def("getBadFrameCnt",          &SmurfProcessor::getBadFrameCnt)
+        .def("getTxFrameCnt",           &SmurfProcessor::getTxFrameCnt)
+        .def("getSuppressedLogCnt",     &SmurfProcessor::getSuppressedLogCnt)
+        .def("clearCnt",                &SmurfProcessor::clearCnt)
+        // Performance counter variables
+        .def("setPerfEnable",           &SmurfProcessor::setPerfEnable)
+        .def("getPerfEnable",           &SmurfProcessor::getPerfEnable)
+        .def("getPerfStatus",           &SmurfProcessor::getPerfStatus)
+        .def("getPerfStageNames",       &SmurfProcessor::getPerfStageNames)
+        .def("getPerfEventNames",       &SmurfProcessor::getPerfEventNames)
+        .def("getPerfEventAvailable",   &SmurfProcessor::getPerfEventAvailable)
+        .def("getPerfCalls",            &SmurfProcessor::getPerfCalls)
+        .def("getPerfCount",            &SmurfProcessor::getPerfCount)
+        .def("getPerfStats",            &SmurfProcessor::getPerfStats)
+        .def("clearPerf",               &SmurfProcessor::clearPerf)
+        .def("registerMetrics",         &SmurfProcessor::registerMetrics)
+        .def("setTraceName",            &SmurfProcessor::setTraceName)
     ;
     bp::implicitly_convertible< scp::SmurfProcessorPtr, ris::SlavePtr  >();
     bp::implicitly_convertible< scp::SmurfProcessorPtr, ris::MasterPtr >();
@@ -446,20 +480,182 @@ void scp::SmurfProcessor::resetDownsampler()
     sampleCnt = 0;
 }
 
+const std::size_t scp::SmurfProcessor::getFrameCnt() const
+{
+    return frameCnt;
+}
+
+const std::size_t scp::SmurfProcessor::getBadFrameCnt() const
+{
+    return badFrameCnt;
+}
+
+const std::size_t scp::SmurfProcessor::getTxFrameCnt() const
+{
+    return txFrameCnt;
+}
+
+const std::size_t scp::SmurfProcessor::getSuppressedLogCnt() const
+{
+    return logBadFlags.getSuppressedCnt() + logBadSize.getSuppressedCnt() + logBadNumCh.getSuppressedCnt();
+}
+
+void scp::SmurfProcessor::clearCnt()
+{
+    frameCnt    = 0;
+    badFrameCnt = 0;
+    txFrameCnt  = 0;
+
+    logBadFlags.clearCnt();
+    logBadSize.clearCnt();
+    logBadNumCh.clearCnt();
+}
+
+void scp::SmurfProcessor::setPerfEnable(bool e)
+{
+    perf.setEnable(e);
+    txPerf.setEnable(e);
+}
+
+const bool scp::SmurfProcessor::getPerfEnable() const
+{
+    return perf.getEnable();
+}
+
+const int scp::SmurfProcessor::getPerfStatus() const
+{
+    // Report the counters as unavailable if they are not available on either thread
+    int s  { perf.getStatus() };
+    int tx { txPerf.getStatus() };
+
+    if ( ( PerfCounters::Unavailable == s ) || ( PerfCounters::Unavailable == tx ) )
+        return PerfCounters::Unavailable;
+
+    if ( ( PerfCounters::Running == s ) || ( PerfCounters::Running == tx ) )
+        return PerfCounters::Running;
+
+    return PerfCounters::Disabled;
+}
+
+const bp::list scp::SmurfProcessor::getPerfStageNames() const
+{
+    bp::list temp;
+
+    temp.append("Unwrap");
+    temp.append("Filter");
+    temp.append("Downsample");
+    temp.append("Tx");
+
+    return temp;
+}
+
+const bp::list scp::SmurfProcessor::getPerfEventNames() const
+{
+    bp::list temp;
+
+    for (std::size_t e{0}; e < PerfCounters::NumEvents; ++e)
+        temp.append(PerfCounters::eventNames[e]);
+
+    return temp;
+}
+
+const bp::list scp::SmurfProcessor::getPerfEventAvailable() const
+{
+    bp::list temp;
+
+    for (std::size_t e{0}; e < PerfCounters::NumEvents; ++e)
+        temp.append( perf.getEventAvailable(e) || txPerf.getEventAvailable(e) );
+
+    return temp;
+}
+
+const uint64_t scp::SmurfProcessor::getPerfCalls(std::size_t s) const
+{
+    // The last stage (Tx) is measured by the Tx thread counters
+    if ( s < NumPerfStages )
+        return perf.getCalls(s);
+
+    return txPerf.getCalls(s - NumPerfStages);
+}
+
+const uint64_t scp::SmurfProcessor::getPerfCount(std::size_t s, std::size_t e) const
+{
+    if ( s < NumPerfStages )
+        return perf.getCount(s, e);
+
+    return txPerf.getCount(s - NumPerfStages, e);
+}
+
+const bp::dict scp::SmurfProcessor::getPerfStats() const
+{
+    bp::dict   temp;
+    bp::list   stageNames { getPerfStageNames() };
+
+    for (std::size_t s{0}; s < NumPerfStages + txPerf.getNumStages(); ++s)
+    {
+        bp::dict stage;
+        stage["Calls"] = getPerfCalls(s);
+
+        for (std::size_t e{0}; e < PerfCounters::NumEvents; ++e)
+            stage[PerfCounters::eventNames[e]] = getPerfCount(s, e);
+
+        temp[stageNames[s]] = stage;
+    }
+
+    return temp;
+}
+
+void scp::SmurfProcessor::clearPerf()
+{
+    perf.clear();
+    txPerf.clear();
+}
+
+void scp::SmurfProcessor::setTraceName(const std::string& name)
+{
+    TraceRecorder::getInstance().setBlockName(traceId, name);
+    TraceRecorder::getInstance().setBlockName(txTraceId, name + ".Tx");
+}
+
+void scp::SmurfProcessor::registerMetrics(const std::string& name)
+{
+    MetricsRegistry& registry { MetricsRegistry::getInstance() };
+
+    registry.remove(this);
+
+    registry.addCounter(this, "smurf_processor_frames_total", "Number of received frames",
+        { { "block", name } }, [this]() -> double { return getFrameCnt(); });
+
+    registry.addCounter(this, "smurf_processor_bad_frames_total", "Number of dropped bad frames",
+        { { "block", name } }, [this]() -> double { return getBadFrameCnt(); });
+
+    registry.addCounter(this, "smurf_processor_tx_frames_total", "Number of sent frames",
+        { { "block", name } }, [this]() -> double { return getTxFrameCnt(); });
+
+    registry.addCounter(this, "smurf_processor_suppressed_logs_total", "Number of log messages suppressed by the rate limiters",
+        { { "block", name } }, [this]() -> double { return getSuppressedLogCnt(); });
+}
+
 void scp::SmurfProcessor::acceptFrame(ris::FramePtr frame)
 {
     // Release the GIL
     rogue::GilRelease noGil;
 
+    // Record the time spent on the frame
+    TraceScope trace(traceId);
+
     std::size_t frameSize;
 
     // Hold the frame lock
     ris::FrameLockPtr lockFrame{frame->lock()};
 
+    ++frameCnt;
+
     // Check for frames with errors or flags
     if ( frame->getError() || ( frame->getFlags() & 0x100 ) )
     {
-        eLog_->error("Received frame with errors and/or flags");
+        logBadFlags.error("Received frame with errors and/or flags");
+        ++badFrameCnt;
         return;
     }
 
@@ -469,8 +665,9 @@ void scp::SmurfProcessor::acceptFrame(ris::FramePtr frame)
     // Check if the frame size is lower than the header size
     if ( frameSize < SmurfHeader<std::vector<uint8_t>::iterator>::SmurfHeaderSize )
     {
-        eLog_->error("Received frame with size lower than the header size. Received frame size=%zu, expected header size=%zu",
+        logBadSize.error("Received frame with size lower than the header size. Received frame size=%zu, expected header size=%zu",
             frameSize, SmurfHeader<std::vector<uint8_t>::iterator>::SmurfHeaderSize);
+        ++badFrameCnt;
         return;
     }
 
@@ -482,14 +679,17 @@ void scp::SmurfProcessor::acceptFrame(ris::FramePtr frame)
     // - The frame has at least the header, so we can construct a (smart) pointer to it
     SmurfHeaderPtr<ris::FrameIterator> header { SmurfHeader<ris::FrameIterator>::create(frame) };
 
+    trace.setFrame(header->getFrameCounter());
+
     // - Read the number of channel from the header
     uint32_t numChannels { header->getNumberChannels() };
 
     // - The incoming frame should have at least the supported maximum number of channels
     if ( numChannels < maxNumCh )
     {
-         eLog_->error("Received frame with less channels that the maximum supported. Number of channels in received frame=%zu, supported maximum number of channels=%zu",
+         logBadNumCh.error("Received frame with less channels that the maximum supported. Number of channels in received frame=%zu, supported maximum number of channels=%zu",
             numChannels, maxNumCh);
+        ++badFrameCnt;
         return;
     }
 
@@ -497,9 +697,10 @@ void scp::SmurfProcessor::acceptFrame(ris::FramePtr frame)
     //   hold the number of channels defined in its header. Padded frames are allowed.
     if ( header->SmurfHeaderSize + (numChannels * sizeof(fw_t)) > frameSize )
     {
-        eLog_->error("Received frame does not match expected size. Received frame size=%zu. Minimum expected sizes: header=%zu, payload=%i",
+        logBadSize.error("Received frame does not match expected size. Received frame size=%zu. Minimum expected sizes: header=%zu, payload=%i",
             frameSize, header->SmurfHeaderSize, numChannels * sizeof(fw_t));
 
+        ++badFrameCnt;
         return;
     }
 
@@ -507,6 +708,9 @@ void scp::SmurfProcessor::acceptFrame(ris::FramePtr frame)
     // to avoid the 'numCh' parameter to be changed during that time.
     std::lock_guard<std::mutex> lockParam(mutChMapper);
 
+    // Start the performance counter measurement, if enabled
+    perf.begin();
+
     // Map and unwrap data at the same time
     {
         // Move the current data to the previous data
@@ -564,6 +768,8 @@ void scp::SmurfProcessor::acceptFrame(ris::FramePtr frame)
         header->setNumberChannels(numCh);
     }
 
+    perf.mark(PerfUnwrap);
+
     // Filter data
     { // filter parameter lock scope
         // Filter the data, if the filter is not disabled.
@@ -665,6 +871,8 @@ void scp::SmurfProcessor::acceptFrame(ris::FramePtr frame)
         }
     } // filter parameter lock scope
 
+    perf.mark(PerfFilter);
+
     // Downsample the data, if the downsampler is not disabled.
     // Otherwise, the data will be send on each cycle.
     if (!disableDownsampler)
@@ -672,7 +880,10 @@ void scp::SmurfProcessor::acceptFrame(ris::FramePtr frame)
         // Downsampler. If we haven't reached the factor counter, we don't do anything
         // When we reach the factor counter, we send the resulting frame.
         if (++sampleCnt < factor)
+        {
+            perf.mark(PerfDownsample);
             return;
+        }
 
         // Reset the downsampler
         resetDownsampler();
@@ -714,6 +925,8 @@ void scp::SmurfProcessor::acceptFrame(ris::FramePtr frame)
             }
         }
 
+        perf.mark(PerfDownsample);
+
         // Notify the Tx thread that new data is ready
         txDataReady = true;
         std::unique_lock<std::mutex> lock(txMutex);
@@ -737,6 +950,12 @@ void scp::SmurfProcessor::pktTansmitter()
         }
         else
         {
+            // Record the time spent building the output frame
+            TraceScope trace(txTraceId);
+
+            // Start the performance counter measurement, if enabled
+            txPerf.begin();
+
             // Output frame size. Start with the size of the header
             std::size_t outFrameSize = SmurfHeaderRO<std::vector<uint8_t>::iterator>::SmurfHeaderSize;
 
@@ -744,6 +963,8 @@ void scp::SmurfProcessor::pktTansmitter()
             SmurfHeaderROPtr<std::vector<uint8_t>::iterator> header { SmurfHeaderRO<std::vector<uint8_t>::iterator>::create(headerCopy) };
             std::size_t numChannels { header->getNumberChannels() };
 
+            trace.setFrame(header->getFrameCounter());
+
             if (payloadSize > numChannels)
                 // If the payload size is greater that the number of channels, then reserved
                 // that number of channels in the output frame.
@@ -768,8 +989,12 @@ void scp::SmurfProcessor::pktTansmitter()
                     helpers::setWord<filter_t>(outFrameIt, i++, *it);
             }
 
-            // Send the frame to the next slave.
+            // Send the frame to the next slave. The time spent
+            // by the next slaves is not included in the trace.
+            trace.end();
+            txPerf.mark(0);
             sendFrame(outFrame);
+            ++txFrameCnt;
 
             // Clear the flag
             txDataReady = false;
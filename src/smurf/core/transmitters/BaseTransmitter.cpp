@@ -39,6 +39,11 @@ sct::BaseTransmitter::BaseTransmitter()
 {
 }
 
+sct::BaseTransmitter::~BaseTransmitter()
+{
+    MetricsRegistry::getInstance().remove(this);
+}
+
 sct::BaseTransmitterPtr sct::BaseTransmitter::create()
 {
     return std::make_shared<BaseTransmitter>();
@@ -55,6 +60,7 @@ void sct::BaseTransmitter::setup_python()
         .def("clearCnt",       &BaseTransmitter::clearCnt)
         .def("getDataDropCnt", &BaseTransmitter::getDataDropCnt)
         .def("getMetaDropCnt", &BaseTransmitter::getMetaDropCnt)
+        .def("registerMetrics", &BaseTransmitter::registerMetrics)
         .def("getDataChannel", &BaseTransmitter::getDataChannel)
         .def("getMetaChannel", &BaseTransmitter::getMetaChannel)
     ;
@@ -106,6 +112,19 @@ const std::size_t sct::BaseTransmitter::getDataDropCnt() const
     return dataBuffer->getDropCnt();
 }
 
+void sct::BaseTransmitter::registerMetrics(const std::string& name)
+{
+    MetricsRegistry& registry { MetricsRegistry::getInstance() };
+
+    registry.remove(this);
+
+    registry.addCounter(this, "smurf_transmitter_data_dropped_total", "Number of data frames dropped",
+        { { "block", name } }, [this]() -> double { return getDataDropCnt(); });
+
+    registry.addCounter(this, "smurf_transmitter_meta_dropped_total", "Number of metadata frames dropped",
+        { { "block", name } }, [this]() -> double { return getMetaDropCnt(); });
+}
+
 void sct::BaseTransmitter::acceptDataFrame(ris::FramePtr frame)
 {
     rogue::GilRelease noGil;
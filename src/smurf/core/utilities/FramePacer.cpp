@@ -0,0 +1,382 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Frame Pacer
+ * ----------------------------------------------------------------------------
+ * File          : FramePacer.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Frame Pacer Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <boost/python.hpp>
+#include "smurf/core/utilities/FramePacer.h"
+
+namespace scu = smurf::core::utilities;
+
+scu::FramePacer::FramePacer()
+:
+    ris::Slave(),
+    ris::Master(),
+    disable(false),
+    rate(0),
+    burst(1),
+    tokens(1),
+    lastRefill(helpers::getTimeNS()),
+    head(0),
+    count(0),
+    depth(0),
+    queueCnt(0),
+    maxQueueCnt(0),
+    txCnt(0),
+    dropCnt(0),
+    delayCnt(0),
+    totalDelay(0),
+    maxDelay(0),
+    runTx(true),
+    eLog_(rogue::Logging::create("pysmurf.FramePacer"))
+{
+    resizeQueue(100);
+
+    // Start the thread once all the variables have been initialized
+    txThread = std::thread( &FramePacer::runThread, this );
+
+    if( pthread_setname_np( txThread.native_handle(), "FramePacer" ) )
+        perror( "pthread_setname_np failed for FramePacer thread" );
+}
+
+scu::FramePacer::~FramePacer()
+{
+    MetricsRegistry::getInstance().remove(this);
+
+    runTx = false;
+    queueCV.notify_all();
+
+    rogue::GilRelease noGil;
+    txThread.join();
+}
+
+scu::FramePacerPtr scu::FramePacer::create()
+{
+    return std::make_shared<FramePacer>();
+}
+
+// Setup Class in python
+void scu::FramePacer::setup_python()
+{
+    bp::class_< scu::FramePacer,
+                scu::FramePacerPtr,
+                bp::bases<ris::Slave,ris::Master>,
+                boost::noncopyable >
+                ("FramePacer", bp::init<>())
+        .def("setDisable",     &FramePacer::setDisable)
+        .def("getDisable",     &FramePacer::getDisable)
+        .def("setRate",        &FramePacer::setRate)
+        .def("getRate",        &FramePacer::getRate)
+        .def("setBurst",       &FramePacer::setBurst)
+        .def("getBurst",       &FramePacer::getBurst)
+        .def("setDepth",       &FramePacer::setDepth)
+        .def("getDepth",       &FramePacer::getDepth)
+        .def("getQueueCnt",    &FramePacer::getQueueCnt)
+        .def("getMaxQueueCnt", &FramePacer::getMaxQueueCnt)
+        .def("getTxCnt",       &FramePacer::getTxCnt)
+        .def("getDropCnt",     &FramePacer::getDropCnt)
+        .def("getDelayCnt",    &FramePacer::getDelayCnt)
+        .def("getAvgDelay",    &FramePacer::getAvgDelay)
+        .def("getMaxDelay",    &FramePacer::getMaxDelay)
+        .def("clearCnt",       &FramePacer::clearCnt)
+        .def("registerMetrics", &FramePacer::registerMetrics)
+    ;
+    bp::implicitly_convertible< scu::FramePacerPtr, ris::SlavePtr  >();
+    bp::implicitly_convertible< scu::FramePacerPtr, ris::MasterPtr >();
+}
+
+void scu::FramePacer::setDisable(bool d)
+{
+    disable = d;
+}
+
+const bool scu::FramePacer::getDisable() const
+{
+    return disable;
+}
+
+void scu::FramePacer::setRate(double r)
+{
+    if ( r < 0 )
+    {
+        eLog_->error("Trying to set a negative rate = %f", r);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    rate = r;
+
+    // Wake up the thread, so that the new rate is applied immediately
+    queueCV.notify_all();
+}
+
+const double scu::FramePacer::getRate() const
+{
+    return rate;
+}
+
+void scu::FramePacer::setBurst(std::size_t b)
+{
+    if ( 0 == b )
+    {
+        eLog_->error("Trying to set burst = 0");
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    burst = b;
+
+    if ( tokens > burst )
+        tokens = burst;
+}
+
+const std::size_t scu::FramePacer::getBurst() const
+{
+    return burst;
+}
+
+void scu::FramePacer::setDepth(std::size_t d)
+{
+    if ( 0 == d )
+    {
+        eLog_->error("Trying to set depth = 0");
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    resizeQueue(d);
+}
+
+const std::size_t scu::FramePacer::getDepth() const
+{
+    return depth;
+}
+
+const std::size_t scu::FramePacer::getQueueCnt() const
+{
+    return queueCnt;
+}
+
+const std::size_t scu::FramePacer::getMaxQueueCnt() const
+{
+    return maxQueueCnt;
+}
+
+const std::size_t scu::FramePacer::getTxCnt() const
+{
+    return txCnt;
+}
+
+const std::size_t scu::FramePacer::getDropCnt() const
+{
+    return dropCnt;
+}
+
+const std::size_t scu::FramePacer::getDelayCnt() const
+{
+    return delayCnt;
+}
+
+const double scu::FramePacer::getAvgDelay() const
+{
+    std::size_t n { txCnt };
+
+    if ( 0 == n )
+        return 0;
+
+    return static_cast<double>(totalDelay) / n;
+}
+
+const uint64_t scu::FramePacer::getMaxDelay() const
+{
+    return maxDelay;
+}
+
+void scu::FramePacer::clearCnt()
+{
+    maxQueueCnt = 0;
+    txCnt       = 0;
+    dropCnt     = 0;
+    delayCnt    = 0;
+    totalDelay  = 0;
+    maxDelay    = 0;
+}
+
+void scu::FramePacer::registerMetrics(const std::string& name)
+{
+    MetricsRegistry& registry { MetricsRegistry::getInstance() };
+
+    registry.remove(this);
+
+    registry.addGauge(this, "smurf_frame_pacer_queue_frames", "Number of frames in the queue",
+        { { "block", name } }, [this]() -> double { return getQueueCnt(); });
+
+    registry.addGauge(this, "smurf_frame_pacer_max_queue_frames", "Maximum number of frames in the queue",
+        { { "block", name } }, [this]() -> double { return getMaxQueueCnt(); });
+
+    registry.addCounter(this, "smurf_frame_pacer_tx_frames_total", "Number of released frames",
+        { { "block", name } }, [this]() -> double { return getTxCnt(); });
+
+    registry.addCounter(this, "smurf_frame_pacer_dropped_frames_total", "Number of frames dropped because the queue was full",
+        { { "block", name } }, [this]() -> double { return getDropCnt(); });
+
+    registry.addCounter(this, "smurf_frame_pacer_delayed_frames_total", "Number of delayed frames",
+        { { "block", name } }, [this]() -> double { return getDelayCnt(); });
+
+    registry.addGauge(this, "smurf_frame_pacer_max_delay_seconds", "Maximum time a frame was held in the queue",
+        { { "block", name } }, [this]() -> double { return getMaxDelay() * 1e-9; });
+}
+
+void scu::FramePacer::resizeQueue(std::size_t d)
+{
+    // Create the new ring buffers, and move the frames which fit in them, starting
+    // from the oldest one. The frames which don't fit are dropped.
+    std::vector<ris::FramePtr> newQueue(d);
+    std::vector<uint64_t>      newArrival(d, 0);
+    std::vector<bool>          newDelayed(d, false);
+    std::size_t                newCount { 0 };
+
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        std::size_t index { ( head + i ) % queue.size() };
+
+        if ( newCount < d )
+        {
+            newQueue[newCount]   = queue[index];
+            newArrival[newCount] = arrival[index];
+            newDelayed[newCount] = delayed[index];
+            ++newCount;
+        }
+        else
+        {
+            ++dropCnt;
+        }
+    }
+
+    queue.swap(newQueue);
+    arrival.swap(newArrival);
+    delayed.swap(newDelayed);
+    head     = 0;
+    count    = newCount;
+    depth    = d;
+    queueCnt = count;
+}
+
+void scu::FramePacer::acceptFrame(ris::FramePtr frame)
+{
+    rogue::GilRelease noGil;
+
+    // If the processing block is disabled, send the frame directly to the next slave
+    if (disable)
+    {
+        sendFrame(frame);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+
+        // Drop the frame if the queue is full
+        if ( count == queue.size() )
+        {
+            ++dropCnt;
+            return;
+        }
+
+        // Add the frame at the end of the queue. The frame will be delayed if
+        // there are other frames in front of it.
+        std::size_t tail { ( head + count ) % queue.size() };
+        queue[tail]   = frame;
+        arrival[tail] = helpers::getTimeNS();
+        delayed[tail] = ( count != 0 );
+        queueCnt      = ++count;
+
+        if ( count > maxQueueCnt )
+            maxQueueCnt = count;
+    }
+
+    // Notify the thread that a new frame is ready
+    queueCV.notify_all();
+}
+
+void scu::FramePacer::runThread()
+{
+    eLog_->logThreadId();
+
+    while(runTx)
+    {
+        ris::FramePtr frame;
+
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+
+            // Wait until there are frames in the queue, with a 100ms timeout
+            if ( 0 == count )
+            {
+                queueCV.wait_for( lock, std::chrono::milliseconds(100) );
+                continue;
+            }
+
+            // Refill the token bucket
+            uint64_t now { helpers::getTimeNS() };
+
+            if ( rate > 0 )
+            {
+                tokens += ( now - lastRefill ) * rate * 1e-9;
+                if ( tokens > burst )
+                    tokens = burst;
+            }
+            else
+            {
+                // Without rate limit the bucket is always full
+                tokens = burst;
+            }
+
+            lastRefill = now;
+
+            // If there are no tokens available, wait until the next token is
+            // ready (or until the parameters change), and mark the frame as delayed.
+            if ( tokens < 1 )
+            {
+                delayed[head] = true;
+                queueCV.wait_for( lock, std::chrono::nanoseconds( static_cast<uint64_t>( ( 1 - tokens ) / rate * 1e9 ) + 1 ) );
+                continue;
+            }
+
+            // Take the oldest frame from the queue
+            tokens -= 1;
+            frame = queue[head];
+            queue[head].reset();
+
+            uint64_t delay { now - arrival[head] };
+            totalDelay += delay;
+            if ( delay > maxDelay )
+                maxDelay = delay;
+
+            if ( delayed[head] )
+                ++delayCnt;
+
+            head = ( head + 1 ) % queue.size();
+            queueCnt = --count;
+        }
+
+        // Send the frame to the next slave, outside of the lock
+        sendFrame(frame);
+        ++txCnt;
+    }
+}
@@ -0,0 +1,327 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Metrics Server
+ * ----------------------------------------------------------------------------
+ * File          : MetricsServer.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Metrics Server Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <boost/python.hpp>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "smurf/core/utilities/MetricsServer.h"
+
+namespace scu = smurf::core::utilities;
+
+scu::MetricsServer::MetricsServer()
+:
+    enable(false),
+    port(9110),
+    sockFd(-1),
+    scrapeCnt(0),
+    errorCnt(0),
+    runServer(false),
+    eLog_(rogue::Logging::create("pysmurf.MetricsServer"))
+{
+}
+
+scu::MetricsServer::~MetricsServer()
+{
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(ctrlMutex);
+    stop();
+}
+
+scu::MetricsServerPtr scu::MetricsServer::create()
+{
+    return std::make_shared<MetricsServer>();
+}
+
+// Setup Class in python
+void scu::MetricsServer::setup_python()
+{
+    bp::class_< scu::MetricsServer,
+                scu::MetricsServerPtr,
+                boost::noncopyable >
+                ("MetricsServer", bp::init<>())
+        .def("setEnable",    &MetricsServer::setEnable)
+        .def("getEnable",    &MetricsServer::getEnable)
+        .def("setPort",      &MetricsServer::setPort)
+        .def("getPort",      &MetricsServer::getPort)
+        .def("getScrapeCnt", &MetricsServer::getScrapeCnt)
+        .def("getErrorCnt",  &MetricsServer::getErrorCnt)
+        .def("getMetricCnt", &MetricsServer::getMetricCnt)
+        .def("getMetrics",   &MetricsServer::getMetrics)
+        .def("clearCnt",     &MetricsServer::clearCnt)
+    ;
+}
+
+void scu::MetricsServer::setEnable(bool e)
+{
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(ctrlMutex);
+
+    if ( e == enable )
+        return;
+
+    if ( e )
+        enable = start();
+    else
+    {
+        stop();
+        enable = false;
+    }
+}
+
+const bool scu::MetricsServer::getEnable() const
+{
+    return enable;
+}
+
+void scu::MetricsServer::setPort(int p)
+{
+    if ( ( p <= 0 ) || ( p > 65535 ) )
+    {
+        eLog_->error("Trying to set an invalid port = %i", p);
+        return;
+    }
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(ctrlMutex);
+
+    if ( p == port )
+        return;
+
+    port = p;
+
+    // Restart the server on the new port
+    if ( enable )
+    {
+        stop();
+        enable = start();
+    }
+}
+
+const int scu::MetricsServer::getPort() const
+{
+    return port;
+}
+
+const std::size_t scu::MetricsServer::getScrapeCnt() const
+{
+    return scrapeCnt;
+}
+
+const std::size_t scu::MetricsServer::getErrorCnt() const
+{
+    return errorCnt;
+}
+
+const std::size_t scu::MetricsServer::getMetricCnt() const
+{
+    return MetricsRegistry::getInstance().getSize();
+}
+
+const std::string scu::MetricsServer::getMetrics() const
+{
+    return MetricsRegistry::getInstance().render();
+}
+
+void scu::MetricsServer::clearCnt()
+{
+    scrapeCnt = 0;
+    errorCnt  = 0;
+}
+
+bool scu::MetricsServer::start()
+{
+    sockFd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if ( sockFd < 0 )
+    {
+        eLog_->error("Failed to create the server socket: %s", std::strerror(errno));
+        return false;
+    }
+
+    // Allow restarting the server on the same port right away
+    int one { 1 };
+    ::setsockopt(sockFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    // Only listen on the local interface
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if ( ( ::bind(sockFd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ) || ( ::listen(sockFd, 8) < 0 ) )
+    {
+        eLog_->error("Failed to listen on port %i: %s", port.load(), std::strerror(errno));
+        ::close(sockFd);
+        sockFd = -1;
+        return false;
+    }
+
+    // Start the thread once the socket is ready
+    runServer = true;
+    thread = std::thread( &MetricsServer::runThread, this );
+
+    if( pthread_setname_np( thread.native_handle(), "MetricsServer" ) )
+        perror( "pthread_setname_np failed for MetricsServer thread" );
+
+    eLog_->info("Serving metrics on http://127.0.0.1:%i/metrics", port.load());
+
+    return true;
+}
+
+void scu::MetricsServer::stop()
+{
+    if ( ! thread.joinable() )
+        return;
+
+    runServer = false;
+    thread.join();
+
+    ::close(sockFd);
+    sockFd = -1;
+}
+
+void scu::MetricsServer::runThread()
+{
+    eLog_->logThreadId();
+
+    struct pollfd pfd;
+    pfd.fd     = sockFd;
+    pfd.events = POLLIN;
+
+    while(runServer)
+    {
+        // Wait for new connections, with a timeout, so that the stop flag is checked regularly
+        int rc { ::poll(&pfd, 1, acceptTimeout) };
+
+        if ( rc <= 0 )
+            continue;
+
+        int fd { ::accept4(sockFd, nullptr, nullptr, SOCK_CLOEXEC) };
+
+        if ( fd < 0 )
+        {
+            ++errorCnt;
+            continue;
+        }
+
+        // Don't let a client which stops reading block the thread
+        struct timeval tv;
+        tv.tv_sec  = sendTimeout / 1000;
+        tv.tv_usec = ( sendTimeout % 1000 ) * 1000;
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+        serve(fd);
+        ::close(fd);
+    }
+}
+
+void scu::MetricsServer::serve(int fd)
+{
+    // Read the request, until the end of the headers
+    std::string request;
+    char        buf[1024];
+
+    struct pollfd pfd;
+    pfd.fd     = fd;
+    pfd.events = POLLIN;
+
+    while ( std::string::npos == request.find("\r\n\r\n") )
+    {
+        if ( ( request.size() > maxRequestSize ) || ( ::poll(&pfd, 1, requestTimeout) <= 0 ) )
+        {
+            ++errorCnt;
+            return;
+        }
+
+        ssize_t n { ::recv(fd, buf, sizeof(buf), 0) };
+
+        if ( n <= 0 )
+        {
+            ++errorCnt;
+            return;
+        }
+
+        request.append(buf, n);
+    }
+
+    // Parse the request line: "<method> <target> <version>"
+    std::string line   { request.substr(0, request.find("\r\n")) };
+    std::size_t sp1    { line.find(' ') };
+    std::size_t sp2    { line.find(' ', sp1 + 1) };
+    std::string method { line.substr(0, sp1) };
+    std::string target { ( std::string::npos == sp1 ) ? "" : line.substr(sp1 + 1, sp2 - sp1 - 1) };
+
+    // Ignore the query string
+    target = target.substr(0, target.find('?'));
+
+    if ( method != "GET" )
+    {
+        ++errorCnt;
+        sendResponse(fd, "405 Method Not Allowed", "Method not allowed\n");
+        return;
+    }
+
+    if ( target != "/metrics" )
+    {
+        ++errorCnt;
+        sendResponse(fd, "404 Not Found", "Not found\n");
+        return;
+    }
+
+    if ( sendResponse(fd, "200 OK", MetricsRegistry::getInstance().render()) )
+        ++scrapeCnt;
+    else
+        ++errorCnt;
+}
+
+bool scu::MetricsServer::sendResponse(int fd, const std::string& status, const std::string& body)
+{
+    std::string response { "HTTP/1.1 " + status + "\r\n"
+        + "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+        + "Content-Length: " + std::to_string(body.size()) + "\r\n"
+        + "Connection: close\r\n"
+        + "\r\n"
+        + body };
+
+    std::size_t sent { 0 };
+
+    while ( sent < response.size() )
+    {
+        ssize_t n { ::send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL) };
+
+        if ( n < 0 )
+        {
+            if ( EINTR == errno )
+                continue;
+
+            return false;
+        }
+
+        sent += n;
+    }
+
+    return true;
+}
@@ -0,0 +1,83 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Tracer
+ * ----------------------------------------------------------------------------
+ * File          : Tracer.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    SMuRF Tracer Class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <boost/python.hpp>
+#include "smurf/core/utilities/Tracer.h"
+
+namespace scu = smurf::core::utilities;
+
+scu::TracerPtr scu::Tracer::create()
+{
+    return std::make_shared<Tracer>();
+}
+
+// Setup Class in python
+void scu::Tracer::setup_python()
+{
+    bp::class_< scu::Tracer,
+                scu::TracerPtr,
+                boost::noncopyable >
+                ("Tracer", bp::init<>())
+        .def("setEnable",   &Tracer::setEnable)
+        .def("getEnable",   &Tracer::getEnable)
+        .def("getEventCnt", &Tracer::getEventCnt)
+        .def("getCapacity", &Tracer::getCapacity)
+        .def("clear",       &Tracer::clear)
+        .def("dump",        &Tracer::dump)
+        .def("getJson",     &Tracer::getJson)
+    ;
+}
+
+void scu::Tracer::setEnable(bool e)
+{
+    TraceRecorder::getInstance().setEnable(e);
+}
+
+const bool scu::Tracer::getEnable() const
+{
+    return TraceRecorder::getInstance().getEnable();
+}
+
+const uint64_t scu::Tracer::getEventCnt() const
+{
+    return TraceRecorder::getInstance().getEventCnt();
+}
+
+const std::size_t scu::Tracer::getCapacity() const
+{
+    return TraceRecorder::numEvents;
+}
+
+void scu::Tracer::clear()
+{
+    TraceRecorder::getInstance().clear();
+}
+
+bool scu::Tracer::dump(const std::string& fileName) const
+{
+    rogue::GilRelease noGil;
+    return TraceRecorder::getInstance().dump(fileName);
+}
+
+const std::string scu::Tracer::getJson() const
+{
+    rogue::GilRelease noGil;
+    return TraceRecorder::getInstance().getJson();
+}
@@ -0,0 +1,44 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : Python Module For Utilities
+ * ----------------------------------------------------------------------------
+ * File       : module.cpp
+ * Created    : 2026-10-18
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Python module setup
+ * ----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+**/
+
+#include <boost/python.hpp>
+#include "smurf/core/utilities/module.h"
+#include "smurf/core/utilities/FramePacer.h"
+#include "smurf/core/utilities/MetricsServer.h"
+#include "smurf/core/utilities/Tracer.h"
+
+namespace bp  = boost::python;
+namespace scu = smurf::core::utilities;
+
+void scu::setup_module()
+{
+    // map the IO namespace to a sub-module
+    bp::object module(bp::handle<>(bp::borrowed(PyImport_AddModule("smurf.core.utilities"))));
+
+    // make "from mypackage import class1" work
+    bp::scope().attr("utilities") = module;
+
+    // set the current scope to the new sub-module
+    bp::scope io_scope = module;
+
+    scu::FramePacer::setup_python();
+    scu::MetricsServer::setup_python();
+    scu::Tracer::setup_python();
+}
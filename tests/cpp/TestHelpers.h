@@ -0,0 +1,48 @@
+#ifndef _SMURF_TESTS_TESTHELPERS_H_
+#define _SMURF_TESTS_TESTHELPERS_H_
+
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SMuRF Unit Test Helpers
+ * ----------------------------------------------------------------------------
+ * File          : TestHelpers.h
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    Helpers shared by the C++ unit tests.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <cstdio>
+#include <cmath>
+
+// Number of failed checks
+static int testFailures = 0;
+
+// Check a condition. On failure, the condition is printed and
+// the test goes on, so that all the failures are reported.
+#define CHECK(cond)                                                             \
+    do                                                                          \
+    {                                                                           \
+        if ( ! ( cond ) )                                                       \
+        {                                                                       \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++testFailures;                                                     \
+        }                                                                       \
+    } while (0)
+
+// Check that two values are equal within a tolerance
+#define CHECK_NEAR(a, b, tol) CHECK( std::fabs( (a) - (b) ) <= (tol) )
+
+// Result of the test executable
+#define TEST_RESULT() ( testFailures ? 1 : 0 )
+
+#endif
@@ -0,0 +1,333 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : FrameStatistics Unit Test
+ * ----------------------------------------------------------------------------
+ * File          : test_FrameStatistics.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    Check the frame number checks (including the resync after a counter
+ *    reset or wrap, and the per-source checks of merged streams), the
+ *    reorder window and the timing checks of the FrameStatistics class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <vector>
+#include "smurf/core/counters/FrameStatistics.h"
+#include "smurf/core/common/SmurfHeader.h"
+#include "TestHelpers.h"
+
+namespace scc = smurf::core::counters;
+
+// Slave which records the frame numbers of the frames it receives
+class FrameSink : public ris::Slave
+{
+public:
+    void acceptFrame(ris::FramePtr frame)
+    {
+        ris::FrameLockPtr lock { frame->lock() };
+        numbers.push_back(SmurfHeaderRO<ris::FrameIterator>::create(frame)->getFrameCounter());
+    }
+
+    std::vector<uint32_t> numbers;
+};
+typedef std::shared_ptr<FrameSink> FrameSinkPtr;
+
+// Block under test, with a sink attached to it
+struct Fixture
+{
+    Fixture()
+    :
+        stats(scc::FrameStatistics::create()),
+        sink(std::make_shared<FrameSink>())
+    {
+        stats->addSlave(sink);
+    }
+
+    // Send a frame with no channels
+    void send(uint32_t number, uint64_t counter2, uint32_t counter0, uint8_t crate = 0, uint8_t slot = 0)
+    {
+        std::size_t   size  { SmurfHeader<ris::FrameIterator>::SmurfHeaderSize };
+        ris::FramePtr frame { stats->reqFrame(size, true) };
+        frame->setPayload(size);
+
+        SmurfHeaderPtr<ris::FrameIterator> header { SmurfHeader<ris::FrameIterator>::create(frame) };
+        header->setCrateID(crate);
+        header->setSlotNumber(slot);
+        header->setNumberChannels(0);
+        header->setFrameCounter(number);
+        header->setCounter2(counter2);
+        header->setCounter0(counter0);
+
+        stats->acceptFrame(frame);
+    }
+
+    // Send a frame with timing counters which follow the frame number
+    void send(uint32_t number)
+    {
+        send(number, 1000 * static_cast<uint64_t>(number), number);
+    }
+
+    void send(const std::vector<uint32_t>& numbers)
+    {
+        for (auto const &n : numbers)
+            send(n);
+    }
+
+    scc::FrameStatisticsPtr stats;
+    FrameSinkPtr            sink;
+};
+
+// Without the reorder window, out-of-order frames are dropped
+static void testNoWindow()
+{
+    Fixture f;
+
+    f.send({ 0, 1, 3, 2, 4, 7 });
+
+    CHECK( f.sink->numbers == std::vector<uint32_t>({ 0, 1, 3, 4, 7 }) );
+    CHECK( 6 == f.stats->getFrameCnt() );
+    CHECK( 1 == f.stats->getFrameOutOrderCnt() );
+    CHECK( 3 == f.stats->getFrameLossCnt() );
+}
+
+// Swapped frames are held and released in order
+static void testReorder()
+{
+    Fixture f;
+    f.stats->setReorderDepth(4);
+    f.stats->setReorderTimeout(1000000);
+
+    f.send({ 0, 1, 3, 2, 4, 6, 7, 5 });
+
+    CHECK( f.sink->numbers == std::vector<uint32_t>({ 0, 1, 2, 3, 4, 5, 6, 7 }) );
+    CHECK( 3 == f.stats->getReorderCnt() );
+    CHECK( 0 == f.stats->getReorderLateCnt() );
+    CHECK( 0 == f.stats->getFrameOutOrderCnt() );
+    CHECK( 0 == f.stats->getFrameLossCnt() );
+}
+
+// When the window is full, the missing frame is skipped, and
+// counted as lost. If it arrives later, it is dropped.
+static void testOverflowAndLate()
+{
+    Fixture f;
+    f.stats->setReorderDepth(4);
+    f.stats->setReorderTimeout(1000000);
+
+    f.send({ 0, 2, 3, 4, 5 });
+
+    CHECK( f.sink->numbers == std::vector<uint32_t>({ 0, 2, 3, 4, 5 }) );
+    CHECK( 1 == f.stats->getReorderOverflowCnt() );
+    CHECK( 1 == f.stats->getFrameLossCnt() );
+
+    f.send(1);
+
+    CHECK( 5 == f.sink->numbers.size() );
+    CHECK( 1 == f.stats->getReorderLateCnt() );
+    CHECK( 1 == f.stats->getFrameOutOrderCnt() );
+
+    // The window goes on after the late frame
+    f.send({ 7, 6 });
+    CHECK( f.sink->numbers == std::vector<uint32_t>({ 0, 2, 3, 4, 5, 6, 7 }) );
+}
+
+// Disabling the window releases the held frames
+static void testResize()
+{
+    Fixture f;
+    f.stats->setReorderDepth(8);
+    f.stats->setReorderTimeout(1000000);
+
+    f.send({ 0, 2, 3 });
+    CHECK( f.sink->numbers == std::vector<uint32_t>({ 0 }) );
+
+    f.stats->setReorderDepth(0);
+    f.send(4);
+
+    CHECK( f.sink->numbers == std::vector<uint32_t>({ 0, 2, 3, 4 }) );
+    CHECK( 1 == f.stats->getFrameLossCnt() );
+}
+
+// Re-enabling the window after a frame counter reset, which happened
+// while it was disabled, starts it from the new frame numbers
+static void testResizeAfterReset()
+{
+    Fixture f;
+    f.stats->setReorderDepth(4);
+    f.stats->setReorderTimeout(1000000);
+
+    f.send({ 5000, 5001 });
+
+    f.stats->setReorderDepth(0);
+    f.send({ 5002, 0, 1 });
+
+    f.stats->setReorderDepth(4);
+    f.send({ 2, 4, 3 });
+
+    CHECK( f.sink->numbers == std::vector<uint32_t>({ 5000, 5001, 5002, 0, 1, 2, 3, 4 }) );
+    CHECK( 1 == f.stats->getResyncCnt() );
+    CHECK( 1 == f.stats->getReorderCnt() );
+    CHECK( 0 == f.stats->getReorderLateCnt() );
+    CHECK( 0 == f.stats->getFrameOutOrderCnt() );
+    CHECK( 0 == f.stats->getFrameLossCnt() );
+}
+
+// Send the frames numbered from 'first' to 'last', both included
+static void sendRange(Fixture& f, uint32_t first, uint32_t last)
+{
+    for (uint32_t n{first}; n != last; ++n)
+        f.send(n);
+    f.send(last);
+}
+
+// After a frame counter reset or a 32-bit wrap, the frames are not dropped
+static void testResync()
+{
+    for (std::size_t depth : { 0, 4 })
+    {
+        Fixture f;
+        f.stats->setReorderDepth(depth);
+        f.stats->setReorderTimeout(1000000);
+
+        // Counter reset (like a firmware restart)
+        sendRange(f, 5000, 5009);
+        sendRange(f, 0, 9);
+
+        CHECK( 20 == f.sink->numbers.size() );
+        CHECK( 1 == f.stats->getResyncCnt() );
+        CHECK( 0 == f.stats->getFrameOutOrderCnt() );
+        CHECK( 0 == f.stats->getFrameLossCnt() );
+        CHECK( 0 == f.stats->getCounter2BackwardsCnt() );
+
+        // Small jumps back are still out-of-order frames
+        f.send(2);
+        CHECK( 20 == f.sink->numbers.size() );
+        CHECK( 1 == f.stats->getResyncCnt() );
+        CHECK( 1 == f.stats->getFrameOutOrderCnt() );
+
+        // 32-bit wrap. The counter2 goes on.
+        Fixture w;
+        w.stats->setReorderDepth(depth);
+        w.stats->setReorderTimeout(1000000);
+
+        uint64_t counter2 { 0 };
+        for (uint32_t n : { 0xfffffffdU, 0xfffffffeU, 0xffffffffU, 0U, 1U, 2U })
+            w.send(n, counter2 += 1000, 0);
+
+        CHECK( w.sink->numbers == std::vector<uint32_t>({ 0xfffffffdU, 0xfffffffeU, 0xffffffffU, 0, 1, 2 }) );
+        CHECK( 1 == w.stats->getResyncCnt() );
+        CHECK( 0 == w.stats->getFrameOutOrderCnt() );
+        CHECK( 0 == w.stats->getFrameLossCnt() );
+        CHECK( 0 == w.stats->getCounter2BackwardsCnt() );
+    }
+
+    // With the reorder window, the frames held from the old sequence are released first
+    Fixture f;
+    f.stats->setReorderDepth(4);
+    f.stats->setReorderTimeout(1000000);
+
+    f.send({ 5000, 5002, 5003, 0, 1 });
+
+    CHECK( f.sink->numbers == std::vector<uint32_t>({ 5000, 5002, 5003, 0, 1 }) );
+    CHECK( 1 == f.stats->getResyncCnt() );
+    CHECK( 1 == f.stats->getFrameLossCnt() );
+}
+
+// The learned counter2 increment is not taken from a glitch at the start
+static void testLearnedPeriod()
+{
+    Fixture f;
+    f.stats->setJitterTolerance(10);
+
+    // The second frame comes late
+    for (uint32_t i{0}; i < 100; ++i)
+        f.send(i, 1000 * i + ( ( 1 == i ) ? 500 : 0 ), i);
+
+    CHECK( 1000 == f.stats->getPeriod() );
+    CHECK( 0 == f.stats->getCounter2JitterCnt() );
+
+    // The increments are checked once learned
+    f.send(100, 100600, 100);
+    CHECK( 1 == f.stats->getCounter2JitterCnt() );
+}
+
+// With merged streams, the frames are checked against the previous frame from the same source
+static void testMergedSources()
+{
+    Fixture f;
+
+    // Frames from the source A (crate 1, slot 2), with timing counters which follow the frame number
+    auto sendA = [&f](uint32_t n) { f.send(n, 1000 * static_cast<uint64_t>(n), n, 1, 2); };
+
+    // Frames from the source B (crate 1, slot 3), with unrelated timing counters
+    auto sendB = [&f](uint32_t n) { f.send(n, 0, 0, 1, 3); };
+
+    sendA(100);
+    sendA(101);
+    sendB(5000);
+    sendA(102);
+    sendB(5001);
+    sendB(5003);
+    sendA(104);
+    sendA(103);
+    sendB(5002);
+    sendB(0);
+    sendA(105);
+    sendB(1);
+
+    CHECK( f.sink->numbers == std::vector<uint32_t>({ 100, 101, 5000, 102, 5001, 5003, 104, 0, 105, 1 }) );
+    CHECK( 2 == f.stats->getSourceCnt() );
+    CHECK( 12 == f.stats->getFrameCnt() );
+    CHECK( 2 == f.stats->getFrameLossCnt() );
+    CHECK( 2 == f.stats->getFrameOutOrderCnt() );
+    CHECK( 1 == f.stats->getResyncCnt() );
+    CHECK( 0 == f.stats->getCounter2BackwardsCnt() );
+
+    CHECK( 6 == f.stats->getSourceFrameCnt(0) );
+    CHECK( 1 == f.stats->getSourceFrameLossCnt(0) );
+    CHECK( 1 == f.stats->getSourceFrameOutOrderCnt(0) );
+    CHECK( 0 == f.stats->getSourceResyncCnt(0) );
+
+    CHECK( 6 == f.stats->getSourceFrameCnt(1) );
+    CHECK( 1 == f.stats->getSourceFrameLossCnt(1) );
+    CHECK( 1 == f.stats->getSourceFrameOutOrderCnt(1) );
+    CHECK( 1 == f.stats->getSourceResyncCnt(1) );
+
+    // The frames held in the reorder window are released when the second source is seen
+    Fixture r;
+    r.stats->setReorderDepth(4);
+    r.stats->setReorderTimeout(1000000);
+
+    r.send(100, 100000, 100, 1, 2);
+    r.send(102, 102000, 102, 1, 2);
+    r.send(5000, 0, 0, 1, 3);
+    r.send(101, 101000, 101, 1, 2);
+
+    CHECK( r.sink->numbers == std::vector<uint32_t>({ 100, 102, 5000 }) );
+    CHECK( 1 == r.stats->getFrameLossCnt() );
+    CHECK( 1 == r.stats->getFrameOutOrderCnt() );
+    CHECK( 0 == r.stats->getCounter2BackwardsCnt() );
+}
+
+int main()
+{
+    testNoWindow();
+    testReorder();
+    testOverflowAndLate();
+    testResize();
+    testResizeAfterReset();
+    testLearnedPeriod();
+    testResync();
+    testMergedSources();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,95 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : LogHistogram Unit Test
+ * ----------------------------------------------------------------------------
+ * File          : test_LogHistogram.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    Check the bucket bounds and the statistics of the LogHistogram class.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <limits>
+#include "smurf/core/common/LogHistogram.h"
+#include "TestHelpers.h"
+
+// The buckets cover the whole 64-bit range, without gaps or overlaps,
+// and each bucket bound maps back to the same bucket.
+static void testBucketBounds()
+{
+    CHECK( 0 == LogHistogram::getBucketLowerBound(0) );
+    CHECK( std::numeric_limits<uint64_t>::max() == LogHistogram::getBucketUpperBound(LogHistogram::numBuckets - 1) );
+    CHECK( LogHistogram::numBuckets - 1 == LogHistogram::getBucketIndex(std::numeric_limits<uint64_t>::max()) );
+
+    for (std::size_t i{0}; i < LogHistogram::numBuckets; ++i)
+    {
+        uint64_t lower { LogHistogram::getBucketLowerBound(i) };
+        uint64_t upper { LogHistogram::getBucketUpperBound(i) };
+
+        CHECK( lower <= upper );
+        CHECK( i == LogHistogram::getBucketIndex(lower) );
+        CHECK( i == LogHistogram::getBucketIndex(upper) );
+
+        if ( i )
+            CHECK( LogHistogram::getBucketUpperBound(i - 1) + 1 == lower );
+
+        // The relative width of the buckets is at most 1/2^subBucketBits
+        if ( lower >= ( 1ULL << LogHistogram::subBucketBits ) )
+            CHECK( ( upper - lower + 1 ) <= ( lower >> LogHistogram::subBucketBits ) );
+    }
+}
+
+// The statistics of a known distribution
+static void testStatistics()
+{
+    static LogHistogram h;
+
+    CHECK( 0 == h.getCount() );
+    CHECK( 0 == h.getMin() );
+    CHECK( 0 == h.getMax() );
+    CHECK( 0 == h.getPercentile(50) );
+
+    for (uint64_t v{1}; v <= 100000; ++v)
+        h.record(v);
+
+    CHECK( 100000 == h.getCount() );
+    CHECK( 1 == h.getMin() );
+    CHECK( 100000 == h.getMax() );
+    CHECK_NEAR( h.getMean(), 50000.5, 1e-6 );
+
+    // The percentiles are the upper bound of their bucket, so they are
+    // at most 1/2^subBucketBits above the exact value
+    const double tol { 1.0 / ( 1 << LogHistogram::subBucketBits ) };
+    for (double p : { 1.0, 10.0, 50.0, 90.0, 99.0 })
+    {
+        double exact { p * 1000 };
+        double value { static_cast<double>( h.getPercentile(p) ) };
+        CHECK( value >= exact );
+        CHECK( value <= exact * ( 1 + tol ) );
+    }
+
+    CHECK( 100000 == h.getPercentile(100) );
+    CHECK( 1 == h.getPercentile(0) );
+
+    h.clear();
+    CHECK( 0 == h.getCount() );
+    CHECK( 0 == h.getSum() );
+    CHECK( 0 == h.getMax() );
+}
+
+int main()
+{
+    testBucketBounds();
+    testStatistics();
+
+    return TEST_RESULT();
+}
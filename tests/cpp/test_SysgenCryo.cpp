@@ -0,0 +1,414 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : SysgenCryo Unit Test
+ * ----------------------------------------------------------------------------
+ * File          : test_SysgenCryo.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    Check the SysgenCryo engine: the conversion kernels, the snapshot and
+ *    the coalesced flush against a plain register space, and the eta scans
+ *    and the eta estimation against the SysgenCryoEmulator.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <vector>
+#include <rogue/interfaces/memory/Slave.h>
+#include <rogue/interfaces/memory/Transaction.h>
+#include <rogue/interfaces/memory/Constants.h>
+#include "smurf/core/engines/SysgenCryo.h"
+#include "smurf/core/emulators/SysgenCryoEmulator.h"
+#include "TestHelpers.h"
+
+namespace rim = rogue::interfaces::memory;
+namespace sce = smurf::core::engines;
+namespace sem = smurf::core::emulators;
+
+// Number of channels per band
+static const int numChannels = 512;
+
+// Register space of one band, with no resonator model: the registers just
+// hold the last value written to them. The transactions are counted.
+class RegisterSpace : public rim::Slave
+{
+public:
+    RegisterSpace() : rim::Slave(4, 4096), words(4 * numChannels, 0), tranCnt(0), writeBytes(0) {}
+
+    // Fill all the registers with random words
+    void randomize(uint32_t seed)
+    {
+        std::mt19937                            gen(seed);
+        std::uniform_int_distribution<uint32_t> word;
+
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto &w : words)
+            w = word(gen);
+    }
+
+    std::size_t getTransactionCnt() { std::lock_guard<std::mutex> lock(mtx); return tranCnt; }
+    std::size_t getWriteBytes()     { std::lock_guard<std::mutex> lock(mtx); return writeBytes; }
+    void        clearCnt()          { std::lock_guard<std::mutex> lock(mtx); tranCnt = 0; writeBytes = 0; }
+
+    void doTransaction(rim::TransactionPtr tran)
+    {
+        rim::TransactionLockPtr lock { tran->lock() };
+
+        uint64_t address { tran->address() };
+        uint32_t size    { tran->size() };
+        uint32_t type    { tran->type() };
+
+        if ( ( address % 4 ) || ( size % 4 ) || ( address + size > 4 * words.size() ) )
+        {
+            tran->error("Bad access: address = 0x%llx, size = %u", static_cast<unsigned long long>(address), size);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> l(mtx);
+
+            if ( ( rim::Write == type ) || ( rim::Post == type ) )
+            {
+                std::memcpy(&words[address / 4], tran->begin(), size);
+                writeBytes += size;
+            }
+            else
+            {
+                std::memcpy(tran->begin(), &words[address / 4], size);
+            }
+
+            ++tranCnt;
+        }
+
+        tran->done();
+    }
+
+private:
+    std::mutex            mtx;
+    std::vector<uint32_t> words;
+    std::size_t           tranCnt;
+    std::size_t           writeBytes;
+};
+typedef std::shared_ptr<RegisterSpace> RegisterSpacePtr;
+
+// Create an engine connected to band 0 of a register space or an emulator
+static sce::SysgenCryoPtr createEngine(rim::SlavePtr slave)
+{
+    sce::SysgenCryoPtr e { std::make_shared<sce::SysgenCryo>() };
+    e->setSlave(slave);
+    e->setBand(0);
+    e->setOffset(0);
+    return e;
+}
+
+// The conversion kernels give the same words and values as
+// the register bitfields used by the single channel methods
+static void testPackUnpack()
+{
+    std::mt19937                           gen(1);
+    std::uniform_int_distribution<uint32_t> word;
+    std::uniform_real_distribution<double>  mag(0.0, 31.0);
+    std::uniform_real_distribution<double>  phase(-180.0, 179.9);
+    std::uniform_real_distribution<double>  freq(-4.79, 4.79);
+    std::uniform_int_distribution<int>      amp(0, 15);
+    std::uniform_int_distribution<int>      bit(0, 1);
+
+    for (int i{0}; i < 10000; ++i)
+    {
+        uint32_t w { word(gen) };
+        double   m { mag(gen) };
+        double   p { phase(gen) };
+        double   f { freq(gen) };
+        int      a { amp(gen) };
+        int      b { bit(gen) };
+
+        // config0
+        sce::config0 c0;
+        c0.reg      = w;
+        c0.etaMag   = (int) round( m * 1024.0 );
+        c0.etaPhase = (int) round( p * 32768.0 / 180.0 );
+
+        uint32_t k0 { w };
+        sce::SysgenCryo::packEtaMag(&m, &k0, 1);
+        sce::SysgenCryo::packEtaPhase(&p, &k0, 1);
+        CHECK( c0.reg == k0 );
+
+        double um, up;
+        sce::SysgenCryo::unpackEtaMag(&k0, &um, 1);
+        sce::SysgenCryo::unpackEtaPhase(&k0, &up, 1);
+        CHECK( um == c0.etaMag / 1024.0 );
+        CHECK( up == c0.etaPhase * 180.0 / 32768.0 );
+
+        // config1
+        sce::config1 c1;
+        c1.reg             = w;
+        c1.centerFrequency = (int) round( f * 16777216.0 / 9.6 );
+        c1.amplitudeScale  = a;
+        c1.feedbackEnable  = b;
+
+        uint32_t k1 { w };
+        sce::SysgenCryo::packCenterFrequency(&f, &k1, 1);
+        sce::SysgenCryo::packAmplitudeScale(&a, &k1, 1);
+        sce::SysgenCryo::packFeedbackEnable(&b, &k1, 1);
+        CHECK( c1.reg == k1 );
+
+        double uf;
+        int    ua, ub;
+        sce::SysgenCryo::unpackCenterFrequency(&k1, &uf, 1);
+        sce::SysgenCryo::unpackAmplitudeScale(&k1, &ua, 1);
+        sce::SysgenCryo::unpackFeedbackEnable(&k1, &ub, 1);
+        CHECK_NEAR( uf, c1.centerFrequency * 9.6 / 16777216.0, 1e-12 );
+        CHECK( ua == (int) c1.amplitudeScale );
+        CHECK( ub == (int) c1.feedbackEnable );
+
+        // status0 and status1
+        sce::status0 s0;
+        sce::status1 s1;
+        s0.reg = w;
+        s1.reg = w;
+
+        double lfo, ferr;
+        sce::SysgenCryo::unpackLoopFilterOutput(&w, &lfo, 1);
+        sce::SysgenCryo::unpackFrequencyError(&w, &ferr, 1);
+        CHECK( lfo == (double) s0.loopFilterOutput );
+        CHECK_NEAR( ferr, s1.frequencyError * 9.6 / 8388608.0, 1e-12 );
+    }
+
+    // The values are clamped to the range of the fields
+    double   values[] = { -1.0, 100.0 };
+    uint32_t words[]  = { 0, 0 };
+    sce::SysgenCryo::packEtaMag(values, words, 2);
+    sce::SysgenCryo::unpackEtaMag(words, values, 2);
+    CHECK( 0 == values[0] );
+    CHECK( 32767.0 / 1024.0 == values[1] );
+    int amps[]  = { -3, 20 };
+    sce::SysgenCryo::packAmplitudeScale(amps, words, 2);
+    sce::SysgenCryo::unpackAmplitudeScale(words, amps, 2);
+    CHECK( 0 == amps[0] );
+    CHECK( 15 == amps[1] );
+}
+
+// The snapshot decodes the four banks like the per-register reads
+static void testSnapshot()
+{
+    RegisterSpacePtr regs { std::make_shared<RegisterSpace>() };
+    regs->randomize(2);
+
+    sce::SysgenCryoPtr e   { createEngine(regs) };
+    sce::SysgenCryoPtr ref { createEngine(regs) };
+
+    for (int ch{0}; ch < numChannels; ch += 7)
+    {
+        e->setCenterFrequencyMHz(ch, 0.01 * ( ch % 50 ), true);
+        e->setAmplitudeScale(ch, ch % 16, true);
+        e->setEtaPhaseDegree(ch, ch % 360 - 180, true);
+        e->setEtaMagScaled(ch, 0.5, true);
+        e->setFeedbackEnable(ch, ch % 2, true);
+    }
+
+    CHECK( e->snapshot() > 0 );
+    CHECK( e->getSnapshotTime() > 0 );
+
+    for (int ch{0}; ch < numChannels; ++ch)
+    {
+        CHECK( e->getCenterFrequencyMHz(ch, false) == ref->getCenterFrequencyMHz(ch, true) );
+        CHECK( e->getAmplitudeScale(ch, false)     == ref->getAmplitudeScale(ch, true) );
+        CHECK( e->getEtaPhaseDegree(ch, false)     == ref->getEtaPhaseDegree(ch, true) );
+        CHECK( e->getEtaMagScaled(ch, false)       == ref->getEtaMagScaled(ch, true) );
+        CHECK( e->getFeedbackEnable(ch, false)     == ref->getFeedbackEnable(ch, true) );
+        CHECK( e->getAmplitudeReadback(ch, false)  == ref->getAmplitudeReadback(ch, true) );
+        CHECK( e->getLoopFilterOutput(ch, false)   == ref->getLoopFilterOutput(ch, true) );
+        CHECK( e->getFrequencyErrorMHz(ch, false)  == ref->getFrequencyErrorMHz(ch, true) );
+    }
+
+    // A snapshot leaves the config shadows clean
+    CHECK( 0 == e->getDirtyCount() );
+}
+
+// The dirty words are written in coalesced ranges
+static void testFlush()
+{
+    RegisterSpacePtr regs { std::make_shared<RegisterSpace>() };
+
+    sce::SysgenCryoPtr e   { createEngine(regs) };
+    sce::SysgenCryoPtr ref { createEngine(regs) };
+
+    // With a valid shadow, short gaps of clean words are written too:
+    // channels 10 to 35 go in one write, channel 100 in another one,
+    // and channel 200 of the config1 bank in a third one.
+    e->readAll();
+    regs->clearCnt();
+
+    for (int ch{10}; ch <= 20; ++ch)
+        e->setEtaMagScaled(ch, 1.0 + ch / 64.0, false);
+    for (int ch{30}; ch <= 35; ++ch)
+        e->setEtaMagScaled(ch, 2.0, false);
+    e->setEtaMagScaled(100, 3.0, false);
+    e->setAmplitudeScale(200, 9, false);
+
+    CHECK( 19 == e->getDirtyCount() );
+    CHECK( 3 == e->flush() );
+    CHECK( 0 == e->getDirtyCount() );
+    CHECK( 3 == regs->getTransactionCnt() );
+    CHECK( ( 26 + 1 + 1 ) * 4 == regs->getWriteBytes() );
+
+    for (int ch{10}; ch <= 20; ++ch)
+        CHECK( 1.0 + ch / 64.0 == ref->getEtaMagScaled(ch, true) );
+    for (int ch{21}; ch < 30; ++ch)
+        CHECK( 0 == ref->getEtaMagScaled(ch, true) );
+    CHECK( 2.0 == ref->getEtaMagScaled(35, true) );
+    CHECK( 3.0 == ref->getEtaMagScaled(100, true) );
+    CHECK( 9 == ref->getAmplitudeScale(200, true) );
+
+    // Nothing to write
+    regs->clearCnt();
+    CHECK( 0 == e->flush() );
+    CHECK( 0 == regs->getTransactionCnt() );
+
+    // Without a valid shadow, the clean words don't match the
+    // registers, so only the dirty words are written
+    sce::SysgenCryoPtr n { createEngine(regs) };
+    regs->clearCnt();
+    n->setEtaMagScaled(10, 4.0, false);
+    n->setEtaMagScaled(12, 4.0, false);
+    CHECK( 2 == n->flush() );
+    CHECK( 8 == regs->getWriteBytes() );
+    CHECK( 1.0 + 11 / 64.0 == ref->getEtaMagScaled(11, true) );
+}
+
+// The serial and parallel eta scans give the same results
+static void testScanParity()
+{
+    sem::SysgenCryoEmulatorPtr emu { sem::SysgenCryoEmulator::create(1) };
+    emu->randomizeResonators(0.1, 3);
+    emu->setLatency(10);
+
+    sce::SysgenCryoPtr e { createEngine(emu) };
+    e->snapshot();
+
+    std::vector<int> channels;
+    for (int ch{0}; ch < 16; ch += 2)
+        channels.push_back(ch);
+
+    std::vector<double> frequencies;
+    for (int i{-10}; i <= 10; ++i)
+        frequencies.push_back(0.01 * i);
+
+    // A pending change of a channel which is not scanned
+    e->setEtaMagScaled(100, 3.0, false);
+
+    for (uint32_t dwell : { 10, 0 })
+    {
+        e->setScanDwell(dwell);
+
+        e->runEtaScan(channels, 12, frequencies);
+        std::vector<double> serialReal { e->getResultsReal() };
+        std::vector<double> serialImag { e->getResultsImag() };
+
+        e->runEtaScanParallel(channels, 12, frequencies);
+        std::vector<double> parallelReal { e->getResultsReal() };
+        std::vector<double> parallelImag { e->getResultsImag() };
+
+        CHECK( channels.size() * frequencies.size() == serialReal.size() );
+        CHECK( serialReal == parallelReal );
+        CHECK( serialImag == parallelImag );
+    }
+
+    // The scans restore the channels
+    for (auto const &ch : channels)
+    {
+        CHECK( 0 == e->getCenterFrequencyMHz(ch, true) );
+        CHECK( 0 == e->getAmplitudeScale(ch, true) );
+    }
+
+    // The scans don't write the pending change of the other channel
+    sce::SysgenCryoPtr ref { createEngine(emu) };
+    CHECK( 0 == ref->getEtaMagScaled(100, true) );
+    e->flush();
+    CHECK( 3.0 == ref->getEtaMagScaled(100, true) );
+}
+
+// The eta estimation recovers known resonators
+static void testEstimateEta()
+{
+    const double offsets[] = { -0.12, -0.05, 0.0, 0.03, 0.071, 0.1, 0.15, -0.17 };
+    const int    n         = 8;
+
+    sem::SysgenCryoEmulatorPtr emu { sem::SysgenCryoEmulator::create(1) };
+    for (int ch{0}; ch < n; ++ch)
+        emu->setResonator(0, ch, offsets[ch], 0.1, 0.9);
+
+    sce::SysgenCryoPtr e { createEngine(emu) };
+    e->snapshot();
+
+    std::vector<int> channels;
+    for (int ch{0}; ch < n; ++ch)
+        channels.push_back(ch);
+
+    std::vector<double> frequencies;
+    for (int i{-40}; i <= 40; ++i)
+        frequencies.push_back(0.005 * i);
+
+    e->runEtaScanParallel(channels, 12, frequencies);
+
+    // The estimates of the 8 contiguous channels are written in one transaction,
+    // without the pending change of a channel which is not estimated
+    e->setEtaMagScaled(20, 3.0, false);
+    emu->clearCnt();
+    e->estimateEta(0.01, true, true);
+    CHECK( 1 == emu->getTransactionCnt() );
+    CHECK( n * 4 == emu->getWriteBytes() );
+    CHECK( 1 == e->getDirtyCount() );
+
+    std::vector<double> phase  { e->getEtaPhaseEstimate() };
+    std::vector<double> mag    { e->getEtaMagEstimate() };
+    std::vector<double> center { e->getEtaCenterEstimate() };
+
+    CHECK( n == phase.size() );
+    CHECK( n == mag.size() );
+    CHECK( n == center.size() );
+
+    for (int ch{0}; ch < n; ++ch)
+    {
+        // The center is found within half a scan step
+        CHECK_NEAR( center[ch], offsets[ch], 0.0025 );
+        CHECK_NEAR( phase[ch], -90.0, 10.0 );
+        CHECK( mag[ch] > 0 );
+
+        // The estimates were applied
+        CHECK_NEAR( e->getEtaPhaseDegree(ch, true), phase[ch], 180.0 / 32768 );
+        CHECK_NEAR( e->getEtaMagScaled(ch, true), mag[ch], 1.0 / 1024 );
+
+        // With the estimated eta, the frequency error follows the
+        // frequency offset around the resonance, with a unit slope
+        e->setAmplitudeScale(ch, 12, true);
+        e->setCenterFrequencyMHz(ch, center[ch] - 0.002, true);
+        double e0 { e->getFrequencyErrorMHz(ch, true) };
+        e->setCenterFrequencyMHz(ch, center[ch] + 0.002, true);
+        double e1 { e->getFrequencyErrorMHz(ch, true) };
+        e->setCenterFrequencyMHz(ch, 0, true);
+        e->setAmplitudeScale(ch, 0, true);
+
+        CHECK_NEAR( ( e1 - e0 ) / 0.004, 1.0, 0.15 );
+    }
+}
+
+int main()
+{
+    testPackUnpack();
+    testSnapshot();
+    testFlush();
+    testScanParity();
+    testEstimateEta();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,119 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : TripleBuffer Unit Test
+ * ----------------------------------------------------------------------------
+ * File          : test_TripleBuffer.cpp
+ * Created       : 2026-10-18
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    Check the TripleBuffer class, from one thread and from a writer and a
+ *    reader threads.
+ *-----------------------------------------------------------------------------
+ * This file is part of the smurf software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+    * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the smurf software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+**/
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include "smurf/core/common/TripleBuffer.h"
+#include "TestHelpers.h"
+
+// Publishing and updating, from one thread
+static void testSequence()
+{
+    TripleBuffer<int> b(7);
+
+    // Nothing published yet: the reader sees the initial value
+    CHECK( ! b.update() );
+    CHECK( 7 == b.getFront() );
+
+    b.getBack() = 1;
+    b.publish();
+    CHECK( b.update() );
+    CHECK( 1 == b.getFront() );
+
+    // The same snapshot is not taken twice
+    CHECK( ! b.update() );
+    CHECK( 1 == b.getFront() );
+
+    // Only the latest of several snapshots is seen
+    for (int i{2}; i <= 5; ++i)
+    {
+        b.getBack() = i;
+        b.publish();
+    }
+    CHECK( b.update() );
+    CHECK( 5 == b.getFront() );
+    CHECK( ! b.update() );
+}
+
+// A snapshot whose words must all be equal
+struct Snapshot
+{
+    std::array<uint64_t, 16> words;
+};
+
+// The reader never sees a torn snapshot, and the
+// snapshots it sees are never older than the previous one
+static void testThreads()
+{
+    const uint64_t    numSnapshots { 200000 };
+    TripleBuffer<Snapshot> b;
+    std::atomic<bool> done(false);
+
+    std::thread writer([&b, &done, numSnapshots]()
+    {
+        for (uint64_t i{1}; i <= numSnapshots; ++i)
+        {
+            b.getBack().words.fill(i);
+            b.publish();
+        }
+        done = true;
+    });
+
+    uint64_t    last  { 0 };
+    std::size_t torn  { 0 };
+    std::size_t older { 0 };
+    bool        finished { false };
+
+    while ( ! finished )
+    {
+        // Check the done flag before the last update, so
+        // that the last snapshot is always taken
+        finished = done;
+
+        if ( ! b.update() )
+            continue;
+
+        const Snapshot &s { b.getFront() };
+        for (auto const &w : s.words)
+            if ( w != s.words[0] )
+                ++torn;
+
+        if ( s.words[0] < last )
+            ++older;
+
+        last = s.words[0];
+    }
+
+    writer.join();
+
+    CHECK( 0 == torn );
+    CHECK( 0 == older );
+    CHECK( numSnapshots == last );
+}
+
+int main()
+{
+    testSequence();
+    testThreads();
+
+    return TEST_RESULT();
+}